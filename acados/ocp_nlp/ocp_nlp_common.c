@@ -1212,6 +1212,8 @@ void ocp_nlp_opts_initialize_default(void *config_, void *dims_, void *opts_)
     opts->levenberg_marquardt = 0.0;
     opts->log_primal_step_norm = 0;
     opts->log_dual_step_norm = 0;
+    opts->log_latency = 0;
+    opts->latency_deadline = 0.0;
     opts->max_iter = 1;
     opts->nlp_qp_tol_strategy = FIXED_QP_TOL;
     opts->nlp_qp_tol_reduction_factor = 1e-1;
@@ -1220,6 +1222,7 @@ void ocp_nlp_opts_initialize_default(void *config_, void *dims_, void *opts_)
     opts->nlp_qp_tol_min_eq = 1e-10;
     opts->nlp_qp_tol_min_ineq = 1e-10;
     opts->nlp_qp_tol_min_comp = 1e-11;
+    opts->nlp_qp_tol_safeguard = false;
 
     /* submodules opts */
     // qp solver
@@ -1269,6 +1272,9 @@ void ocp_nlp_opts_initialize_default(void *config_, void *dims_, void *opts_)
     opts->ext_qp_res = 0;
     opts->qp_warm_start = 0;
     opts->store_iterates = false;
+    opts->profiler_buffer_size = 0;
+    opts->alloc_hugepages = false;
+    opts->minimal_memory = false;
 
     opts->warm_start_first_qp = false;
     opts->warm_start_first_qp_from_nlp = false;
@@ -1276,6 +1282,7 @@ void ocp_nlp_opts_initialize_default(void *config_, void *dims_, void *opts_)
 
     opts->with_anderson_acceleration = false;
     opts->anderson_activation_threshold = 1e1;
+    opts->anderson_depth = 1;
 
     // tolerances
     opts->tol_stat = 1e-8;
@@ -1427,6 +1434,11 @@ void ocp_nlp_opts_set(void *config_, void *opts_, const char *field, void* value
             double* nlp_qp_tol_min_comp = (double *) value;
             opts->nlp_qp_tol_min_comp = *nlp_qp_tol_min_comp;
         }
+        else if (!strcmp(field, "nlp_qp_tol_safeguard"))
+        {
+            bool* nlp_qp_tol_safeguard = (bool *) value;
+            opts->nlp_qp_tol_safeguard = *nlp_qp_tol_safeguard;
+        }
         else if (!strcmp(field, "store_iterates"))
         {
             bool* store_iterates = (bool *) value;
@@ -1440,6 +1452,21 @@ void ocp_nlp_opts_set(void *config_, void *opts_, const char *field, void* value
                 opts->store_iterates = *store_iterates;
             }
         }
+        else if (!strcmp(field, "alloc_hugepages"))
+        {
+            bool* alloc_hugepages = (bool *) value;
+            opts->alloc_hugepages = *alloc_hugepages;
+        }
+        else if (!strcmp(field, "minimal_memory"))
+        {
+            bool* minimal_memory = (bool *) value;
+            opts->minimal_memory = *minimal_memory;
+        }
+        else if (!strcmp(field, "profiler_buffer_size"))
+        {
+            int* profiler_buffer_size = (int *) value;
+            opts->profiler_buffer_size = *profiler_buffer_size;
+        }
         else if (!strcmp(field, "levenberg_marquardt"))
         {
             double* levenberg_marquardt = (double *) value;
@@ -1551,6 +1578,16 @@ void ocp_nlp_opts_set(void *config_, void *opts_, const char *field, void* value
             int* log_dual_step_norm = (int *) value;
             opts->log_dual_step_norm = *log_dual_step_norm;
         }
+        else if (!strcmp(field, "log_latency"))
+        {
+            int* log_latency = (int *) value;
+            opts->log_latency = *log_latency;
+        }
+        else if (!strcmp(field, "latency_deadline"))
+        {
+            double* latency_deadline = (double *) value;
+            opts->latency_deadline = *latency_deadline;
+        }
         else if (!strcmp(field, "max_iter") || !strcmp(field, "nlp_solver_max_iter"))
         {
             int* max_iter = (int *) value;
@@ -1626,6 +1663,16 @@ void ocp_nlp_opts_set(void *config_, void *opts_, const char *field, void* value
             double* anderson_activation_threshold = (double *) value;
             opts->anderson_activation_threshold = *anderson_activation_threshold;
         }
+        else if (!strcmp(field, "anderson_depth"))
+        {
+            int* anderson_depth = (int *) value;
+            if (*anderson_depth < 1)
+            {
+                printf("\nerror: ocp_nlp_opts_set: invalid value for anderson_depth field, need int >= 1, got %d.\n", *anderson_depth);
+                exit(1);
+            }
+            opts->anderson_depth = *anderson_depth;
+        }
         else if (!strcmp(field, "tol_stat"))
         {
             // NOTE: NLP solver tolerances should be set before QP tolerances!
@@ -1759,6 +1806,11 @@ acados_size_t ocp_nlp_memory_calculate_size(ocp_nlp_config *config, ocp_nlp_dims
     if (opts->with_anderson_acceleration)
     {
         size += 2*ocp_qp_out_calculate_size(dims->qp_solver->orig_dims); // prev_qp_out, anderson_step
+        int m = opts->anderson_depth;
+        size += 3*m*sizeof(ocp_qp_out *); // anderson_dx, anderson_dd, anderson_q
+        size += 3*m*ocp_qp_out_calculate_size(dims->qp_solver->orig_dims);
+        size += (m*m + 2*m + N+1) * sizeof(double); // qr_r, rhs, gamma, stage_dot
+        size += 8;
     }
 
     // qp_solver
@@ -1822,6 +1874,13 @@ acados_size_t ocp_nlp_memory_calculate_size(ocp_nlp_config *config, ocp_nlp_dims
         }
     }
 
+    if (opts->with_solution_sens_wrt_params_adj)
+    {
+        size += (N+1)*sizeof(struct blasfeo_dvec);  // adj_p_global_stage
+        size += (N+1)*blasfeo_memsize_dvec(np_global);
+        size += 8 + 64;  // align
+    }
+
     // nlp res
     size += ocp_nlp_res_calculate_size(dims);
 
@@ -1829,6 +1888,13 @@ acados_size_t ocp_nlp_memory_calculate_size(ocp_nlp_config *config, ocp_nlp_dims
     size += sizeof(struct ocp_nlp_timings);
 
     size += (N+1)*sizeof(bool); // set_sim_guess
+
+    // profiler
+    if (opts->profiler_buffer_size > 0)
+    {
+        size += acados_profiler_calculate_size(opts->profiler_buffer_size);
+        size += 8; // align
+    }
     // primal step norm
     if (opts->log_primal_step_norm)
     {
@@ -1839,6 +1905,11 @@ acados_size_t ocp_nlp_memory_calculate_size(ocp_nlp_config *config, ocp_nlp_dims
     {
         size += opts->max_iter*sizeof(double);
     }
+    // latency histograms
+    if (opts->log_latency)
+    {
+        size += LATENCY_NUM_FIELDS*sizeof(acados_latency_histogram);
+    }
 
     size += (N+1)*sizeof(struct blasfeo_dmat); // dzduxt
     size += 6*(N+1)*sizeof(struct blasfeo_dvec);  // cost_grad ineq_fun ineq_adj dyn_adj sim_guess z_alg
@@ -1866,6 +1937,9 @@ acados_size_t ocp_nlp_memory_calculate_size(ocp_nlp_config *config, ocp_nlp_dims
     size += 8;   // middle align
     size += 8;   // blasfeo_struct align
     size += 64;  // blasfeo_mem align
+    size += 8;   // cold blasfeo_struct align
+    size += 64;  // cold blasfeo_mem align
+    size += 8;   // cold align
 
     make_int_multiple_of(8, &size);
 
@@ -1939,6 +2013,30 @@ ocp_nlp_memory *ocp_nlp_memory_assign(ocp_nlp_config *config, ocp_nlp_dims *dims
         c_ptr += ocp_qp_out_calculate_size(dims->qp_solver->orig_dims);
         mem->anderson_step = ocp_qp_out_assign(dims->qp_solver->orig_dims, c_ptr);
         c_ptr += ocp_qp_out_calculate_size(dims->qp_solver->orig_dims);
+
+        int m = opts->anderson_depth;
+        mem->anderson_dx = (ocp_qp_out **) c_ptr;
+        c_ptr += m*sizeof(ocp_qp_out *);
+        mem->anderson_dd = (ocp_qp_out **) c_ptr;
+        c_ptr += m*sizeof(ocp_qp_out *);
+        mem->anderson_q = (ocp_qp_out **) c_ptr;
+        c_ptr += m*sizeof(ocp_qp_out *);
+        for (int j = 0; j < m; j++)
+        {
+            mem->anderson_dx[j] = ocp_qp_out_assign(dims->qp_solver->orig_dims, c_ptr);
+            c_ptr += ocp_qp_out_calculate_size(dims->qp_solver->orig_dims);
+            mem->anderson_dd[j] = ocp_qp_out_assign(dims->qp_solver->orig_dims, c_ptr);
+            c_ptr += ocp_qp_out_calculate_size(dims->qp_solver->orig_dims);
+            mem->anderson_q[j] = ocp_qp_out_assign(dims->qp_solver->orig_dims, c_ptr);
+            c_ptr += ocp_qp_out_calculate_size(dims->qp_solver->orig_dims);
+        }
+        align_char_to(8, &c_ptr);
+        assign_and_advance_double(m*m, &mem->anderson_qr_r, &c_ptr);
+        assign_and_advance_double(m, &mem->anderson_rhs, &c_ptr);
+        assign_and_advance_double(m, &mem->anderson_gamma, &c_ptr);
+        assign_and_advance_double(N+1, &mem->anderson_stage_dot, &c_ptr);
+        mem->anderson_len = 0;
+        mem->anderson_next = 0;
     }
 
     // QP solver
@@ -1960,39 +2058,24 @@ ocp_nlp_memory *ocp_nlp_memory_assign(ocp_nlp_config *config, ocp_nlp_dims *dims
     c_ptr += ocp_nlp_qpscaling_memory_calculate_size(dims->qpscaling, opts->qpscaling, dims->qp_solver->orig_dims);
 
     int i;
-    // dynamics
-    for (i = 0; i < N; i++)
-    {
-        mem->dynamics[i] = dynamics[i]->memory_assign(dynamics[i], dims->dynamics[i], opts->dynamics[i], c_ptr);
-        c_ptr += dynamics[i]->memory_calculate_size(dynamics[i], dims->dynamics[i], opts->dynamics[i]);
-    }
-
-    // cost
+    // dynamics, cost and constraints memory stage by stage, in the order they are touched when linearizing
     for (i = 0; i <= N; i++)
     {
+        if (i < N)
+        {
+            mem->dynamics[i] = dynamics[i]->memory_assign(dynamics[i], dims->dynamics[i], opts->dynamics[i], c_ptr);
+            c_ptr += dynamics[i]->memory_calculate_size(dynamics[i], dims->dynamics[i], opts->dynamics[i]);
+        }
+
         mem->cost[i] = cost[i]->memory_assign(cost[i], dims->cost[i], opts->cost[i], c_ptr);
         c_ptr += cost[i]->memory_calculate_size(cost[i], dims->cost[i], opts->cost[i]);
-    }
 
-    // constraints
-    for (i = 0; i <= N; i++)
-    {
         mem->constraints[i] = constraints[i]->memory_assign(constraints[i],
                                             dims->constraints[i], opts->constraints[i], c_ptr);
         c_ptr += constraints[i]->memory_calculate_size( constraints[i], dims->constraints[i],
                                                                  opts->constraints[i]);
     }
 
-    // intermediate iterates
-    if (opts->store_iterates)
-    {
-        for (i = 0; i <= opts->max_iter; i++)
-        {
-            mem->iterates[i] = ocp_nlp_out_assign(config, dims, c_ptr);
-            c_ptr += ocp_nlp_out_calculate_size(config, dims);
-        }
-    }
-
     // nlp res
     mem->nlp_res = ocp_nlp_res_assign(dims, c_ptr);
     c_ptr += mem->nlp_res->memsize;
@@ -2011,13 +2094,6 @@ ocp_nlp_memory *ocp_nlp_memory_assign(ocp_nlp_config *config, ocp_nlp_dims *dims
     // blasfeo_struct align
     align_char_to(8, &c_ptr);
 
-    if (opts->with_solution_sens_wrt_params_forw)
-    {
-        assign_and_advance_blasfeo_dmat_structs(N + 1, &mem->jac_lag_stat_p_global, &c_ptr);
-        assign_and_advance_blasfeo_dmat_structs(N + 1, &mem->jac_ineq_p_global, &c_ptr);
-        assign_and_advance_blasfeo_dmat_structs(N, &mem->jac_dyn_p_global, &c_ptr);
-    }
-
     // dzduxt
     assign_and_advance_blasfeo_dmat_structs(N + 1, &mem->dzduxt, &c_ptr);
 
@@ -2036,20 +2112,6 @@ ocp_nlp_memory *ocp_nlp_memory_assign(ocp_nlp_config *config, ocp_nlp_dims *dims
     // sim_guess
     assign_and_advance_blasfeo_dvec_structs(N + 1, &mem->sim_guess, &c_ptr);
 
-    // primal step norm
-    if (opts->log_primal_step_norm)
-    {
-        mem->primal_step_norm = (double *) c_ptr;
-        c_ptr += opts->max_iter*sizeof(double);
-    }
-
-    // dual step norm
-    if (opts->log_dual_step_norm)
-    {
-        mem->dual_step_norm = (double *) c_ptr;
-        c_ptr += opts->max_iter*sizeof(double);
-    }
-
     // set_sim_guess
     assign_and_advance_bool(N+1, &mem->set_sim_guess, &c_ptr);
     for (i = 0; i <= N; ++i)
@@ -2060,9 +2122,48 @@ ocp_nlp_memory *ocp_nlp_memory_assign(ocp_nlp_config *config, ocp_nlp_dims *dims
     // blasfeo_mem align
     align_char_to(64, &c_ptr);
 
-    // blasfeo_dmat
+    // dzduxt, first since blasfeo_dmat memory has to stay 64 byte aligned
+    for (i = 0; i <= N; i++)
+    {
+        assign_and_advance_blasfeo_dmat_mem(nu[i]+nx[i], nz[i], mem->dzduxt+i, &c_ptr);
+    }
+
+    // hot per-stage vectors, stage by stage in the order they are touched within an iteration
+    for (i = 0; i <= N; i++)
+    {
+        // sim_guess
+        assign_and_advance_blasfeo_dvec_mem(nx[i] + nz[i], mem->sim_guess + i, &c_ptr);
+        blasfeo_dvecse(nx[i] + nz[i], 0.0, mem->sim_guess+i, 0);
+        // z_alg
+        assign_and_advance_blasfeo_dvec_mem(nz[i], mem->z_alg + i, &c_ptr);
+        // dyn_fun
+        if (i < N)
+        {
+            assign_and_advance_blasfeo_dvec_mem(nx[i + 1], mem->dyn_fun + i, &c_ptr);
+        }
+        // dyn_adj
+        assign_and_advance_blasfeo_dvec_mem(nu[i] + nx[i], mem->dyn_adj + i, &c_ptr);
+        // cost_grad
+        assign_and_advance_blasfeo_dvec_mem(nv[i], mem->cost_grad + i, &c_ptr);
+        // ineq_fun
+        assign_and_advance_blasfeo_dvec_mem(2 * ni[i], mem->ineq_fun + i, &c_ptr);
+        // ineq_adj
+        assign_and_advance_blasfeo_dvec_mem(nv[i], mem->ineq_adj + i, &c_ptr);
+    }
+    assign_and_advance_blasfeo_dvec_mem(np_global, &mem->out_np_global, &c_ptr);
+
+    /* cold data, which is not touched within a standard SQP iteration */
+    // parametric sensitivities
     if (opts->with_solution_sens_wrt_params_forw)
     {
+        // blasfeo_struct align
+        align_char_to(8, &c_ptr);
+        assign_and_advance_blasfeo_dmat_structs(N + 1, &mem->jac_lag_stat_p_global, &c_ptr);
+        assign_and_advance_blasfeo_dmat_structs(N + 1, &mem->jac_ineq_p_global, &c_ptr);
+        assign_and_advance_blasfeo_dmat_structs(N, &mem->jac_dyn_p_global, &c_ptr);
+
+        // blasfeo_mem align
+        align_char_to(64, &c_ptr);
         for (i = 0; i <= N; i++)
         {
             assign_and_advance_blasfeo_dmat_mem(nv[i], np_global, mem->jac_lag_stat_p_global+i, &c_ptr);
@@ -2073,59 +2174,167 @@ ocp_nlp_memory *ocp_nlp_memory_assign(ocp_nlp_config *config, ocp_nlp_dims *dims
             assign_and_advance_blasfeo_dmat_mem(nx[i+1], np_global, mem->jac_dyn_p_global+i, &c_ptr);
         }
     }
-
-    // dzduxt
-    for (i=0; i<=N; i++)
+    if (opts->with_solution_sens_wrt_params_adj)
     {
-        assign_and_advance_blasfeo_dmat_mem(nu[i]+nx[i], nz[i], mem->dzduxt+i, &c_ptr);
+        align_char_to(8, &c_ptr);
+        assign_and_advance_blasfeo_dvec_structs(N + 1, &mem->adj_p_global_stage, &c_ptr);
+        align_char_to(64, &c_ptr);
+        for (i = 0; i <= N; i++)
+        {
+            assign_and_advance_blasfeo_dvec_mem(np_global, mem->adj_p_global_stage+i, &c_ptr);
+        }
     }
-    // z_alg
-    for (i=0; i<=N; i++)
+
+    // intermediate iterates
+    if (opts->store_iterates)
     {
-        assign_and_advance_blasfeo_dvec_mem(nz[i], mem->z_alg + i, &c_ptr);
+        for (i = 0; i <= opts->max_iter; i++)
+        {
+            mem->iterates[i] = ocp_nlp_out_assign(config, dims, c_ptr);
+            c_ptr += ocp_nlp_out_calculate_size(config, dims);
+        }
     }
-    // cost_grad
-    for (i = 0; i <= N; i++)
+
+    // cold align
+    align_char_to(8, &c_ptr);
+
+    // primal step norm
+    if (opts->log_primal_step_norm)
     {
-        assign_and_advance_blasfeo_dvec_mem(nv[i], mem->cost_grad + i, &c_ptr);
+        mem->primal_step_norm = (double *) c_ptr;
+        c_ptr += opts->max_iter*sizeof(double);
     }
-    // ineq_fun
-    for (i = 0; i <= N; i++)
+
+    // dual step norm
+    if (opts->log_dual_step_norm)
     {
-        assign_and_advance_blasfeo_dvec_mem(2 * ni[i], mem->ineq_fun + i, &c_ptr);
+        mem->dual_step_norm = (double *) c_ptr;
+        c_ptr += opts->max_iter*sizeof(double);
     }
-    // ineq_adj
-    for (i = 0; i <= N; i++)
+
+    // latency histograms
+    if (opts->log_latency)
     {
-        assign_and_advance_blasfeo_dvec_mem(nv[i], mem->ineq_adj + i, &c_ptr);
+        mem->latency_hist = (acados_latency_histogram *) c_ptr;
+        c_ptr += LATENCY_NUM_FIELDS*sizeof(acados_latency_histogram);
+        for (i = 0; i < LATENCY_NUM_FIELDS; i++)
+            acados_latency_histogram_reset(mem->latency_hist+i);
     }
-    // dyn_fun
-    for (i = 0; i < N; i++)
+    else
     {
-        assign_and_advance_blasfeo_dvec_mem(nx[i + 1], mem->dyn_fun + i, &c_ptr);
+        mem->latency_hist = NULL;
     }
-    // dyn_adj
-    for (i = 0; i <= N; i++)
+
+    // profiler
+    if (opts->profiler_buffer_size > 0)
     {
-        assign_and_advance_blasfeo_dvec_mem(nu[i] + nx[i], mem->dyn_adj + i, &c_ptr);
+        align_char_to(8, &c_ptr);
+        mem->profiler = acados_profiler_assign(opts->profiler_buffer_size, c_ptr);
+        c_ptr += acados_profiler_calculate_size(opts->profiler_buffer_size);
     }
-    // sim_guess
-    for (i = 0; i <= N; i++)
+    else
     {
-        assign_and_advance_blasfeo_dvec_mem(nx[i] + nz[i], mem->sim_guess + i, &c_ptr);
-        // set to 0;
-        blasfeo_dvecse(nx[i] + nz[i], 0.0, mem->sim_guess+i, 0);
-        // printf("sim_guess i %d: %p\n", i, mem->sim_guess+i);
+        mem->profiler = NULL;
     }
-    assign_and_advance_blasfeo_dvec_mem(np_global, &mem->out_np_global, &c_ptr);
+
+    assert((char *) raw_memory + ocp_nlp_memory_calculate_size(config, dims, opts, in) >= c_ptr);
 
     mem->compute_hess = 1;
+    mem->fun_at_iterate_valid = false;
+    mem->qp_num_resolves = 0;
 
     return mem;
 }
 
 
 
+acados_size_t ocp_nlp_memory_footprint(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_opts *opts, ocp_nlp_in *nlp_in, const char *module, int stage)
+{
+    int N = dims->N;
+    acados_size_t size = 0;
+
+    if (!strcmp(module, "memory"))
+    {
+        size = ocp_nlp_memory_calculate_size(config, dims, opts, nlp_in);
+    }
+    else if (!strcmp(module, "workspace"))
+    {
+        size = ocp_nlp_workspace_calculate_size(config, dims, opts, nlp_in);
+    }
+    else if (!strcmp(module, "qp_solver"))
+    {
+        ocp_qp_xcond_solver_config *qp_solver = config->qp_solver;
+        size += ocp_qp_in_calculate_size(dims->qp_solver->orig_dims);
+        size += ocp_qp_out_calculate_size(dims->qp_solver->orig_dims);
+        size += qp_solver->memory_calculate_size(qp_solver, dims->qp_solver, opts->qp_solver_opts);
+        size += qp_solver->workspace_calculate_size(qp_solver, dims->qp_solver, opts->qp_solver_opts);
+    }
+    else if (!strcmp(module, "regularize"))
+    {
+        size = config->regularize->memory_calculate_size(config->regularize, dims->regularize, opts->regularize);
+    }
+    else if (!strcmp(module, "globalization"))
+    {
+        size = config->globalization->memory_calculate_size(config->globalization, dims);
+        if (config->globalization->needs_merit_weights())
+            size += ocp_nlp_out_calculate_size(config, dims);
+    }
+    else if (!strcmp(module, "qpscaling"))
+    {
+        size = ocp_nlp_qpscaling_memory_calculate_size(dims->qpscaling, opts->qpscaling, dims->qp_solver->orig_dims);
+    }
+    else if (!strcmp(module, "iterates"))
+    {
+        if (opts->store_iterates)
+            size = (opts->max_iter + 1) * (sizeof(struct ocp_nlp_out *) + ocp_nlp_out_calculate_size(config, dims));
+    }
+    else if (!strcmp(module, "dynamics"))
+    {
+        if (stage < 0 || stage >= N)
+        {
+            printf("\nerror: ocp_nlp_memory_footprint: stage %d out of range for dynamics\n", stage);
+            exit(1);
+        }
+        ocp_nlp_dynamics_config *dynamics = config->dynamics[stage];
+        size += dynamics->memory_calculate_size(dynamics, dims->dynamics[stage], opts->dynamics[stage]);
+        size += dynamics->workspace_calculate_size(dynamics, dims->dynamics[stage], opts->dynamics[stage]);
+        size += dynamics->get_external_fun_workspace_requirement(dynamics, dims->dynamics[stage], opts->dynamics[stage], nlp_in->dynamics[stage]);
+    }
+    else if (!strcmp(module, "cost"))
+    {
+        if (stage < 0 || stage > N)
+        {
+            printf("\nerror: ocp_nlp_memory_footprint: stage %d out of range for cost\n", stage);
+            exit(1);
+        }
+        ocp_nlp_cost_config *cost = config->cost[stage];
+        size += cost->memory_calculate_size(cost, dims->cost[stage], opts->cost[stage]);
+        size += cost->workspace_calculate_size(cost, dims->cost[stage], opts->cost[stage]);
+        size += cost->get_external_fun_workspace_requirement(cost, dims->cost[stage], opts->cost[stage], nlp_in->cost[stage]);
+    }
+    else if (!strcmp(module, "constraints"))
+    {
+        if (stage < 0 || stage > N)
+        {
+            printf("\nerror: ocp_nlp_memory_footprint: stage %d out of range for constraints\n", stage);
+            exit(1);
+        }
+        ocp_nlp_constraints_config *constraints = config->constraints[stage];
+        size += constraints->memory_calculate_size(constraints, dims->constraints[stage], opts->constraints[stage]);
+        size += constraints->workspace_calculate_size(constraints, dims->constraints[stage], opts->constraints[stage]);
+        size += constraints->get_external_fun_workspace_requirement(constraints, dims->constraints[stage], opts->constraints[stage], nlp_in->constraints[stage]);
+    }
+    else
+    {
+        printf("\nerror: ocp_nlp_memory_footprint: module %s not supported\n", module);
+        exit(1);
+    }
+
+    return size;
+}
+
+
+
 /************************************************
  * workspace
  ************************************************/
@@ -2158,7 +2367,10 @@ acados_size_t ocp_nlp_workspace_calculate_size(ocp_nlp_config *config, ocp_nlp_d
     size += ocp_nlp_out_calculate_size(config, dims);
 
     // weight_merit_fun
-    size += ocp_nlp_out_calculate_size(config, dims);
+    if (config->globalization->needs_merit_weights())
+    {
+        size += ocp_nlp_out_calculate_size(config, dims);
+    }
 
     // tmp_qp_out
     size += ocp_qp_out_calculate_size(dims->qp_solver->orig_dims);
@@ -2208,28 +2420,33 @@ acados_size_t ocp_nlp_workspace_calculate_size(ocp_nlp_config *config, ocp_nlp_d
     if (opts->reuse_workspace)
     {
 #if defined(ACADOS_WITH_OPENMP)
-        // qp solver
-        size += qp_solver->workspace_calculate_size(qp_solver, dims->qp_solver,
-            opts->qp_solver_opts);
+        // the module workspaces are used in parallel over the stages, but never at the same time as the qp solver workspace
+        acados_size_t size_modules = 0;
 
         // dynamics
         for (int i = 0; i < N; i++)
         {
-            size += dynamics[i]->workspace_calculate_size(dynamics[i], dims->dynamics[i], opts->dynamics[i]);
+            size_modules += dynamics[i]->workspace_calculate_size(dynamics[i], dims->dynamics[i], opts->dynamics[i]);
         }
 
         // cost
         for (int i = 0; i <= N; i++)
         {
-            size += cost[i]->workspace_calculate_size(cost[i], dims->cost[i], opts->cost[i]);
+            size_modules += cost[i]->workspace_calculate_size(cost[i], dims->cost[i], opts->cost[i]);
         }
 
         // constraints
         for (int i = 0; i <= N; i++)
         {
-            size += constraints[i]->workspace_calculate_size(constraints[i], dims->constraints[i], opts->constraints[i]);
+            size_modules += constraints[i]->workspace_calculate_size(constraints[i], dims->constraints[i], opts->constraints[i]);
         }
 
+        // qp solver
+        acados_size_t size_qp = qp_solver->workspace_calculate_size(qp_solver, dims->qp_solver,
+            opts->qp_solver_opts);
+
+        size += size_qp > size_modules ? size_qp : size_modules;
+
 #else
         acados_size_t size_tmp = 0;
         int tmp;
@@ -2416,8 +2633,15 @@ ocp_nlp_workspace *ocp_nlp_workspace_assign(ocp_nlp_config *config, ocp_nlp_dims
     c_ptr += ocp_qp_out_calculate_size(dims->qp_solver->orig_dims);
 
     // weight_merit_fun
-    work->weight_merit_fun = ocp_nlp_out_assign(config, dims, c_ptr);
-    c_ptr += ocp_nlp_out_calculate_size(config, dims);
+    if (config->globalization->needs_merit_weights())
+    {
+        work->weight_merit_fun = ocp_nlp_out_assign(config, dims, c_ptr);
+        c_ptr += ocp_nlp_out_calculate_size(config, dims);
+    }
+    else
+    {
+        work->weight_merit_fun = NULL;
+    }
 
     // qp seed
     work->qp_seed = ocp_qp_seed_assign(dims->qp_solver->orig_dims, c_ptr);
@@ -2448,9 +2672,10 @@ ocp_nlp_workspace *ocp_nlp_workspace_assign(ocp_nlp_config *config, ocp_nlp_dims
     if (opts->reuse_workspace)
     {
 #if defined(ACADOS_WITH_OPENMP)
-        // qp solver
+        // qp solver, shares memory with the module workspaces
         work->qp_work = (void *) c_ptr;
-        c_ptr += qp_solver->workspace_calculate_size(qp_solver, dims->qp_solver, opts->qp_solver_opts);
+        acados_size_t size_qp = qp_solver->workspace_calculate_size(qp_solver, dims->qp_solver, opts->qp_solver_opts);
+        char *c_ptr_modules = c_ptr;
 
         // dynamics
         for (int i = 0; i < N; i++)
@@ -2472,6 +2697,8 @@ ocp_nlp_workspace *ocp_nlp_workspace_assign(ocp_nlp_config *config, ocp_nlp_dims
             work->constraints[i] = c_ptr;
             c_ptr += constraints[i]->workspace_calculate_size(constraints[i], dims->constraints[i], opts->constraints[i]);
         }
+        if (c_ptr < c_ptr_modules + size_qp)
+            c_ptr = c_ptr_modules + size_qp;
 #else
         acados_size_t size_tmp = 0;
         int tmp;
@@ -2813,7 +3040,7 @@ void ocp_nlp_alias_memory_to_submodules(ocp_nlp_config *config, ocp_nlp_dims *di
         }
         if (opts->with_solution_sens_wrt_params_adj)
         {
-            config->dynamics[i]->memory_set_adj_lag_p_global_ptr(&nlp_mem->out_np_global, nlp_mem->dynamics[i]);
+            config->dynamics[i]->memory_set_adj_lag_p_global_ptr(nlp_mem->adj_p_global_stage+i, nlp_mem->dynamics[i]);
         }
 
         int cost_integration;
@@ -2854,7 +3081,7 @@ void ocp_nlp_alias_memory_to_submodules(ocp_nlp_config *config, ocp_nlp_dims *di
         }
         if (opts->with_solution_sens_wrt_params_adj)
         {
-            config->cost[i]->memory_set_adj_lag_p_global_ptr(&nlp_mem->out_np_global, nlp_mem->cost[i]);
+            config->cost[i]->memory_set_adj_lag_p_global_ptr(nlp_mem->adj_p_global_stage+i, nlp_mem->cost[i]);
         }
         config->cost[i]->memory_set_ux_ptr(nlp_out->ux+i, nlp_mem->cost[i]);
         config->cost[i]->memory_set_z_alg_ptr(nlp_mem->z_alg+i, nlp_mem->cost[i]);
@@ -2886,7 +3113,7 @@ void ocp_nlp_alias_memory_to_submodules(ocp_nlp_config *config, ocp_nlp_dims *di
         if (opts->with_solution_sens_wrt_params_adj)
         {
             config->constraints[i]->memory_set(config->constraints[i], dims->constraints[i],
-                nlp_mem->constraints[i], "adj_lag_p_global_ptr", &nlp_mem->out_np_global);
+                nlp_mem->constraints[i], "adj_lag_p_global_ptr", nlp_mem->adj_p_global_stage+i);
         }
     }
 
@@ -2940,6 +3167,12 @@ void ocp_nlp_initialize_submodules(ocp_nlp_config *config, ocp_nlp_dims *dims, o
                 in->constraints[i], opts->constraints[i], mem->constraints[i], work->constraints[i]);
     }
 
+    // constraint matrices might have been changed by the user
+    bool constr_cache_valid = false;
+    ocp_nlp_qpscaling_memory_set(dims->qpscaling, mem->qpscaling, "constr_cache_valid", 0, &constr_cache_valid);
+
+    mem->qp_num_resolves = 0;
+
     return;
 }
 
@@ -3022,12 +3255,16 @@ void ocp_nlp_approximate_qp_matrices(ocp_nlp_config *config, ocp_nlp_dims *dims,
     int *nx = dims->nx;
     int *nu = dims->nu;
 
+    acados_profiler *prof = mem->profiler;
+
     /* stage-wise multiple shooting lagrangian evaluation */
 #if defined(ACADOS_WITH_OPENMP)
     #pragma omp parallel for
 #endif
     for (int i = 0; i <= N; i++)
     {
+        double t_prof = 0.0;
+
         // // init Hessian to 0
         // if (mem->compute_hess)
         // {
@@ -3038,17 +3275,31 @@ void ocp_nlp_approximate_qp_matrices(ocp_nlp_config *config, ocp_nlp_dims *dims,
         // dynamics: NOTE: has to be first, as it computes z, which is used in cost and constraints.
         if (i < N)
         {
+            if (prof) t_prof = acados_profiler_time(prof);
             config->dynamics[i]->update_qp_matrices(config->dynamics[i], dims->dynamics[i],
                 in->dynamics[i], opts->dynamics[i], mem->dynamics[i], work->dynamics[i]);
+            if (prof)
+            {
+                acados_profiler_record(prof, ACADOS_PROFILER_DYNAMICS, i, mem->iter, t_prof, acados_profiler_time(prof));
+                // external functions are called throughout the integrator, their total time is placed at the start of the dynamics event
+                double time_ext_fun;
+                config->dynamics[i]->memory_get(config->dynamics[i], dims->dynamics[i], mem->dynamics[i], "time_sim_ad", &time_ext_fun);
+                if (time_ext_fun > 0.0)
+                    acados_profiler_record(prof, ACADOS_PROFILER_EXT_FUN, i, mem->iter, t_prof, t_prof + time_ext_fun);
+            }
         }
 
         // cost
+        if (prof) t_prof = acados_profiler_time(prof);
         config->cost[i]->update_qp_matrices(config->cost[i], dims->cost[i], in->cost[i],
                     opts->cost[i], mem->cost[i], work->cost[i]);
+        if (prof) acados_profiler_record(prof, ACADOS_PROFILER_COST, i, mem->iter, t_prof, acados_profiler_time(prof));
 
         // constraints
+        if (prof) t_prof = acados_profiler_time(prof);
         config->constraints[i]->update_qp_matrices(config->constraints[i], dims->constraints[i],
                 in->constraints[i], opts->constraints[i], mem->constraints[i], work->constraints[i]);
+        if (prof) acados_profiler_record(prof, ACADOS_PROFILER_CONSTRAINTS, i, mem->iter, t_prof, acados_profiler_time(prof));
     }
 
     /* collect stage-wise evaluations */
@@ -3373,11 +3624,224 @@ void ocp_nlp_initialize_qp_from_nlp(ocp_nlp_config *config, ocp_nlp_dims *dims,
 }
 
 
-double ocp_nlp_compute_anderson_gamma(ocp_nlp_workspace *work, ocp_qp_out *new_qp_step, ocp_qp_out *new_minus_old_qp_step)
+// stage contribution to ocp_qp_out_ddot, without shared workspace
+static double ocp_nlp_anderson_stage_ddot(ocp_qp_dims *dims, int i, ocp_qp_out *x, ocp_qp_out *y)
+{
+    int *nx = dims->nx;
+    int *nu = dims->nu;
+    int *ns = dims->ns;
+    int nbg = dims->nbu[i]+dims->nbx[i]+dims->ng[i];
+
+    double out = blasfeo_ddot(nx[i]+nu[i]+2*ns[i], x->ux+i, 0, y->ux+i, 0);
+    // multipliers as lower - upper bound
+    for (int j = 0; j < nbg; j++)
+    {
+        out += (BLASFEO_DVECEL(x->lam+i, j) - BLASFEO_DVECEL(x->lam+i, nbg+j)) *
+               (BLASFEO_DVECEL(y->lam+i, j) - BLASFEO_DVECEL(y->lam+i, nbg+j));
+    }
+    // multipliers wrt slack bounds
+    out += blasfeo_ddot(2*ns[i], x->lam+i, 2*nbg, y->lam+i, 2*nbg);
+    if (i < dims->N)
+    {
+        out += blasfeo_ddot(nx[i+1], x->pi+i, 0, y->pi+i, 0);
+    }
+    return out;
+}
+
+
+// inner product of ocp_nlp_anderson_stage_ddot, stage contributions are summed in stage order
+static double ocp_nlp_anderson_ddot(ocp_qp_dims *dims, double *stage_dot, ocp_qp_out *x, ocp_qp_out *y)
 {
-    double gamma = ocp_qp_out_ddot(new_qp_step, new_minus_old_qp_step, &work->tmp_2ni) /
-                        ocp_qp_out_ddot(new_minus_old_qp_step, new_minus_old_qp_step, &work->tmp_2ni);
-    return gamma;
+    int N = dims->N;
+#if defined(ACADOS_WITH_OPENMP)
+    #pragma omp parallel for
+#endif
+    for (int i = 0; i <= N; i++)
+        stage_dot[i] = ocp_nlp_anderson_stage_ddot(dims, i, x, y);
+
+    double out = 0.0;
+    for (int i = 0; i <= N; i++)
+        out += stage_dot[i];
+    return out;
+}
+
+
+// y = alpha * x + beta * y, on the components entering ocp_nlp_anderson_stage_ddot; y is overwritten if beta == 0
+static void ocp_nlp_anderson_axpby(ocp_qp_dims *dims, double alpha, ocp_qp_out *x, double beta, ocp_qp_out *y)
+{
+    int N = dims->N;
+    int *nx = dims->nx;
+    int *nu = dims->nu;
+    int *ns = dims->ns;
+#if defined(ACADOS_WITH_OPENMP)
+    #pragma omp parallel for
+#endif
+    for (int i = 0; i <= N; i++)
+    {
+        int ni_stage = ocp_qp_dims_get_ni(dims, i);
+        if (beta == 0.0)
+        {
+            blasfeo_dveccpsc(nx[i]+nu[i]+2*ns[i], alpha, x->ux+i, 0, y->ux+i, 0);
+            blasfeo_dveccpsc(2*ni_stage, alpha, x->lam+i, 0, y->lam+i, 0);
+            if (i < N)
+                blasfeo_dveccpsc(nx[i+1], alpha, x->pi+i, 0, y->pi+i, 0);
+        }
+        else
+        {
+            blasfeo_daxpby(nx[i]+nu[i]+2*ns[i], alpha, x->ux+i, 0, beta, y->ux+i, 0, y->ux+i, 0);
+            blasfeo_daxpby(2*ni_stage, alpha, x->lam+i, 0, beta, y->lam+i, 0, y->lam+i, 0);
+            if (i < N)
+                blasfeo_daxpby(nx[i+1], alpha, x->pi+i, 0, beta, y->pi+i, 0, y->pi+i, 0);
+        }
+    }
+}
+
+
+/* Anderson step of depth opts->anderson_depth, written to mem->anderson_step:
+ *   anderson_step = alpha * d_k - sum_j gamma_j * (dx_j + alpha * dd_j),
+ * where gamma minimizes || d_k - sum_j gamma_j dd_j ||,
+ * dx_j are previous steps and dd_j are differences of consecutive QP steps.
+ * The least squares problem is solved by a modified Gram-Schmidt QR factorization of the dd_j.
+ * Expects mem->anderson_step to hold the previous step and mem->prev_qp_out the previous QP step. */
+void ocp_nlp_compute_anderson_step(ocp_nlp_opts *opts, ocp_nlp_memory *mem, ocp_qp_out *qp_step, double alpha)
+{
+    ocp_qp_dims *dims = qp_step->dim;
+    int N = dims->N;
+    int *nx = dims->nx;
+    int *nu = dims->nu;
+    int *ns = dims->ns;
+
+    int m = opts->anderson_depth;
+    int new_slot = mem->anderson_next;
+    int len = mem->anderson_len < m ? mem->anderson_len + 1 : m;
+
+    double *R = mem->anderson_qr_r;
+    double *c = mem->anderson_rhs;
+    double *gamma = mem->anderson_gamma;
+    double *stage_dot = mem->anderson_stage_dot;
+
+    ocp_qp_out **dx = mem->anderson_dx;
+    ocp_qp_out **dd = mem->anderson_dd;
+    ocp_qp_out **Q = mem->anderson_q;
+    // the previous step is stored in dx, anderson_step is used as workspace until the new step is written
+    ocp_qp_out *z = mem->anderson_step;
+
+    // slot of history entry with age a (0: newest)
+    #define ANDERSON_SLOT(a) ((new_slot - (a) + m) % m)
+
+    /* store new history entry */
+#if defined(ACADOS_WITH_OPENMP)
+    #pragma omp parallel for
+#endif
+    for (int i = 0; i <= N; i++)
+    {
+        int ni_stage = ocp_qp_dims_get_ni(dims, i);
+        int nux = nx[i]+nu[i]+2*ns[i];
+        // dd_new = d_k - d_{k-1}
+        blasfeo_daxpy(nux, -1.0, mem->prev_qp_out->ux+i, 0, qp_step->ux+i, 0, dd[new_slot]->ux+i, 0);
+        blasfeo_daxpy(2*ni_stage, -1.0, mem->prev_qp_out->lam+i, 0, qp_step->lam+i, 0, dd[new_slot]->lam+i, 0);
+        blasfeo_daxpy(2*ni_stage, -1.0, mem->prev_qp_out->t+i, 0, qp_step->t+i, 0, dd[new_slot]->t+i, 0);
+        // dx_new = previous step
+        blasfeo_dveccp(nux, mem->anderson_step->ux+i, 0, dx[new_slot]->ux+i, 0);
+        blasfeo_dveccp(2*ni_stage, mem->anderson_step->lam+i, 0, dx[new_slot]->lam+i, 0);
+        blasfeo_dveccp(2*ni_stage, mem->anderson_step->t+i, 0, dx[new_slot]->t+i, 0);
+        if (i < N)
+        {
+            blasfeo_daxpy(nx[i+1], -1.0, mem->prev_qp_out->pi+i, 0, qp_step->pi+i, 0, dd[new_slot]->pi+i, 0);
+            blasfeo_dveccp(nx[i+1], mem->anderson_step->pi+i, 0, dx[new_slot]->pi+i, 0);
+        }
+    }
+
+    /* modified Gram-Schmidt QR of [dd_newest, ..., dd_oldest];
+     * columns that are numerically linearly dependent on newer ones are dropped, R[a*m+a] = 0 */
+    double eps = 1e-10;
+    for (int a = 0; a < len; a++)
+    {
+        int s = ANDERSON_SLOT(a);
+        double norm_dd = sqrt(ocp_nlp_anderson_ddot(dims, stage_dot, dd[s], dd[s]));
+        ocp_nlp_anderson_axpby(dims, 1.0, dd[s], 0.0, Q[a]);
+        for (int b = 0; b < a; b++)
+        {
+            R[b*m + a] = 0.0;
+            if (R[b*m + b] > 0.0)
+            {
+                R[b*m + a] = ocp_nlp_anderson_ddot(dims, stage_dot, Q[b], Q[a]);
+                ocp_nlp_anderson_axpby(dims, -R[b*m + a], Q[b], 1.0, Q[a]);
+            }
+        }
+        double norm_q = sqrt(ocp_nlp_anderson_ddot(dims, stage_dot, Q[a], Q[a]));
+        if (norm_q > eps * norm_dd)
+        {
+            R[a*m + a] = norm_q;
+            ocp_nlp_anderson_axpby(dims, 1.0/norm_q, Q[a], 0.0, Q[a]);
+        }
+        else
+        {
+            R[a*m + a] = 0.0;
+        }
+    }
+
+    /* c = Q^T d_k, by successive projections of d_k */
+    ocp_nlp_anderson_axpby(dims, 1.0, qp_step, 0.0, z);
+    for (int a = 0; a < len; a++)
+    {
+        c[a] = 0.0;
+        if (R[a*m + a] > 0.0)
+        {
+            c[a] = ocp_nlp_anderson_ddot(dims, stage_dot, Q[a], z);
+            ocp_nlp_anderson_axpby(dims, -c[a], Q[a], 1.0, z);
+        }
+    }
+
+    // solve R gamma = c
+    for (int a = len-1; a >= 0; a--)
+    {
+        gamma[a] = 0.0;
+        if (R[a*m + a] > 0.0)
+        {
+            double tmp = c[a];
+            for (int b = a+1; b < len; b++)
+                tmp -= R[a*m + b] * gamma[b];
+            gamma[a] = tmp / R[a*m + a];
+        }
+    }
+
+    /* anderson_step = alpha * d_k - sum_j gamma_j * (dx_j + alpha * dd_j) */
+#if defined(ACADOS_WITH_OPENMP)
+    #pragma omp parallel for
+#endif
+    for (int i = 0; i <= N; i++)
+    {
+        int ni_stage = ocp_qp_dims_get_ni(dims, i);
+        int nux = nx[i]+nu[i]+2*ns[i];
+        ocp_qp_out *step = mem->anderson_step;
+        blasfeo_dveccpsc(nux, alpha, qp_step->ux+i, 0, step->ux+i, 0);
+        blasfeo_dveccpsc(2*ni_stage, alpha, qp_step->lam+i, 0, step->lam+i, 0);
+        blasfeo_dveccpsc(2*ni_stage, alpha, qp_step->t+i, 0, step->t+i, 0);
+        if (i < N)
+            blasfeo_dveccpsc(nx[i+1], alpha, qp_step->pi+i, 0, step->pi+i, 0);
+        for (int a = 0; a < len; a++)
+        {
+            if (gamma[a] == 0.0)
+                continue;
+            int s = ANDERSON_SLOT(a);
+            blasfeo_dvecad(nux, -gamma[a], dx[s]->ux+i, 0, step->ux+i, 0);
+            blasfeo_dvecad(nux, -alpha*gamma[a], dd[s]->ux+i, 0, step->ux+i, 0);
+            blasfeo_dvecad(2*ni_stage, -gamma[a], dx[s]->lam+i, 0, step->lam+i, 0);
+            blasfeo_dvecad(2*ni_stage, -alpha*gamma[a], dd[s]->lam+i, 0, step->lam+i, 0);
+            blasfeo_dvecad(2*ni_stage, -gamma[a], dx[s]->t+i, 0, step->t+i, 0);
+            blasfeo_dvecad(2*ni_stage, -alpha*gamma[a], dd[s]->t+i, 0, step->t+i, 0);
+            if (i < N)
+            {
+                blasfeo_dvecad(nx[i+1], -gamma[a], dx[s]->pi+i, 0, step->pi+i, 0);
+                blasfeo_dvecad(nx[i+1], -alpha*gamma[a], dd[s]->pi+i, 0, step->pi+i, 0);
+            }
+        }
+    }
+    #undef ANDERSON_SLOT
+
+    mem->anderson_len = len;
+    mem->anderson_next = (new_slot + 1) % m;
 }
 
 
@@ -3560,6 +4024,13 @@ int ocp_nlp_precompute_common(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nl
     }
 
     ocp_nlp_qpscaling_precompute(dims->qpscaling, opts->qpscaling, mem->qpscaling, mem->qp_in, mem->qp_out);
+    // the linear general constraints come first and are only set in constraints initialize
+    int ng_const;
+    for (ii = 0; ii <= N; ii++)
+    {
+        config->constraints[ii]->dims_get(config->constraints[ii], dims->constraints[ii], "ng", &ng_const);
+        ocp_nlp_qpscaling_memory_set(dims->qpscaling, mem->qpscaling, "ng_const", ii, &ng_const);
+    }
 
     // alias from qp scaling memory (has to be after qpscaling precompute)
     ocp_nlp_qpscaling_memory_get(dims->qpscaling, mem->qpscaling, "scaled_qp_in", 0, &mem->scaled_qp_in);
@@ -3914,8 +4385,9 @@ void ocp_nlp_eval_constraints_common(ocp_nlp_config *config, ocp_nlp_dims *dims,
 int ocp_nlp_common_setup_qp_matrices_and_factorize(ocp_nlp_config *config, ocp_nlp_dims *dims_, ocp_nlp_in *nlp_in, ocp_nlp_out *nlp_out,
                 ocp_nlp_opts *nlp_opts, ocp_nlp_memory *nlp_mem, ocp_nlp_workspace *nlp_work)
 {
-    acados_timer timer0, timer1;
-    acados_tic(&timer0);
+    acados_profiler *prof = nlp_mem->profiler;
+    acados_profiler_span span_tot, span;
+    acados_profiler_span_start(prof, &span_tot);
 
     ocp_nlp_dims *dims = dims_;
     ocp_qp_xcond_solver_config *qp_solver = config->qp_solver;
@@ -3931,11 +4403,11 @@ int ocp_nlp_common_setup_qp_matrices_and_factorize(ocp_nlp_config *config, ocp_n
 
     /* Prepare the QP data */
     // linearize NLP and update QP matrices
-    acados_tic(&timer1);
+    acados_profiler_span_start(prof, &span);
     ocp_nlp_approximate_qp_matrices(config, dims, nlp_in, nlp_out, nlp_opts, nlp_mem, nlp_work);
     // update QP rhs for SQP (step prim var, abs dual var)
     ocp_nlp_approximate_qp_vectors_sqp(config, dims, nlp_in, nlp_out, nlp_opts, nlp_mem, nlp_work);
-    nlp_timings->time_lin = acados_toc(&timer1);
+    nlp_timings->time_lin = acados_profiler_span_end(prof, &span, ACADOS_PROFILER_LIN, -1, nlp_mem->iter);
 
     /* solve QP */
     // warm start QP
@@ -3979,7 +4451,7 @@ int ocp_nlp_common_setup_qp_matrices_and_factorize(ocp_nlp_config *config, ocp_n
         nlp_mem->status = ACADOS_SUCCESS;
     }
 
-    nlp_timings->time_tot = acados_toc(&timer0);
+    nlp_timings->time_tot = acados_profiler_span_end(prof, &span_tot, ACADOS_PROFILER_SOLVE, -1, nlp_mem->iter);
 
     return nlp_mem->status;
 }
@@ -4036,15 +4508,12 @@ void ocp_nlp_params_jac_compute(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_
 }
 
 
-void ocp_nlp_common_eval_param_sens(ocp_nlp_config *config, ocp_nlp_dims *dims,
-                        ocp_nlp_opts *opts, ocp_nlp_memory *mem, ocp_nlp_workspace *work,
-                        char *field, int stage, int index, ocp_nlp_out *sens_nlp_out)
+// writes the seed of direction index into qp_seed, entries of other directions are not cleared
+static void ocp_nlp_common_set_param_sens_seed(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_memory *mem,
+                        ocp_qp_seed *qp_seed, char *field, int stage, int index, double value)
 {
-    int i;
-
     int N = dims->N;
     int *nv = dims->nv;
-    int *ni = dims->ni;
     int *nx = dims->nx;
     int *nb = dims->nb;
     int *ng = dims->ng;
@@ -4054,20 +4523,17 @@ void ocp_nlp_common_eval_param_sens(ocp_nlp_config *config, ocp_nlp_dims *dims,
     struct blasfeo_dmat *jac_ineq_p_global = mem->jac_ineq_p_global;
     struct blasfeo_dmat *jac_dyn_p_global = mem->jac_dyn_p_global;
 
-    ocp_qp_out *tmp_qp_out = work->tmp_qp_out;
-    ocp_qp_seed *qp_seed = work->qp_seed;
-    d_ocp_qp_seed_set_zero(qp_seed);
-
     if ((!strcmp("ex", field)) && (stage==0))
     {
         int tmp_nbu;
         config->constraints[0]->dims_get(config->constraints[0], dims->constraints[0], "nbu", &tmp_nbu);
-        BLASFEO_DVECEL(qp_seed->seed_d+0, tmp_nbu+index) = 1.0;
-        BLASFEO_DVECEL(qp_seed->seed_d+0, tmp_nbu+index+nb[0]+ng[0]+ni_nl[0]) = 1.0;
+        BLASFEO_DVECEL(qp_seed->seed_d+0, tmp_nbu+index) = value;
+        BLASFEO_DVECEL(qp_seed->seed_d+0, tmp_nbu+index+nb[0]+ng[0]+ni_nl[0]) = value;
     }
     else if (!strcmp("p_global", field))
     {
-        for (i = 0; i <= N; i++)
+        // overwrites all entries depending on p_global
+        for (int i = 0; i <= N; i++)
         {
             // stationarity
             blasfeo_dcolex(nv[i], &jac_lag_stat_p_global[i], 0, index, &qp_seed->seed_g[i], 0);
@@ -4086,6 +4552,25 @@ void ocp_nlp_common_eval_param_sens(ocp_nlp_config *config, ocp_nlp_dims *dims,
         printf("\nerror: field %s at stage %d not available in ocp_nlp_common_eval_param_sens\n", field, stage);
         exit(1);
     }
+}
+
+
+void ocp_nlp_common_eval_param_sens(ocp_nlp_config *config, ocp_nlp_dims *dims,
+                        ocp_nlp_opts *opts, ocp_nlp_memory *mem, ocp_nlp_workspace *work,
+                        char *field, int stage, int index, ocp_nlp_out *sens_nlp_out)
+{
+    int i;
+
+    int N = dims->N;
+    int *nv = dims->nv;
+    int *ni = dims->ni;
+    int *nx = dims->nx;
+
+    ocp_qp_out *tmp_qp_out = work->tmp_qp_out;
+    ocp_qp_seed *qp_seed = work->qp_seed;
+    d_ocp_qp_seed_set_zero(qp_seed);
+
+    ocp_nlp_common_set_param_sens_seed(config, dims, mem, qp_seed, field, stage, index, 1.0);
 
     // d_ocp_qp_seed_print(qp_seed->dim, qp_seed);
     config->qp_solver->eval_forw_sens(config->qp_solver, dims->qp_solver, mem->qp_in, qp_seed, tmp_qp_out,
@@ -4105,12 +4590,106 @@ void ocp_nlp_common_eval_param_sens(ocp_nlp_config *config, ocp_nlp_dims *dims,
 }
 
 
+// sensitivities in directions index, ..., index+n_dir-1, reusing the factorization of the last QP;
+// column k of sens holds [ux; pi; lam] of all stages, stage after stage
+void ocp_nlp_common_eval_param_sens_block(ocp_nlp_config *config, ocp_nlp_dims *dims,
+                        ocp_nlp_opts *opts, ocp_nlp_memory *mem, ocp_nlp_workspace *work,
+                        char *field, int stage, int index, int n_dir, double *sens, int ld_sens)
+{
+    acados_profiler_span span;
+    acados_profiler_span_start(mem->profiler, &span);
+
+    int N = dims->N;
+    int *nv = dims->nv;
+    int *ni = dims->ni;
+    int *nx = dims->nx;
+
+    ocp_qp_out *tmp_qp_out = work->tmp_qp_out;
+    ocp_qp_seed *qp_seed = work->qp_seed;
+    d_ocp_qp_seed_set_zero(qp_seed);
+
+    for (int k = 0; k < n_dir; k++)
+    {
+        ocp_nlp_common_set_param_sens_seed(config, dims, mem, qp_seed, field, stage, index+k, 1.0);
+
+        config->qp_solver->eval_forw_sens(config->qp_solver, dims->qp_solver, mem->qp_in, qp_seed, tmp_qp_out,
+                                opts->qp_solver_opts, mem->qp_solver_mem, work->qp_work);
+
+        double *col = sens + k*ld_sens;
+        for (int i = 0; i <= N; i++)
+        {
+            blasfeo_unpack_dvec(nv[i], tmp_qp_out->ux + i, 0, col, 1);
+            col += nv[i];
+            if (i < N)
+            {
+                blasfeo_unpack_dvec(nx[i+1], tmp_qp_out->pi + i, 0, col, 1);
+                col += nx[i+1];
+            }
+            blasfeo_unpack_dvec(2 * ni[i], tmp_qp_out->lam + i, 0, col, 1);
+            col += 2 * ni[i];
+        }
+
+        // unit seeds only touch the entries of their direction
+        if (!strcmp("ex", field))
+            ocp_nlp_common_set_param_sens_seed(config, dims, mem, qp_seed, field, stage, index+k, 0.0);
+    }
+
+    mem->nlp_timings->time_solution_sensitivities = acados_profiler_span_end(mem->profiler, &span, ACADOS_PROFILER_SENS, -1, mem->iter);
+}
+
+
+// accumulates the adjoint sensitivity wrt p_global from the adjoint QP solution in tmp_qp_out;
+// the stages write into their own accumulators, which are summed up in stage order afterwards
+static void ocp_nlp_common_adj_p_global_from_qp_out(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_in *in,
+                        ocp_nlp_opts *opts, ocp_nlp_memory *mem, ocp_nlp_workspace *work,
+                        ocp_qp_out *tmp_qp_out, double *grad_p)
+{
+    int N = dims->N;
+    int np_global = dims->np_global;
+
+#if defined(ACADOS_WITH_OPENMP)
+    #pragma omp parallel for
+#endif
+    for (int i = 0; i <= N; i++)
+    {
+        blasfeo_dvecse(np_global, 0., mem->adj_p_global_stage+i, 0);
+        // cost
+        config->cost[i]->memory_set_seed_ux_ptr(tmp_qp_out->ux+i, mem->cost[i]);
+        config->cost[i]->compute_adj_sol_sens_pdiff(config->cost[i], dims->cost[i], in->cost[i],
+                        opts->cost[i], mem->cost[i], work->cost[i]);
+        // dynamics
+        if (i < N)
+        {
+            config->dynamics[i]->memory_set_seed_ux_ptr(tmp_qp_out->ux+i, mem->dynamics[i]);
+            config->dynamics[i]->memory_set_seed_pi_ptr(tmp_qp_out->pi+i, mem->dynamics[i]);
+            config->dynamics[i]->compute_adj_sol_sens_pdiff(config->dynamics[i], dims->dynamics[i], in->dynamics[i],
+                        opts->dynamics[i], mem->dynamics[i], work->dynamics[i]);
+        }
+
+        // constraints
+        config->constraints[i]->memory_set(config->constraints[i], dims->constraints[i], mem->constraints[i], "seed_ux", tmp_qp_out->ux+i);
+        config->constraints[i]->memory_set(config->constraints[i], dims->constraints[i], mem->constraints[i], "seed_lam", tmp_qp_out->lam+i);
+        config->constraints[i]->compute_adj_sol_sens_pdiff(config->constraints[i], dims->constraints[i],
+            in->constraints[i], opts->constraints[i], mem->constraints[i], work->constraints[i]);
+    }
+
+    // reduction
+    blasfeo_dveccp(np_global, mem->adj_p_global_stage+0, 0, &mem->out_np_global, 0);
+    for (int i = 1; i <= N; i++)
+    {
+        blasfeo_daxpy(np_global, 1.0, mem->adj_p_global_stage+i, 0, &mem->out_np_global, 0, &mem->out_np_global, 0);
+    }
+    // unpack
+    blasfeo_unpack_dvec(np_global, &mem->out_np_global, 0, grad_p, 1);
+}
+
+
 void ocp_nlp_common_eval_solution_sens_adj_p(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_in *in,
                         ocp_nlp_opts *opts, ocp_nlp_memory *mem, ocp_nlp_workspace *work,
                         ocp_nlp_out *sens_nlp_out, const char *field, int stage, void *grad_p)
 {
-    acados_timer timer;
-    acados_tic(&timer);
+    acados_profiler_span span;
+    acados_profiler_span_start(mem->profiler, &span);
 
     if (!opts->with_solution_sens_wrt_params_adj)
     {
@@ -4119,7 +4698,6 @@ void ocp_nlp_common_eval_solution_sens_adj_p(ocp_nlp_config *config, ocp_nlp_dim
     }
     int i;
     int N = dims->N;
-    int np_global = dims->np_global;
 
     int *nv = dims->nv;
 
@@ -4143,38 +4721,61 @@ void ocp_nlp_common_eval_solution_sens_adj_p(ocp_nlp_config *config, ocp_nlp_dim
 
     if (!strcmp("p_global", field))
     {
-        blasfeo_dvecse(np_global, 0., &mem->out_np_global, 0);
-
-        for (i = 0; i <= N; i++)
-        {
-            // cost
-            config->cost[i]->memory_set_seed_ux_ptr(tmp_qp_out->ux+i, mem->cost[i]);
-            config->cost[i]->compute_adj_sol_sens_pdiff(config->cost[i], dims->cost[i], in->cost[i],
-                            opts->cost[i], mem->cost[i], work->cost[i]);
-            // dynamics
-            if (i < N)
-            {
-                config->dynamics[i]->memory_set_seed_ux_ptr(tmp_qp_out->ux+i, mem->dynamics[i]);
-                config->dynamics[i]->memory_set_seed_pi_ptr(tmp_qp_out->pi+i, mem->dynamics[i]);
-                config->dynamics[i]->compute_adj_sol_sens_pdiff(config->dynamics[i], dims->dynamics[i], in->dynamics[i],
-                            opts->dynamics[i], mem->dynamics[i], work->dynamics[i]);
-            }
-
-            // constraints
-            config->constraints[i]->memory_set(config->constraints[i], dims->constraints[i], mem->constraints[i], "seed_ux", tmp_qp_out->ux+i);
-            config->constraints[i]->memory_set(config->constraints[i], dims->constraints[i], mem->constraints[i], "seed_lam", tmp_qp_out->lam+i);
-            config->constraints[i]->compute_adj_sol_sens_pdiff(config->constraints[i], dims->constraints[i],
-                in->constraints[i], opts->constraints[i], mem->constraints[i], work->constraints[i]);
-        }
-        // unpack
-        blasfeo_unpack_dvec(np_global, &mem->out_np_global, 0, grad_p, 1);
+        ocp_nlp_common_adj_p_global_from_qp_out(config, dims, in, opts, mem, work, tmp_qp_out, grad_p);
     }
     else
     {
         printf("\nerror: field %s at stage %d not available in ocp_nlp_common_eval_solution_sens_adj_p\n", field, stage);
         exit(1);
     }
-    mem->nlp_timings->time_solution_sensitivities = acados_toc(&timer);
+    mem->nlp_timings->time_solution_sensitivities = acados_profiler_span_end(mem->profiler, &span, ACADOS_PROFILER_SENS, -1, mem->iter);
+}
+
+
+// adjoint sensitivities for n_dir seeds, reusing the factorization of the last QP;
+// column k of seed holds the seed for ux of all stages, column k of grad_p the result
+void ocp_nlp_common_eval_solution_sens_adj_p_block(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_in *in,
+                        ocp_nlp_opts *opts, ocp_nlp_memory *mem, ocp_nlp_workspace *work,
+                        const char *field, int n_dir, double *seed, int ld_seed, double *grad_p, int ld_grad)
+{
+    acados_profiler_span span;
+    acados_profiler_span_start(mem->profiler, &span);
+
+    if (!opts->with_solution_sens_wrt_params_adj)
+    {
+        printf("ocp_nlp_common_eval_solution_sens_adj_p_block: option with_solution_sens_wrt_params_adj has to be true to evaluate solution sensitivities wrt. global parameters.\n");
+        exit(1);
+    }
+    if (strcmp("p_global", field))
+    {
+        printf("\nerror: field %s not available in ocp_nlp_common_eval_solution_sens_adj_p_block\n", field);
+        exit(1);
+    }
+
+    int N = dims->N;
+    int *nv = dims->nv;
+
+    ocp_qp_seed *qp_seed = work->qp_seed;
+    ocp_qp_out *tmp_qp_out = work->tmp_qp_out;
+    d_ocp_qp_seed_set_zero(qp_seed);
+
+    for (int k = 0; k < n_dir; k++)
+    {
+        // only seed_g is set, it is overwritten for every direction
+        double *col = seed + k*ld_seed;
+        for (int i = 0; i <= N; i++)
+        {
+            blasfeo_pack_dvec(nv[i], col, 1, qp_seed->seed_g + i, 0);
+            col += nv[i];
+        }
+
+        config->qp_solver->eval_adj_sens(config->qp_solver, dims->qp_solver, mem->qp_in, qp_seed, tmp_qp_out,
+                                opts->qp_solver_opts, mem->qp_solver_mem, work->qp_work);
+
+        ocp_nlp_common_adj_p_global_from_qp_out(config, dims, in, opts, mem, work, tmp_qp_out, grad_p + k*ld_grad);
+    }
+
+    mem->nlp_timings->time_solution_sensitivities = acados_profiler_span_end(mem->profiler, &span, ACADOS_PROFILER_SENS, -1, mem->iter);
 }
 
 
@@ -4383,7 +4984,7 @@ int ocp_nlp_solve_qp_and_correct_dual(ocp_nlp_config *config, ocp_nlp_dims *dims
                      bool precondensed_lhs, ocp_qp_in *scaled_qp_in_, ocp_qp_in *qp_in_, ocp_qp_out *scaled_qp_out_, ocp_qp_out *qp_out_,
                      ocp_qp_xcond_solver *xcond_solver)
 {
-    acados_timer timer;
+    acados_profiler_span span;
 
     // xcond_solver is "optional", if NULL is given use stuff from nlp_dims, mem etc.
     ocp_qp_xcond_solver_config *qp_solver;
@@ -4452,6 +5053,7 @@ int ocp_nlp_solve_qp_and_correct_dual(ocp_nlp_config *config, ocp_nlp_dims *dims
     ocp_nlp_regularize_set_qp_out_ptrs(config->regularize, dims->regularize, nlp_mem->regularize_mem, scaled_qp_out);
 
     ocp_nlp_timings *nlp_timings = nlp_mem->nlp_timings;
+    acados_profiler *prof = nlp_mem->profiler;
 
     double tmp_time;
     int qp_status;
@@ -4511,7 +5113,7 @@ int ocp_nlp_solve_qp_and_correct_dual(ocp_nlp_config *config, ocp_nlp_dims *dims
     }
 
     // solve qp
-    acados_tic(&timer);
+    acados_profiler_span_start(prof, &span);
     if (precondensed_lhs)
     {
         qp_status = qp_solver->condense_rhs_and_solve(qp_solver, qp_dims,
@@ -4522,8 +5124,50 @@ int ocp_nlp_solve_qp_and_correct_dual(ocp_nlp_config *config, ocp_nlp_dims *dims
         qp_status = qp_solver->evaluate(qp_solver, qp_dims,
                 scaled_qp_in, scaled_qp_out, qp_opts, qp_mem, qp_work);
     }
+
+    // safeguard for inexact QP solutions: at an NLP feasible iterate, the step of an exactly solved,
+    // convex QP is a descent direction for the objective. If the inexact step is not,
+    // the QP is solved again with the tolerances ADAPTIVE_CURRENT_RES_JOINT uses close to the solution.
+    if (nlp_opts->nlp_qp_tol_strategy == ADAPTIVE_CURRENT_RES_JOINT && nlp_opts->nlp_qp_tol_safeguard &&
+        (qp_status == ACADOS_SUCCESS || qp_status == ACADOS_MAXITER) &&
+        nlp_mem->nlp_res->inf_norm_res_eq <= nlp_opts->tol_eq &&
+        nlp_mem->nlp_res->inf_norm_res_ineq <= nlp_opts->tol_ineq &&
+        ocp_nlp_compute_gradient_directional_derivative(dims, scaled_qp_in, scaled_qp_out) > 0.0)
+    {
+        double tmp_tol_stat = MAX(nlp_opts->nlp_qp_tol_safety_factor * nlp_opts->tol_stat, nlp_opts->nlp_qp_tol_min_stat);
+        double tmp_tol_eq = MAX(nlp_opts->nlp_qp_tol_safety_factor * nlp_opts->tol_eq, nlp_opts->nlp_qp_tol_min_eq);
+        double tmp_tol_ineq = MAX(nlp_opts->nlp_qp_tol_safety_factor * nlp_opts->tol_ineq, nlp_opts->nlp_qp_tol_min_ineq);
+        double tmp_tol_comp = MAX(nlp_opts->nlp_qp_tol_safety_factor * nlp_opts->tol_comp, nlp_opts->nlp_qp_tol_min_comp);
+        qp_solver->opts_set(qp_solver, qp_opts, "tol_stat", &tmp_tol_stat);
+        qp_solver->opts_set(qp_solver, qp_opts, "tol_eq", &tmp_tol_eq);
+        qp_solver->opts_set(qp_solver, qp_opts, "tol_ineq", &tmp_tol_ineq);
+        qp_solver->opts_set(qp_solver, qp_opts, "tol_comp", &tmp_tol_comp);
+
+        // account for the timings of the discarded solve
+        qp_solver->memory_get(qp_solver, qp_mem, "time_qp_solver_call", &tmp_time);
+        nlp_timings->time_qp_solver_call += tmp_time;
+        qp_solver->memory_get(qp_solver, qp_mem, "time_qp_xcond", &tmp_time);
+        nlp_timings->time_qp_xcond += tmp_time;
+
+        if (nlp_opts->print_level > 1)
+        {
+            printf("ocp_nlp_solve_qp_and_correct_dual: inexact QP step is not a descent direction, resolving with tight tolerances.\n");
+        }
+        nlp_mem->qp_num_resolves++;
+
+        if (precondensed_lhs)
+        {
+            qp_status = qp_solver->condense_rhs_and_solve(qp_solver, qp_dims,
+                    scaled_qp_in, scaled_qp_out, qp_opts, qp_mem, qp_work);
+        }
+        else
+        {
+            qp_status = qp_solver->evaluate(qp_solver, qp_dims,
+                    scaled_qp_in, scaled_qp_out, qp_opts, qp_mem, qp_work);
+        }
+    }
     // add qp timings
-    nlp_timings->time_qp_sol += acados_toc(&timer);
+    nlp_timings->time_qp_sol += acados_profiler_span_end(prof, &span, ACADOS_PROFILER_QP, -1, nlp_mem->iter);
     // NOTE: timings within qp solver are added internally (lhs+rhs)
     qp_solver->memory_get(qp_solver, qp_mem, "time_qp_solver_call", &tmp_time);
     nlp_timings->time_qp_solver_call += tmp_time;
@@ -4542,14 +5186,14 @@ int ocp_nlp_solve_qp_and_correct_dual(ocp_nlp_config *config, ocp_nlp_dims *dims
     }
 
     // compute correct dual solution in case of Hessian regularization
-    acados_tic(&timer);
+    acados_profiler_span_start(prof, &span);
     config->regularize->correct_dual_sol(config->regularize, dims->regularize,
                                             nlp_opts->regularize, nlp_mem->regularize_mem);
-    nlp_timings->time_reg += acados_toc(&timer);
+    nlp_timings->time_reg += acados_profiler_span_end(prof, &span, ACADOS_PROFILER_REG, -1, nlp_mem->iter);
 
-    acados_tic(&timer);
+    acados_profiler_span_start(prof, &span);
     ocp_nlp_qpscaling_rescale_solution(dims->qpscaling, nlp_opts->qpscaling, nlp_mem->qpscaling, qp_in, qp_out);
-    nlp_timings->time_qpscaling += acados_toc(&timer);
+    nlp_timings->time_qpscaling += acados_profiler_span_end(prof, &span, ACADOS_PROFILER_QPSCALING, -1, nlp_mem->iter);
 
     // reset regularize pointers if necessary // TODO: check how to do this best with qpscaling
     if (scaled_qp_in_ != NULL)
@@ -4571,7 +5215,7 @@ int ocp_nlp_solve_qp(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_opts *n
                      ocp_qp_in *qp_in_, ocp_qp_out *qp_out_,
                      ocp_qp_xcond_solver *xcond_solver)
 {
-    acados_timer timer;
+    acados_profiler_span span;
 
     ocp_qp_xcond_solver_config *qp_solver = xcond_solver->config;
     ocp_qp_xcond_solver_dims *qp_dims = xcond_solver->dims;
@@ -4588,11 +5232,11 @@ int ocp_nlp_solve_qp(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_opts *n
     int qp_status;
 
     // solve qp
-    acados_tic(&timer);
+    acados_profiler_span_start(nlp_mem->profiler, &span);
     qp_status = qp_solver->evaluate(qp_solver, qp_dims,
                 qp_in, qp_out, qp_opts, qp_mem, qp_work);
     // add qp timings
-    nlp_timings->time_qp_sol += acados_toc(&timer);
+    nlp_timings->time_qp_sol += acados_profiler_span_end(nlp_mem->profiler, &span, ACADOS_PROFILER_QP, -1, nlp_mem->iter);
     // NOTE: timings within qp solver are added internally (lhs+rhs)
     qp_solver->memory_get(qp_solver, qp_mem, "time_qp_solver_call", &tmp_time);
     nlp_timings->time_qp_solver_call += tmp_time;
@@ -4631,6 +5275,51 @@ void ocp_nlp_dump_qp_out_to_file(ocp_qp_out *qp_out, int sqp_iter, int soc)
 }
 
 
+void ocp_nlp_latency_record(ocp_nlp_opts *opts, ocp_nlp_memory *mem, ocp_nlp_latency_field field, double value)
+{
+    if (mem->latency_hist == NULL)
+        return;
+    // the deadline bounds the time until the control is available, i.e. the total or the feedback time
+    double deadline = (field == LATENCY_TIME_TOT || field == LATENCY_TIME_FEEDBACK) ? opts->latency_deadline : 0.0;
+    acados_latency_histogram_record(mem->latency_hist+field, value, deadline);
+}
+
+
+void ocp_nlp_latency_reset(ocp_nlp_memory *mem)
+{
+    if (mem->latency_hist == NULL)
+        return;
+    for (int i = 0; i < LATENCY_NUM_FIELDS; i++)
+        acados_latency_histogram_reset(mem->latency_hist+i);
+}
+
+
+
+int ocp_nlp_profiler_write(ocp_nlp_memory *mem, const char *filename, const char *format)
+{
+    if (mem->profiler == NULL)
+    {
+        printf("\nocp_nlp_profiler_write: profiling is disabled, set profiler_buffer_size > 0.\n");
+        return ACADOS_UNKNOWN;
+    }
+
+    if (!strcmp(format, "json"))
+    {
+        return acados_profiler_write_chrome_trace(mem->profiler, filename);
+    }
+    else if (!strcmp(format, "binary"))
+    {
+        return acados_profiler_write_binary(mem->profiler, filename);
+    }
+    else
+    {
+        printf("\nocp_nlp_profiler_write: format %s not supported, use json or binary.\n", format);
+        return ACADOS_UNKNOWN;
+    }
+}
+
+
+
 void ocp_nlp_common_print_iteration_header()
 {
     printf("%6s   %10s   %10s   %10s   %10s   ", "# it", "res_stat", "res_eq", "res_ineq", "res_comp");
@@ -4776,6 +5465,16 @@ void ocp_nlp_memory_get(ocp_nlp_config *config, ocp_nlp_memory *nlp_mem, const c
         config->qp_solver->memory_get(config->qp_solver,
             nlp_mem->qp_solver_mem, "tau_iter", return_value_);
     }
+    else if (!strcmp("qp_num_refactorizations", field))
+    {
+        config->qp_solver->memory_get(config->qp_solver,
+            nlp_mem->qp_solver_mem, "num_refactorizations", return_value_);
+    }
+    else if (!strcmp("qp_num_resolves", field))
+    {
+        int *value = return_value_;
+        *value = nlp_mem->qp_num_resolves;
+    }
     else if (!strcmp("qpscaling_status", field))
     {
         ocp_nlp_qpscaling_memory_get(NULL, nlp_mem->qpscaling, "status", 0, return_value_);
@@ -4837,6 +5536,25 @@ void ocp_nlp_memory_get(ocp_nlp_config *config, ocp_nlp_memory *nlp_mem, const c
             }
         }
     }
+    else if (!strcmp("latency_time_tot", field) || !strcmp("latency_time_feedback", field) ||
+             !strcmp("latency_time_preparation", field) || !strcmp("latency_time_qp_solver_call", field))
+    {
+        // count, mean, p50, p99, p99.9, max, number of deadline misses
+        if (nlp_mem->latency_hist == NULL)
+        {
+            printf("\nerror: options log_latency was not set\n");
+            exit(1);
+        }
+        ocp_nlp_latency_field latency_field = LATENCY_TIME_TOT;
+        if (!strcmp("latency_time_feedback", field))
+            latency_field = LATENCY_TIME_FEEDBACK;
+        else if (!strcmp("latency_time_preparation", field))
+            latency_field = LATENCY_TIME_PREPARATION;
+        else if (!strcmp("latency_time_qp_solver_call", field))
+            latency_field = LATENCY_TIME_QP_SOLVER_CALL;
+        double *value = return_value_;
+        acados_latency_histogram_summary(nlp_mem->latency_hist+latency_field, value);
+    }
     else
     {
         printf("\nerror: field %s not available in ocp_nlp_memory_get\n", field);
@@ -64,6 +64,8 @@ extern "C" {
 #include "acados/ocp_qp/ocp_qp_xcond_solver.h"
 #include "acados/sim/sim_common.h"
 #include "acados/utils/external_function_generic.h"
+#include "acados/utils/latency_histogram.h"
+#include "acados/utils/profiler.h"
 #include "acados/utils/types.h"
 
 
@@ -320,6 +322,8 @@ typedef struct ocp_nlp_opts
     int fixed_hess;
     int log_primal_step_norm; // compute and log the max norm of the primal steps
     int log_dual_step_norm; // compute and log the max norm of the dual steps
+    int log_latency; // accumulate histograms of the computation times across solver calls
+    double latency_deadline; // total and feedback times above this value are counted as deadline misses, 0 to disable
     int max_iter; // maximum number of (SQP/DDP) iterations
     int qp_iter_max; // maximum iter of QP solver, stored to remember.
     double tau_min;  // minimum value of the barrier parameter, for IPMs
@@ -345,14 +349,19 @@ typedef struct ocp_nlp_opts
     double nlp_qp_tol_min_eq;
     double nlp_qp_tol_min_ineq;
     double nlp_qp_tol_min_comp;
+    bool nlp_qp_tol_safeguard; // resolve inexact QPs with tight tolerances if the step is not a descent direction
 
     bool warm_start_first_qp; // to set qp_warm_start in first iteration
     bool warm_start_first_qp_from_nlp;  // if True first QP will be initialized using values from NLP iterate, otherwise from previous QP solution.
     bool eval_residual_at_max_iter; // if convergence should be checked after last iterations or only throw max_iter reached
     bool store_iterates; // flag indicating whether intermediate iterates should be stored
+    int profiler_buffer_size; // number of profiler events kept across solver calls, 0 disables profiling
+    bool alloc_hugepages; // back the solver memory and workspace by huge pages (Linux)
+    bool minimal_memory; // only allocate buffers required by the selected options, possibly aliasing QP data
 
     bool with_anderson_acceleration;
     double anderson_activation_threshold;
+    int anderson_depth; // number of stored step differences
 
     // termination tolerances
     double tol_stat;     // exit tolerance on stationarity condition
@@ -433,6 +442,16 @@ void ocp_nlp_timings_get(ocp_nlp_config *config, ocp_nlp_timings *timings, const
 void ocp_nlp_timings_reset(ocp_nlp_timings *timings);
 
 
+typedef enum
+{
+    LATENCY_TIME_TOT,
+    LATENCY_TIME_FEEDBACK,
+    LATENCY_TIME_PREPARATION,
+    LATENCY_TIME_QP_SOLVER_CALL,
+    LATENCY_NUM_FIELDS,
+} ocp_nlp_latency_field;
+
+
 /************************************************
  * memory
  ************************************************/
@@ -456,6 +475,7 @@ typedef struct ocp_nlp_memory
 
     // timings
     ocp_nlp_timings *nlp_timings;
+    acados_profiler *profiler; // NULL if profiling is disabled
 
     // qp in & out
     ocp_qp_in *qp_in;
@@ -468,6 +488,15 @@ typedef struct ocp_nlp_memory
     // for Anderson acceleration
     ocp_qp_out *prev_qp_out;
     ocp_qp_out *anderson_step;
+    ocp_qp_out **anderson_dx; // history of previous steps, circular buffer of size anderson_depth
+    ocp_qp_out **anderson_dd; // history of QP step differences, circular buffer of size anderson_depth
+    ocp_qp_out **anderson_q; // orthonormalized anderson_dd, newest first
+    double *anderson_qr_r; // upper triangular factor of the QR factorization of anderson_dd, newest first
+    double *anderson_rhs;
+    double *anderson_gamma;
+    double *anderson_stage_dot; // stage-wise partial inner products
+    int anderson_len;
+    int anderson_next;
 
     // QP stuff not entering the qp_in struct
     struct blasfeo_dmat *dzduxt; // dzdux transposed
@@ -484,6 +513,7 @@ typedef struct ocp_nlp_memory
     struct blasfeo_dmat *jac_ineq_p_global;  // jacobian of nonlinear inequalities wrt p_global (ni_nl, np_global)
     struct blasfeo_dmat *jac_dyn_p_global;  // jacobian of dynamics wrt p_global (nx_next, np_global)
     struct blasfeo_dvec out_np_global;
+    struct blasfeo_dvec *adj_p_global_stage;  // per stage contributions to the adjoint sensitivities wrt p_global
 
     double cost_value;
     double qp_cost_value;
@@ -491,9 +521,11 @@ typedef struct ocp_nlp_memory
     double predicted_optimality_reduction; // // used for funnel globalization
     double objective_multiplier; // used for funnel globalization
     int compute_hess;
+    bool fun_at_iterate_valid; // dyn_fun, ineq_fun and cost_value hold the function values at nlp_out
 
     int status;
     int iter;
+    int qp_num_resolves; // QPs solved again by nlp_qp_tol_safeguard in the last NLP solver call
 
     double adaptive_levenberg_marquardt_mu;
     double adaptive_levenberg_marquardt_mu_bar;
@@ -501,6 +533,7 @@ typedef struct ocp_nlp_memory
     bool *set_sim_guess; // indicate if there is new explicitly provided guess for integration variables
     double *primal_step_norm;
     double *dual_step_norm;
+    acados_latency_histogram *latency_hist; // LATENCY_NUM_FIELDS histograms, NULL if log_latency is not set
 
     struct blasfeo_dvec *sim_guess;
     acados_size_t workspace_size;
@@ -557,6 +590,8 @@ typedef struct ocp_nlp_workspace
 
 //
 acados_size_t ocp_nlp_workspace_calculate_size(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_opts *opts, ocp_nlp_in *nlp_in);
+/** Returns the bytes of memory and workspace required by a submodule, stage is only used for dynamics, cost and constraints. */
+acados_size_t ocp_nlp_memory_footprint(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_opts *opts, ocp_nlp_in *nlp_in, const char *module, int stage);
 //
 ocp_nlp_workspace *ocp_nlp_workspace_assign(ocp_nlp_config *config, ocp_nlp_dims *dims,
                                 ocp_nlp_opts *opts, ocp_nlp_in *nlp_in, ocp_nlp_memory *mem, void *raw_memory);
@@ -597,7 +632,7 @@ void ocp_nlp_update_variables_sqp(void *config_, void *dims_,
 void ocp_nlp_convert_primaldelta_absdual_step_to_delta_step(ocp_nlp_config *config, ocp_nlp_dims *dims,
         ocp_nlp_out *out, ocp_qp_out *step);
 //
-double ocp_nlp_compute_anderson_gamma(ocp_nlp_workspace *work, ocp_qp_out *new_qp_step, ocp_qp_out *new_minus_old_qp_step);
+void ocp_nlp_compute_anderson_step(ocp_nlp_opts *opts, ocp_nlp_memory *mem, ocp_qp_out *qp_step, double alpha);
 //
 int ocp_nlp_precompute_common(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_in *in,
             ocp_nlp_out *out, ocp_nlp_opts *opts, ocp_nlp_memory *mem, ocp_nlp_workspace *work);
@@ -633,6 +668,10 @@ void ocp_nlp_common_eval_param_sens(ocp_nlp_config *config, ocp_nlp_dims *dims,
                         ocp_nlp_opts *opts, ocp_nlp_memory *mem, ocp_nlp_workspace *work,
                         char *field, int stage, int index, ocp_nlp_out *sens_nlp_out);
 //
+void ocp_nlp_common_eval_param_sens_block(ocp_nlp_config *config, ocp_nlp_dims *dims,
+                        ocp_nlp_opts *opts, ocp_nlp_memory *mem, ocp_nlp_workspace *work,
+                        char *field, int stage, int index, int n_dir, double *sens, int ld_sens);
+//
 void ocp_nlp_common_eval_lagr_grad_p(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_in *in,
                         ocp_nlp_opts *opts, ocp_nlp_memory *mem, ocp_nlp_workspace *work,
                         const char *field, void *grad_p);
@@ -641,6 +680,10 @@ void ocp_nlp_common_eval_solution_sens_adj_p(ocp_nlp_config *config, ocp_nlp_dim
                         ocp_nlp_opts *opts, ocp_nlp_memory *mem, ocp_nlp_workspace *work,
                         ocp_nlp_out *sens_nlp_out, const char *field, int stage, void *grad_p);
 //
+void ocp_nlp_common_eval_solution_sens_adj_p_block(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_in *in,
+                        ocp_nlp_opts *opts, ocp_nlp_memory *mem, ocp_nlp_workspace *work,
+                        const char *field, int n_dir, double *seed, int ld_seed, double *grad_p, int ld_grad);
+//
 void ocp_nlp_add_levenberg_marquardt_term(ocp_nlp_config *config, ocp_nlp_dims *dims,
     ocp_nlp_in *in, ocp_nlp_out *out, ocp_nlp_opts *opts, ocp_nlp_memory *mem,
     ocp_nlp_workspace *work, double alpha, int iter, ocp_qp_in *qp_in);
@@ -675,6 +718,12 @@ void ocp_nlp_dump_qp_out_to_file(ocp_qp_out *qp_out, int sqp_iter, int soc);
 void ocp_nlp_dump_qp_in_to_file(ocp_qp_in *qp_in, int sqp_iter, int soc);
 void ocp_nlp_common_print_iteration_header();
 void ocp_nlp_common_print_iteration(int iter_count, ocp_nlp_res *nlp_res);
+//
+int ocp_nlp_profiler_write(ocp_nlp_memory *mem, const char *filename, const char *format);
+//
+void ocp_nlp_latency_record(ocp_nlp_opts *opts, ocp_nlp_memory *mem, ocp_nlp_latency_field field, double value);
+//
+void ocp_nlp_latency_reset(ocp_nlp_memory *mem);
 
 void ocp_nlp_update_variables_sqp_delta_primal_dual(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_in *in,
             ocp_nlp_out *out, ocp_nlp_opts *opts, ocp_nlp_memory *mem, ocp_nlp_workspace *work, double alpha, ocp_qp_out *step);
@@ -109,6 +109,8 @@ void ocp_nlp_ddp_opts_initialize_default(void *config_, void *dims_, void *opts_
 
     // DDP opts
     opts->nlp_opts->max_iter = 20;
+    opts->num_segments = 1;
+    opts->defect_closing = DDP_DEFECT_CLOSING_GRADUAL;
 
     return;
 }
@@ -147,7 +149,30 @@ void ocp_nlp_ddp_opts_set(void *config_, void *opts_, const char *field, void* v
     }
     else // nlp opts
     {
-        ocp_nlp_opts_set(config, nlp_opts, field, value);
+        if (!strcmp(field, "ddp_num_segments"))
+        {
+            int* num_segments = (int *) value;
+            if (*num_segments < 1)
+            {
+                printf("\nerror: ocp_nlp_ddp_opts_set: invalid value for ddp_num_segments field, need int >= 1, got %d.\n", *num_segments);
+                exit(1);
+            }
+            opts->num_segments = *num_segments;
+        }
+        else if (!strcmp(field, "ddp_defect_closing"))
+        {
+            int* defect_closing = (int *) value;
+            if (*defect_closing != DDP_DEFECT_CLOSING_GRADUAL && *defect_closing != DDP_DEFECT_CLOSING_MERGE)
+            {
+                printf("\nerror: ocp_nlp_ddp_opts_set: invalid value for ddp_defect_closing field, got %d.\n", *defect_closing);
+                exit(1);
+            }
+            opts->defect_closing = *defect_closing;
+        }
+        else
+        {
+            ocp_nlp_opts_set(config, nlp_opts, field, value);
+        }
     }
 
     return;
@@ -207,7 +232,20 @@ acados_size_t ocp_nlp_ddp_memory_calculate_size(void *config_, void *dims_, void
         nx_max = nx_max > nx[i] ? nx_max : nx[i];
     }
 
-    size += 1*blasfeo_memsize_dmat(nu_max, nx_max); // K_mat
+    size += N*sizeof(struct blasfeo_dmat); // K_mat
+    size += N*sizeof(struct blasfeo_dvec); // k_vec
+    size += (N+1)*sizeof(struct blasfeo_dvec); // dx
+    size += N*sizeof(struct blasfeo_dvec); // x_end
+    for (int i = 0; i < N; i++)
+    {
+        size += blasfeo_memsize_dmat(nu[i], nx[i]); // K_mat
+        size += blasfeo_memsize_dvec(nu[i]); // k_vec
+        size += blasfeo_memsize_dvec(nx[i+1]); // x_end
+    }
+    for (int i = 0; i <= N; i++)
+    {
+        size += blasfeo_memsize_dvec(nx[i]); // dx
+    }
     size += nu_max * nx_max * sizeof(double); // tmp_nu_times_nx
 
     size += 3*8;  // align
@@ -246,10 +284,6 @@ void *ocp_nlp_ddp_memory_assign(void *config_, void *dims_, void *opts_, void *i
     mem->nlp_mem = ocp_nlp_memory_assign(config, dims, nlp_opts, in, c_ptr);
     c_ptr += ocp_nlp_memory_calculate_size(config, dims, nlp_opts, in);
 
-    // blasfeo_mem align
-    align_char_to(64, &c_ptr);
-
-    // dzduxt
     int nu_max = 0;
     int nx_max = 0;
     for (int i = 0; i <= N; i++)
@@ -257,7 +291,33 @@ void *ocp_nlp_ddp_memory_assign(void *config_, void *dims_, void *opts_, void *i
         nu_max = nu_max > nu[i] ? nu_max : nu[i];
         nx_max = nx_max > nx[i] ? nx_max : nx[i];
     }
-    assign_and_advance_blasfeo_dmat_mem(nu_max, nx_max, &mem->K_mat, &c_ptr);
+
+    // blasfeo structs
+    assign_and_advance_blasfeo_dmat_structs(N, &mem->K_mat, &c_ptr);
+    assign_and_advance_blasfeo_dvec_structs(N, &mem->k_vec, &c_ptr);
+    assign_and_advance_blasfeo_dvec_structs(N + 1, &mem->dx, &c_ptr);
+    assign_and_advance_blasfeo_dvec_structs(N, &mem->x_end, &c_ptr);
+
+    // blasfeo_mem align
+    align_char_to(64, &c_ptr);
+
+    // K_mat, k_vec, dx, x_end
+    for (int i = 0; i < N; i++)
+    {
+        assign_and_advance_blasfeo_dmat_mem(nu[i], nx[i], mem->K_mat + i, &c_ptr);
+    }
+    for (int i = 0; i < N; i++)
+    {
+        assign_and_advance_blasfeo_dvec_mem(nu[i], mem->k_vec + i, &c_ptr);
+    }
+    for (int i = 0; i <= N; i++)
+    {
+        assign_and_advance_blasfeo_dvec_mem(nx[i], mem->dx + i, &c_ptr);
+    }
+    for (int i = 0; i < N; i++)
+    {
+        assign_and_advance_blasfeo_dvec_mem(nx[i+1], mem->x_end + i, &c_ptr);
+    }
 
     // stat
     mem->stat = (double *) c_ptr;
@@ -271,6 +331,8 @@ void *ocp_nlp_ddp_memory_assign(void *config_, void *dims_, void *opts_, void *i
     mem->tmp_nu_times_nx = (double *) c_ptr;
     c_ptr += nu_max*nx_max*sizeof(double);
 
+    mem->num_segments = 1;
+
     mem->nlp_mem->status = ACADOS_READY;
 
     align_char_to(8, &c_ptr);
@@ -331,6 +393,72 @@ static void ocp_nlp_ddp_cast_workspace(ocp_nlp_config *config, ocp_nlp_dims *dim
  * Helper functions
  ************************************************/
 
+static void ocp_nlp_ddp_get_feedback_gains(ocp_nlp_config *config, ocp_nlp_dims *dims,
+            ocp_nlp_opts *opts, ocp_nlp_memory *mem, ocp_nlp_ddp_memory *ddp_mem)
+{
+    // gains of the Riccati recursion of the QP solver, extracted once per QP solution
+    int N = dims->N;
+    int *nx = dims->nx;
+    int *nu = dims->nu;
+    ocp_qp_xcond_solver_config *xcond_solver_config = config->qp_solver;
+
+    for (int i = 0; i < N; i++)
+    {
+        xcond_solver_config->solver_get(xcond_solver_config, mem->qp_in, mem->qp_out, opts->qp_solver_opts, mem->qp_solver_mem, "K", i, ddp_mem->tmp_nu_times_nx, nu[i], nx[i]);
+        blasfeo_pack_dmat(nu[i], nx[i], ddp_mem->tmp_nu_times_nx, nu[i], ddp_mem->K_mat+i, 0, 0);
+
+        xcond_solver_config->solver_get(xcond_solver_config, mem->qp_in, mem->qp_out, opts->qp_solver_opts, mem->qp_solver_mem, "k", i, ddp_mem->tmp_nu_times_nx, nu[i], 1);
+        blasfeo_pack_dvec(nu[i], ddp_mem->tmp_nu_times_nx, 1, ddp_mem->k_vec+i, 0);
+    }
+}
+
+
+
+static void ocp_nlp_ddp_rollout_segment(ocp_nlp_config *config, ocp_nlp_dims *dims,
+            ocp_nlp_in *in, ocp_nlp_out *out, ocp_qp_out *qp_out, ocp_nlp_opts *opts, ocp_nlp_memory *mem,
+            ocp_nlp_workspace *work, ocp_nlp_ddp_memory *ddp_mem, ocp_nlp_out *out_destination,
+            double alpha, int i_start, int i_end)
+{
+    int N = dims->N;
+    int *nx = dims->nx;
+    int *nu = dims->nu;
+    struct blasfeo_dvec *tmp_vec;
+
+    // x at segment start: linear prediction of the QP,
+    // the defect to the previous segment is thereby closed at rate alpha
+    blasfeo_daxpy(nx[i_start], alpha, qp_out->ux + i_start, nu[i_start],
+                out->ux + i_start, nu[i_start], out_destination->ux + i_start, nu[i_start]);
+
+    for (int i = i_start; i < i_end; i++)
+    {
+        /* u_i = \bar{u}_i + alpha * k_i + K_i * (x_i - \bar{x}_i) */
+        blasfeo_daxpby(nx[i], -1.0, out->ux+i, nu[i], 1.0, out_destination->ux+i, nu[i], ddp_mem->dx+i, 0);
+        blasfeo_dgemv_n(nu[i], nx[i], 1.0, ddp_mem->K_mat+i, 0, 0, ddp_mem->dx+i, 0, alpha, ddp_mem->k_vec+i, 0, out_destination->ux+i, 0);
+        blasfeo_daxpy(nu[i], 1.0, out->ux+i, 0, out_destination->ux+i, 0, out_destination->ux+i, 0);
+
+        // x_{i+1} = f_dyn_i(x_i, u_i)
+        config->dynamics[i]->memory_set_ux_ptr(out_destination->ux+i, mem->dynamics[i]);
+        config->dynamics[i]->compute_fun(config->dynamics[i], dims->dynamics[i],
+            in->dynamics[i], opts->dynamics[i], mem->dynamics[i], work->dynamics[i]);
+        config->dynamics[i]->memory_set_ux_ptr(out->ux+i, mem->dynamics[i]);
+
+        // f_dyn_i(x_i, u_i) - x_{i+1}
+        // NOTE/TODO: store function output in dynamics module instead?
+        tmp_vec = config->dynamics[i]->memory_get_fun_ptr(mem->dynamics[i]);
+        if (i+1 < i_end || i_end == N)
+        {
+            blasfeo_daxpby(nx[i+1], 1.0, tmp_vec, 0, 1.0, out->ux+i+1, nu[i+1], out_destination->ux+i+1, nu[i+1]);
+        }
+        else
+        {
+            // the next segment starts from the linear prediction, keep the end state for the defect
+            blasfeo_daxpby(nx[i+1], 1.0, tmp_vec, 0, 1.0, out->ux+i+1, nu[i+1], ddp_mem->x_end+i, 0);
+        }
+    }
+}
+
+
+
 void ocp_nlp_ddp_compute_trial_iterate(void *config_, void *dims_,
             void *in_, void *out_, void *qp_out_, void *opts_, void *mem_,
             void *work_, void *out_destination_,
@@ -348,55 +476,31 @@ void ocp_nlp_ddp_compute_trial_iterate(void *config_, void *dims_,
     ocp_nlp_ddp_memory *ddp_mem = solver_mem;
     /* computes trial iterate in tmp_nlp_out */
     int N = dims->N;
-    // int *nv = dims->nv;
     int *nx = dims->nx;
     int *nu = dims->nu;
     int *ni = dims->ni;
     int *nz = dims->nz;
 
     ocp_nlp_globalization_opts *globalization_opts = opts->globalization;
-    struct blasfeo_dvec *tmp_vec;
-    ocp_qp_xcond_solver_config *xcond_solver_config = config->qp_solver;
 
-    // compute x_0
-    int i = 0;
-    blasfeo_daxpy(nx[i], alpha, qp_out->ux + i, nu[i],
-                out->ux + i, nu[i], out_destination->ux + i, nu[i]);
-
-    // compute u_i, x_{i+1}
-    for (i = 0; i < N; i++)
+    // forward rollout, each shooting segment is started from the linear prediction of the QP
+    int num_segments = ddp_mem->num_segments;
+    int segment_length = (N + num_segments - 1) / num_segments;
+#if defined(ACADOS_WITH_OPENMP)
+    #pragma omp parallel for
+#endif
+    for (int s = 0; s < num_segments; s++)
     {
-        /* step in primal variables */
-        // compute u   // (if i < N?)
-        /* u_i = \bar{u}_i + alpha * k_i + K_i * (x_i - \bar{x}_i) */
-        // get K
-        xcond_solver_config->solver_get(xcond_solver_config, mem->qp_in, qp_out, opts->qp_solver_opts, mem->qp_solver_mem, "K", i, ddp_mem->tmp_nu_times_nx, nu[i], nx[i]);
-        blasfeo_pack_dmat(nu[i], nx[i], ddp_mem->tmp_nu_times_nx, nu[i], &ddp_mem->K_mat, 0, 0);
-
-        // get k = tmp_nv;
-        xcond_solver_config->solver_get(xcond_solver_config, mem->qp_in, qp_out, opts->qp_solver_opts, mem->qp_solver_mem, "k", i, work->tmp_nv_double, nu[i], 1);
-        blasfeo_pack_dvec(nu[i], work->tmp_nv_double, 1, &work->tmp_nv, 0);
-
-        // compute delta_u = alpha * k_i + K_i * (x_i - \bar{x}_i)
-        // tmp_nv[nu:] = (x_i - \bar{x}_i)
-        blasfeo_daxpby(nx[i], -1.0, out->ux+i, nu[i], 1.0, out_destination->ux+i, nu[i], &work->tmp_nv, nu[i]);
-        blasfeo_dgemv_n(nu[i], nx[i], 1.0, &ddp_mem->K_mat, 0, 0, &work->tmp_nv, nu[i], alpha, &work->tmp_nv, 0, &work->tmp_nv, 0);
-        blasfeo_daxpby(nu[i], 1.0, out->ux+i, 0, 1.0, &work->tmp_nv, 0, out_destination->ux+i, 0);
-
-        // evalutate dynamics
-        // x_{i+1} = f_dyn_i(x_i, u_i)
-        config->dynamics[i]->memory_set_ux_ptr(out_destination->ux+i, mem->dynamics[i]);
-        config->dynamics[i]->compute_fun(config->dynamics[i], dims->dynamics[i],
-            in->dynamics[i], opts->dynamics[i], mem->dynamics[i], work->dynamics[i]);
-        config->dynamics[i]->memory_set_ux_ptr(out->ux+i, mem->dynamics[i]);
-
-        // f_dyn_i(x_i, u_i) - x_{i+1}
-        // NOTE/TODO: store function output in dynamics module instead?
-        tmp_vec = config->dynamics[i]->memory_get_fun_ptr(mem->dynamics[i]);
-        blasfeo_daxpby(nx[i+1], 1.0, tmp_vec, 0, 1.0, out->ux+i+1, nu[i+1], out_destination->ux+i+1, nu[i+1]);
+        int i_start = s * segment_length;
+        int i_end = i_start + segment_length < N ? i_start + segment_length : N;
+        if (i_start < N)
+        {
+            ocp_nlp_ddp_rollout_segment(config, dims, in, out, qp_out, opts, mem, work, ddp_mem,
+                                        out_destination, alpha, i_start, i_end);
+        }
     }
 
-    for (i = 0; i < N+1; i++)
+    for (int i = 0; i < N+1; i++)
     {
         // update dual variables
         if (globalization_opts->full_step_dual)
@@ -430,6 +534,29 @@ void ocp_nlp_ddp_compute_trial_iterate(void *config_, void *dims_,
     return;
 }
 
+double ocp_nlp_ddp_compute_segment_defect(ocp_nlp_dims *dims, ocp_nlp_ddp_memory *mem,
+            ocp_nlp_out *trial_out, ocp_nlp_out *weight_merit_fun)
+{
+    // weighted l1 norm of the defects between the shooting segments of the last rollout
+    int N = dims->N;
+    int *nx = dims->nx;
+    int *nu = dims->nu;
+    int segment_length = (N + mem->num_segments - 1) / mem->num_segments;
+    double defect = 0.0;
+
+    for (int i = segment_length; i < N; i += segment_length)
+    {
+        for (int j = 0; j < nx[i]; j++)
+        {
+            defect += BLASFEO_DVECEL(weight_merit_fun->pi+i-1, j) *
+                      fabs(BLASFEO_DVECEL(mem->x_end+i-1, j) - BLASFEO_DVECEL(trial_out->ux+i, nu[i]+j));
+        }
+    }
+    return defect;
+}
+
+
+
 /************************************************
  * termination criterion
  ************************************************/
@@ -548,9 +675,6 @@ static void print_iteration(int iter, ocp_nlp_config *config, ocp_nlp_res *nlp_r
 int ocp_nlp_ddp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
                 void *opts_, void *mem_, void *work_)
 {
-    acados_timer timer0, timer1;
-    acados_tic(&timer0);
-
     ocp_nlp_dims *dims = dims_;
     ocp_nlp_config *config = config_;
     ocp_nlp_ddp_opts *opts = opts_;
@@ -560,6 +684,11 @@ int ocp_nlp_ddp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
     ocp_nlp_in *nlp_in = nlp_in_;
     ocp_nlp_out *nlp_out = nlp_out_;
     ocp_nlp_memory *nlp_mem = mem->nlp_mem;
+
+    acados_profiler *prof = nlp_mem->profiler;
+    acados_profiler_span span_tot, span_iter, span;
+    if (prof) prof->solve++;
+    acados_profiler_span_start(prof, &span_tot);
     ocp_qp_xcond_solver_config *qp_solver = config->qp_solver;
     ocp_nlp_res *nlp_res = nlp_mem->nlp_res;
     ocp_nlp_timings *nlp_timings = nlp_mem->nlp_timings;
@@ -585,6 +714,7 @@ int ocp_nlp_ddp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
     int qp_iter = 0;
     mem->alpha = 0.0;
     mem->step_norm = 0.0;
+    mem->num_segments = opts->num_segments < dims->N ? opts->num_segments : dims->N;
 
 #if defined(ACADOS_WITH_OPENMP)
     // backup number of threads
@@ -610,6 +740,8 @@ int ocp_nlp_ddp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
 
     for (; ddp_iter <= opts->nlp_opts->max_iter; ddp_iter++)
     {
+        nlp_mem->iter = ddp_iter;
+        if (prof) acados_profiler_span_start(prof, &span_iter);
         // store current iterate
         if (nlp_opts->store_iterates)
         {
@@ -622,7 +754,7 @@ int ocp_nlp_ddp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
         {
             /* Prepare the QP data */
             // linearize NLP, update QP matrices, and add Levenberg-Marquardt term
-            acados_tic(&timer1);
+            acados_profiler_span_start(prof, &span);
             ocp_nlp_approximate_qp_matrices(config, dims, nlp_in, nlp_out, nlp_opts, nlp_mem, nlp_work);
             if (nlp_opts->with_adaptive_levenberg_marquardt || config->globalization->needs_objective_value() == 1)
             {
@@ -630,7 +762,7 @@ int ocp_nlp_ddp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
             }
             ocp_nlp_add_levenberg_marquardt_term(config, dims, nlp_in, nlp_out, nlp_opts, nlp_mem, nlp_work, mem->alpha, ddp_iter, nlp_mem->qp_in);
 
-            nlp_timings->time_lin += acados_toc(&timer1);
+            nlp_timings->time_lin += acados_profiler_span_end(prof, &span, ACADOS_PROFILER_LIN, -1, nlp_mem->iter);
 
             // update QP rhs for DDP (step prim var, abs dual var)
             // NOTE: The ddp version of approximate does not exist!
@@ -641,6 +773,13 @@ int ocp_nlp_ddp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
             ocp_nlp_res_get_inf_norm(nlp_res, &nlp_out->inf_norm_res);
         }
 
+        // once the defects are closed, continue with a single shooting rollout
+        if (opts->defect_closing == DDP_DEFECT_CLOSING_MERGE && mem->num_segments > 1 &&
+            nlp_res->inf_norm_res_eq <= nlp_opts->tol_eq)
+        {
+            mem->num_segments = 1;
+        }
+
         // save statistics
         if ((ddp_iter < mem->stat_m) & (ddp_iter >= 0))
         {
@@ -651,7 +790,9 @@ int ocp_nlp_ddp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
         }
 
         // Check if initial guess was infeasible
-        if ((infeasible_initial_guess == true) && (nlp_res->inf_norm_res_eq > nlp_opts->tol_eq))
+        // NOTE: a multiple shooting rollout is not feasible after a full step,
+        //       the defects are accounted for in the line search instead.
+        if ((infeasible_initial_guess == true) && (nlp_res->inf_norm_res_eq > nlp_opts->tol_eq) && mem->num_segments == 1)
         {
             if (nlp_opts->print_level > 0)
             {
@@ -672,10 +813,10 @@ int ocp_nlp_ddp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
 
         // regularize Hessian
         // NOTE: this is done before termination, such that we can get the QP at the stationary point that is actually solved, if we exit with success.
-        acados_tic(&timer1);
+        acados_profiler_span_start(prof, &span);
         config->regularize->regularize(config->regularize, dims->regularize,
                                                nlp_opts->regularize, nlp_mem->regularize_mem);
-        nlp_timings->time_reg += acados_toc(&timer1);
+        nlp_timings->time_reg += acados_profiler_span_end(prof, &span, ACADOS_PROFILER_REG, -1, nlp_mem->iter);
 
         // Termination
         if (check_termination(ddp_iter, nlp_res, mem, opts))
@@ -685,7 +826,7 @@ int ocp_nlp_ddp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
             omp_set_num_threads(num_threads_bkp);
 #endif
             nlp_mem->iter = ddp_iter;
-            nlp_timings->time_tot = acados_toc(&timer0);
+            nlp_timings->time_tot = acados_profiler_span_end(prof, &span_tot, ACADOS_PROFILER_SOLVE, -1, nlp_mem->iter);
             return mem->nlp_mem->status;
         }
 
@@ -768,7 +909,7 @@ int ocp_nlp_ddp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
 
             mem->nlp_mem->status = ACADOS_QP_FAILURE;
             nlp_mem->iter = ddp_iter;
-            nlp_timings->time_tot = acados_toc(&timer0);
+            nlp_timings->time_tot = acados_profiler_span_end(prof, &span_tot, ACADOS_PROFILER_SOLVE, -1, nlp_mem->iter);
 
             return mem->nlp_mem->status;
         }
@@ -782,6 +923,9 @@ int ocp_nlp_ddp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
         // Calculate step norm
         mem->step_norm = ocp_qp_out_compute_primal_nrm_inf(qp_out);
 
+        // feedback gains for all forward rollouts of this iteration
+        ocp_nlp_ddp_get_feedback_gains(config, dims, nlp_opts, nlp_mem, mem);
+
         /* end solve QP */
 
         /* globalization */
@@ -796,9 +940,9 @@ int ocp_nlp_ddp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
         else
         {
             int globalization_status;
-            acados_tic(&timer1);
+            acados_profiler_span_start(prof, &span);
             globalization_status = config->globalization->find_acceptable_iterate(config, dims, nlp_in, nlp_out, nlp_mem, mem, nlp_work, nlp_opts, &mem->alpha);
-            nlp_timings->time_glob += acados_toc(&timer1);
+            nlp_timings->time_glob += acados_profiler_span_end(prof, &span, ACADOS_PROFILER_GLOB, -1, nlp_mem->iter);
 
             if (globalization_status != ACADOS_SUCCESS)
             {
@@ -808,10 +952,13 @@ int ocp_nlp_ddp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
                 }
                 mem->nlp_mem->status = ACADOS_QP_FAILURE;
                 nlp_mem->iter = ddp_iter;
-                nlp_timings->time_tot = acados_toc(&timer0);
+                nlp_timings->time_tot = acados_profiler_span_end(prof, &span_tot, ACADOS_PROFILER_SOLVE, -1, nlp_mem->iter);
                 return mem->nlp_mem->status;
             }
         }
+        if (ddp_iter+1 < mem->stat_m)
+            mem->stat[mem->stat_n*(ddp_iter+1)+6] = mem->alpha;
+        if (prof) acados_profiler_span_end(prof, &span_iter, ACADOS_PROFILER_ITER, -1, nlp_mem->iter);
     }  // end DDP loop
 
     if (nlp_opts->print_level > 0)
@@ -908,9 +1055,6 @@ int ocp_nlp_ddp_precompute(void *config_, void *dims_, void *nlp_in_, void *nlp_
 void ocp_nlp_ddp_eval_param_sens(void *config_, void *dims_, void *opts_, void *mem_, void *work_,
                                  char *field, int stage, int index, void *sens_nlp_out_)
 {
-    acados_timer timer0;
-    acados_tic(&timer0);
-
     ocp_nlp_dims *dims = dims_;
     ocp_nlp_config *config = config_;
     ocp_nlp_ddp_opts *opts = opts_;
@@ -918,13 +1062,16 @@ void ocp_nlp_ddp_eval_param_sens(void *config_, void *dims_, void *opts_, void *
     ocp_nlp_memory *nlp_mem = mem->nlp_mem;
     ocp_nlp_out *sens_nlp_out = sens_nlp_out_;
 
+    acados_profiler_span span;
+    acados_profiler_span_start(nlp_mem->profiler, &span);
+
     ocp_nlp_ddp_workspace *work = work_;
     ocp_nlp_workspace *nlp_work = work->nlp_work;
 
     ocp_nlp_common_eval_param_sens(config, dims, opts->nlp_opts, nlp_mem, nlp_work,
                                  field, stage, index, sens_nlp_out);
 
-    nlp_mem->nlp_timings->time_solution_sensitivities = acados_toc(&timer0);
+    nlp_mem->nlp_timings->time_solution_sensitivities = acados_profiler_span_end(nlp_mem->profiler, &span, ACADOS_PROFILER_SENS, -1, nlp_mem->iter);
 
     return;
 }
@@ -57,6 +57,8 @@ typedef struct
 {
     ocp_nlp_opts *nlp_opts;
     double tol_zero_res; // exit tolerance if objective function is 0 for least-squares problem
+    int num_segments; // number of shooting segments of the forward rollout, rolled out in parallel
+    int defect_closing; // enum ddp_defect_closing
 } ocp_nlp_ddp_opts;
 
 //
@@ -90,7 +92,11 @@ typedef struct
 
     // ddp specific memory
     double *tmp_nu_times_nx;
-    struct blasfeo_dmat K_mat;
+    struct blasfeo_dmat *K_mat;  // feedback gains of the last QP solution
+    struct blasfeo_dvec *k_vec;  // feedforward terms of the last QP solution
+    struct blasfeo_dvec *dx;  // deviation of the rolled out state from the current iterate
+    struct blasfeo_dvec *x_end;  // state reached at the end of a shooting segment, stored at its last stage
+    int num_segments;
 
     // regularization for Levenberg-Marquardt
     double step_norm;
@@ -146,6 +152,9 @@ void ocp_nlp_ddp_compute_trial_iterate(void *config_, void *dims_,
             void *in_, void *out_, void *qp_out_, void *opts_, void *mem_,
             void *work_, void *out_destination_, void *solver_mem,
             double alpha, bool full_step_dual);
+//
+double ocp_nlp_ddp_compute_segment_defect(ocp_nlp_dims *dims, ocp_nlp_ddp_memory *mem,
+            ocp_nlp_out *trial_out, ocp_nlp_out *weight_merit_fun);
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -61,6 +61,12 @@ ocp_nlp_globalization_config *ocp_nlp_globalization_config_assign(void *raw_memo
     return config;
 }
 
+
+void ocp_nlp_globalization_no_qp_bounds_update(void *nlp_config, void *nlp_dims, void *nlp_mem, void *nlp_opts)
+{
+    return;
+}
+
 /************************************************
  * dims
  ************************************************/
@@ -61,12 +61,15 @@ typedef struct
     /* memory */
     acados_size_t (*memory_calculate_size)(void *config, void *dims);
     void *(*memory_assign)(void *config, void *dims, void *raw_memory);
+    acados_size_t (*memory_state_size)(void);  // memory is a plain struct, copied as a whole in snapshots
     /* functions */
+    void (*update_qp_bounds)(void *nlp_config, void *nlp_dims, void *nlp_mem, void *nlp_opts);  // called after the QP is set up, before it is solved
     int (*find_acceptable_iterate)(void *nlp_config, void *nlp_dims, void *nlp_in, void *nlp_out, void *nlp_mem, void *solver_mem, void *nlp_work, void *nlp_opts, double *step_size);
     void (*print_iteration_header)();
     void (*print_iteration)(double objective_value, void *globalization_opts, void* globalization_mem);
     int (*needs_objective_value)();
     int (*needs_qp_objective_value)();
+    int (*needs_merit_weights)();
     void (*initialize_memory)(void *config_, void *dims_, void *nlp_mem_, void *nlp_opts_);
 } ocp_nlp_globalization_config;
 
@@ -74,6 +77,8 @@ typedef struct
 acados_size_t ocp_nlp_globalization_config_calculate_size();
 //
 ocp_nlp_globalization_config *ocp_nlp_globalization_config_assign(void *raw_memory);
+//
+void ocp_nlp_globalization_no_qp_bounds_update(void *nlp_config, void *nlp_dims, void *nlp_mem, void *nlp_opts);
 
 
 /************************************************
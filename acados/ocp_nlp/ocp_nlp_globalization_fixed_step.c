@@ -152,6 +152,11 @@ void *ocp_nlp_globalization_fixed_step_memory_assign(void *config_, void *dims_,
     return mem;
 }
 
+acados_size_t ocp_nlp_globalization_fixed_step_memory_state_size(void)
+{
+    return sizeof(ocp_nlp_globalization_fixed_step_memory);
+}
+
 
 /************************************************
  * fixed step functions
@@ -179,22 +184,15 @@ int ocp_nlp_globalization_fixed_step_find_acceptable_iterate(void *nlp_config_,
         {
             // store in anderson_step, prev_qp_out
             ocp_qp_out_copy(qp_out, nlp_mem->anderson_step);
+            // restart Anderson history
+            nlp_mem->anderson_len = 0;
             // update variables (TODO: DDP primals are different)
             ocp_nlp_update_variables_sqp_delta_primal_dual(config, dims, nlp_in, nlp_out, nlp_opts, nlp_mem, nlp_work, alpha, nlp_mem->anderson_step);
         }
         else
         {
-            // tmp_qp_out = d_{k+1} - d_k: qp_step - prev_qp_out
-            ocp_qp_out_axpy(-1.0, nlp_mem->prev_qp_out, qp_out, nlp_work->tmp_qp_out);
-            // compute gamma
-            double gamma = ocp_nlp_compute_anderson_gamma(nlp_work, qp_out, nlp_work->tmp_qp_out);
-            /* update anderson_step */
-            // anderson_step *= -gamma
-            ocp_qp_out_sc(-gamma, nlp_mem->anderson_step);
-            // anderson_step += alpha * gamma * prev_qp_out
-            ocp_qp_out_add(gamma*alpha, nlp_mem->prev_qp_out, nlp_mem->anderson_step);
-            // anderson_step += (alpha - alpha * gamma) * qp_out
-            ocp_qp_out_add(alpha-gamma*alpha, qp_out, nlp_mem->anderson_step);
+            // update anderson_step using history of depth anderson_depth
+            ocp_nlp_compute_anderson_step(nlp_opts, nlp_mem, qp_out, alpha);
             // update variables (TODO: DDP primals are different)
             ocp_nlp_update_variables_sqp_delta_primal_dual(config, dims, nlp_in, nlp_out, nlp_opts, nlp_mem, nlp_work, alpha, nlp_mem->anderson_step);
         }
@@ -242,6 +240,11 @@ int ocp_nlp_globalization_fixed_step_needs_qp_objective_value()
     return 0;
 }
 
+int ocp_nlp_globalization_fixed_step_needs_merit_weights()
+{
+    return 0;
+}
+
 void ocp_nlp_globalization_fixed_step_initialize_memory(void *config_, void *dims_, void *nlp_mem_, void *nlp_opts_)
 {
     return;
@@ -257,11 +260,14 @@ void ocp_nlp_globalization_fixed_step_config_initialize_default(ocp_nlp_globaliz
     // memory
     config->memory_calculate_size = &ocp_nlp_globalization_fixed_step_memory_calculate_size;
     config->memory_assign = &ocp_nlp_globalization_fixed_step_memory_assign;
+    config->memory_state_size = &ocp_nlp_globalization_fixed_step_memory_state_size;
     // functions
+    config->update_qp_bounds = &ocp_nlp_globalization_no_qp_bounds_update;
     config->find_acceptable_iterate = &ocp_nlp_globalization_fixed_step_find_acceptable_iterate;
     config->print_iteration_header = &ocp_nlp_globalization_fixed_step_print_iteration_header;
     config->print_iteration = &ocp_nlp_globalization_fixed_step_print_iteration;
     config->needs_objective_value = &ocp_nlp_globalization_fixed_step_needs_objective_value;
     config->needs_qp_objective_value = &ocp_nlp_globalization_fixed_step_needs_qp_objective_value;
+    config->needs_merit_weights = &ocp_nlp_globalization_fixed_step_needs_merit_weights;
     config->initialize_memory = &ocp_nlp_globalization_fixed_step_initialize_memory;
 }
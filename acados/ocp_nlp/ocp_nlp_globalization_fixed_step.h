@@ -80,6 +80,8 @@ acados_size_t ocp_nlp_globalization_fixed_step_memory_calculate_size(void *confi
 //
 void *ocp_nlp_globalization_fixed_step_memory_assign(void *config, void *dims, void *raw_memory);
 //
+acados_size_t ocp_nlp_globalization_fixed_step_memory_state_size(void);
+//
 
 /************************************************
  * functions
@@ -97,6 +99,8 @@ int ocp_nlp_globalization_fixed_step_needs_objective_value();
 //
 int ocp_nlp_globalization_fixed_step_needs_qp_objective_value();
 //
+int ocp_nlp_globalization_fixed_step_needs_merit_weights();
+//
 void ocp_nlp_globalization_fixed_step_initialize_memory(void *config_, void *dims_, void *nlp_mem_, void *nlp_opts_);
 //
 void ocp_nlp_globalization_fixed_step_config_initialize_default(ocp_nlp_globalization_config *config);
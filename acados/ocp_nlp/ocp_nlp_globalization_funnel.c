@@ -222,6 +222,11 @@ void *ocp_nlp_globalization_funnel_memory_assign(void *config_, void *dims_, voi
     return mem;
 }
 
+acados_size_t ocp_nlp_globalization_funnel_memory_state_size(void)
+{
+    return sizeof(ocp_nlp_globalization_funnel_memory);
+}
+
 /************************************************
  * funnel functions
  ************************************************/
@@ -584,6 +589,11 @@ int ocp_nlp_globalization_funnel_needs_qp_objective_value()
     return 1;
 }
 
+int ocp_nlp_globalization_funnel_needs_merit_weights()
+{
+    return 0;
+}
+
 // TODO(David): maybe rename to initialize
 void ocp_nlp_globalization_funnel_initialize_memory(void *config_, void *dims_, void *nlp_mem_, void *nlp_opts_)
 {
@@ -614,11 +624,14 @@ void ocp_nlp_globalization_funnel_config_initialize_default(ocp_nlp_globalizatio
     // memory
     config->memory_calculate_size = &ocp_nlp_globalization_funnel_memory_calculate_size;
     config->memory_assign = &ocp_nlp_globalization_funnel_memory_assign;
+    config->memory_state_size = &ocp_nlp_globalization_funnel_memory_state_size;
     // functions
+    config->update_qp_bounds = &ocp_nlp_globalization_no_qp_bounds_update;
     config->find_acceptable_iterate = &ocp_nlp_globalization_funnel_find_acceptable_iterate;
     config->print_iteration_header = &ocp_nlp_globalization_funnel_print_iteration_header;
     config->print_iteration = &ocp_nlp_globalization_funnel_print_iteration;
     config->needs_objective_value = &ocp_nlp_globalization_funnel_needs_objective_value;
     config->needs_qp_objective_value = &ocp_nlp_globalization_funnel_needs_qp_objective_value;
+    config->needs_merit_weights = &ocp_nlp_globalization_funnel_needs_merit_weights;
     config->initialize_memory = &ocp_nlp_globalization_funnel_initialize_memory;
 }
@@ -43,6 +43,7 @@
 // acados
 #include "acados/ocp_nlp/ocp_nlp_globalization_common.h"
 #include "acados/ocp_nlp/ocp_nlp_common.h"
+#include "acados/ocp_nlp/ocp_nlp_ddp.h"
 #include "acados/utils/mem.h"
 #include "acados/utils/math.h"
 
@@ -77,6 +78,8 @@ void ocp_nlp_globalization_merit_backtracking_opts_initialize_default(void *conf
     ocp_nlp_globalization_config *config = config_;
 
     ocp_nlp_globalization_opts_initialize_default(config, dims, globalization_opts);
+
+    opts->nonmonotone_window = 1;
     return;
 }
 
@@ -86,7 +89,20 @@ void ocp_nlp_globalization_merit_backtracking_opts_set(void *config_, void *opts
     ocp_nlp_globalization_merit_backtracking_opts *opts = opts_;
     ocp_nlp_globalization_config *config = config_;
 
-    ocp_nlp_globalization_opts_set(config, opts->globalization_opts, field, value);
+    if (!strcmp(field, "nonmonotone_window"))
+    {
+        int* nonmonotone_window = (int *) value;
+        if (*nonmonotone_window < 1 || *nonmonotone_window > MERIT_NONMONOTONE_WINDOW_MAX)
+        {
+            printf("\nerror: ocp_nlp_globalization_merit_backtracking_opts_set: invalid value for nonmonotone_window field, need int in [1, %d], got %d.", MERIT_NONMONOTONE_WINDOW_MAX, *nonmonotone_window);
+            exit(1);
+        }
+        opts->nonmonotone_window = *nonmonotone_window;
+    }
+    else
+    {
+        ocp_nlp_globalization_opts_set(config, opts->globalization_opts, field, value);
+    }
 
     return;
 }
@@ -134,6 +150,9 @@ void *ocp_nlp_globalization_merit_backtracking_memory_assign(void *config_, void
     ocp_nlp_globalization_merit_backtracking_memory *mem = (ocp_nlp_globalization_merit_backtracking_memory *) c_ptr;
     c_ptr += sizeof(ocp_nlp_globalization_merit_backtracking_memory);
 
+    mem->merit_history_len = 0;
+    mem->merit_history_next = 0;
+
     align_char_to(8, &c_ptr);
 
     assert((char *) raw_memory + ocp_nlp_globalization_merit_backtracking_memory_calculate_size(config_, dims_) >= c_ptr);
@@ -141,6 +160,11 @@ void *ocp_nlp_globalization_merit_backtracking_memory_assign(void *config_, void
     return mem;
 }
 
+acados_size_t ocp_nlp_globalization_merit_backtracking_memory_state_size(void)
+{
+    return sizeof(ocp_nlp_globalization_merit_backtracking_memory);
+}
+
 /************************************************
  * functions
  ************************************************/
@@ -287,12 +311,141 @@ static double ocp_nlp_compute_merit_gradient(ocp_nlp_config *config, ocp_nlp_dim
     return merit_grad;
 }
 
+/* nonmonotone acceptance (Grippo, Lampariello, Lucidi 1986): the reference value is the maximum of the
+ * merit function at the current and the last nonmonotone_window-1 iterates */
+static double merit_backtracking_nonmonotone_reference(ocp_nlp_globalization_merit_backtracking_memory *merit_mem,
+                                                        double merit_fun0)
+{
+    double reference = merit_fun0;
+    for (int k = 0; k < merit_mem->merit_history_len; k++)
+        reference = merit_mem->merit_history[k] > reference ? merit_mem->merit_history[k] : reference;
+    return reference;
+}
+
+static void merit_backtracking_push_merit(ocp_nlp_globalization_merit_backtracking_memory *merit_mem,
+                                          ocp_nlp_globalization_merit_backtracking_opts *merit_opts, double merit_fun0)
+{
+    int window = merit_opts->nonmonotone_window - 1;
+    if (window < 1)
+        return;
+    merit_mem->merit_history[merit_mem->merit_history_next] = merit_fun0;
+    merit_mem->merit_history_next = (merit_mem->merit_history_next + 1) % window;
+    if (merit_mem->merit_history_len < window)
+        merit_mem->merit_history_len++;
+}
+
+/* the stored merit values are only comparable for the same weights: in nonmonotone mode, the weights
+ * are only increased to the multiplier magnitudes where needed, and the history is discarded whenever they change */
+static void merit_backtracking_update_weights_nonmonotone(ocp_nlp_dims *dims, ocp_nlp_out *weight_merit_fun,
+            ocp_qp_out *qp_out, ocp_nlp_globalization_merit_backtracking_memory *merit_mem,
+            ocp_nlp_globalization_merit_backtracking_opts *merit_opts)
+{
+    if (merit_opts->nonmonotone_window == 1)
+    {
+        merit_backtracking_update_weights(dims, weight_merit_fun, qp_out);
+        return;
+    }
+
+    int N = dims->N;
+    int *nx = dims->nx;
+    int *ni = dims->ni;
+    double tmp;
+    bool changed = false;
+
+    for (int i = 0; i < N; i++)
+    {
+        for (int j = 0; j < nx[i+1]; j++)
+        {
+            tmp = fabs(BLASFEO_DVECEL(qp_out->pi+i, j));
+            if (tmp > BLASFEO_DVECEL(weight_merit_fun->pi+i, j))
+            {
+                BLASFEO_DVECEL(weight_merit_fun->pi+i, j) = tmp;
+                changed = true;
+            }
+        }
+    }
+    for (int i = 0; i <= N; i++)
+    {
+        for (int j = 0; j < 2*ni[i]; j++)
+        {
+            tmp = BLASFEO_DVECEL(qp_out->lam+i, j);
+            if (tmp > BLASFEO_DVECEL(weight_merit_fun->lam+i, j))
+            {
+                BLASFEO_DVECEL(weight_merit_fun->lam+i, j) = tmp;
+                changed = true;
+            }
+        }
+    }
+
+    if (changed)
+    {
+        merit_mem->merit_history_len = 0;
+        merit_mem->merit_history_next = 0;
+    }
+}
+
+/* merit function and constraint violation at the current iterate from the values of the last
+ * linearization, avoids re-running the integrators at a point they were just evaluated at */
+double ocp_nlp_evaluate_merit_fun_at_iterate(ocp_nlp_dims *dims, ocp_nlp_memory *mem,
+                                             ocp_nlp_workspace *work)
+{
+    int N = dims->N;
+    int *nx = dims->nx;
+    int *ni = dims->ni;
+    double tmp;
+
+    double merit_fun = mem->cost_value;
+    for (int i = 0; i < N; i++)
+    {
+        for (int j = 0; j < nx[i+1]; j++)
+            merit_fun += fabs(BLASFEO_DVECEL(work->weight_merit_fun->pi+i, j)) * fabs(BLASFEO_DVECEL(mem->dyn_fun+i, j));
+    }
+    for (int i = 0; i <= N; i++)
+    {
+        for (int j = 0; j < 2*ni[i]; j++)
+        {
+            tmp = BLASFEO_DVECEL(mem->ineq_fun+i, j);
+            if (tmp > 0.0)
+                merit_fun += fabs(BLASFEO_DVECEL(work->weight_merit_fun->lam+i, j)) * tmp;
+        }
+    }
+    return merit_fun;
+}
+
+static double ocp_nlp_get_violation_inf_norm_at_iterate(ocp_nlp_dims *dims, ocp_nlp_memory *mem)
+{
+    int N = dims->N;
+    int *nx = dims->nx;
+    int *ni = dims->ni;
+    double violation = 0.0;
+    double tmp;
+
+    for (int i = 0; i < N; i++)
+    {
+        for (int j = 0; j < nx[i+1]; j++)
+        {
+            tmp = fabs(BLASFEO_DVECEL(mem->dyn_fun+i, j));
+            violation = tmp > violation ? tmp : violation;
+        }
+    }
+    for (int i = 0; i <= N; i++)
+    {
+        for (int j = 0; j < 2*ni[i]; j++)
+        {
+            tmp = BLASFEO_DVECEL(mem->ineq_fun+i, j);
+            violation = tmp > violation ? tmp : violation;
+        }
+    }
+    return violation;
+}
+
 static int ocp_nlp_line_search(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_in *in,
             ocp_nlp_out *out, ocp_nlp_opts *opts, ocp_nlp_memory *mem, ocp_nlp_workspace *work,
             double *alpha_reference)
 {
     ocp_nlp_globalization_merit_backtracking_opts *merit_opts = opts->globalization;
     ocp_nlp_globalization_opts *globalization_opts = merit_opts->globalization_opts;
+    ocp_nlp_globalization_merit_backtracking_memory *merit_mem = mem->globalization;
     int i, j;
 
     int N = dims->N;
@@ -321,15 +474,22 @@ static int ocp_nlp_line_search(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_n
     if (mem->iter==0)
     {
         merit_backtracking_initialize_weights(dims, work->weight_merit_fun, qp_out);
+        merit_mem->merit_history_len = 0;
+        merit_mem->merit_history_next = 0;
     }
     else
     {
-        merit_backtracking_update_weights(dims, work->weight_merit_fun, qp_out);
+        merit_backtracking_update_weights_nonmonotone(dims, work->weight_merit_fun, qp_out, merit_mem, merit_opts);
     }
 
     // TODO: why does Leineweber do full step in first SQP iter?
 
-    double merit_fun0 = ocp_nlp_evaluate_merit_fun(config, dims, in, out, opts, mem, work);
+    double merit_fun0;
+    if (mem->fun_at_iterate_valid)
+        merit_fun0 = ocp_nlp_evaluate_merit_fun_at_iterate(dims, mem, work);
+    else
+        merit_fun0 = ocp_nlp_evaluate_merit_fun(config, dims, in, out, opts, mem, work);
+    double merit_reference = merit_backtracking_nonmonotone_reference(merit_mem, merit_fun0);
 
     double reduction_factor = globalization_opts->alpha_reduction;
     double max_next_merit_fun_val = merit_fun0;
@@ -367,6 +527,9 @@ static int ocp_nlp_line_search(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_n
     //     break;
     // }
 
+    // NOTE: the step lengths are tried one after the other. Trying several concurrently would need a copy of the
+    // module memories and of the external functions per trial, as their work buffers are owned by one function
+    // object per stage. The stage loop in ocp_nlp_evaluate_merit_fun is parallel instead.
     for (j=0; alpha*reduction_factor > globalization_opts->alpha_min; j++)
     {
         // tmp_nlp_out = out + alpha * qp_out
@@ -384,9 +547,10 @@ static int ocp_nlp_line_search(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_n
         //     printf("\nalpha %f would be accepted without sufficient descent condition", alpha);
         // }
 
-        max_next_merit_fun_val = merit_fun0 + eps_sufficient_descent * dmerit_dy * alpha;
+        max_next_merit_fun_val = merit_reference + eps_sufficient_descent * dmerit_dy * alpha;
         if ((merit_fun1 < max_next_merit_fun_val) && !isnan(merit_fun1) && !isinf(merit_fun1))
         {
+            merit_backtracking_push_merit(merit_mem, merit_opts, merit_fun0);
             *alpha_reference = alpha;
             return ACADOS_SUCCESS;
         }
@@ -509,20 +673,31 @@ static int ocp_nlp_line_search_merit_check_full_step(ocp_nlp_config *config, ocp
     if (mem->iter==0)
     {
         merit_backtracking_initialize_weights(dims, work->weight_merit_fun, qp_out);
+        ((ocp_nlp_globalization_merit_backtracking_memory *) mem->globalization)->merit_history_len = 0;
+        ((ocp_nlp_globalization_merit_backtracking_memory *) mem->globalization)->merit_history_next = 0;
     }
     else
     {
         // backup weights
         copy_multipliers_nlp_to_qp(dims, work->weight_merit_fun, work->tmp_qp_out);
         // update weights
-        merit_backtracking_update_weights(dims, work->weight_merit_fun, qp_out);
+        merit_backtracking_update_weights_nonmonotone(dims, work->weight_merit_fun, qp_out,
+                                                      mem->globalization, opts->globalization);
     }
 
-    double merit_fun0 = ocp_nlp_evaluate_merit_fun(config, dims, in, out, opts, mem, work);
+    double merit_fun0, violation_current;
     double alpha = 1.0;
-
-    // TODO(oj): should the merit weight update be undone in case of early termination?
-    double violation_current = ocp_nlp_get_violation_inf_norm(config, dims, in, out, opts, mem, work);
+    if (mem->fun_at_iterate_valid)
+    {
+        merit_fun0 = ocp_nlp_evaluate_merit_fun_at_iterate(dims, mem, work);
+        violation_current = ocp_nlp_get_violation_inf_norm_at_iterate(dims, mem);
+    }
+    else
+    {
+        merit_fun0 = ocp_nlp_evaluate_merit_fun(config, dims, in, out, opts, mem, work);
+        // TODO(oj): should the merit weight update be undone in case of early termination?
+        violation_current = ocp_nlp_get_violation_inf_norm(config, dims, in, out, opts, mem, work);
+    }
 
     // tmp_nlp_out = out + alpha * qp_out
     for (int i = 0; i <= N; i++)
@@ -549,6 +724,7 @@ static int ocp_nlp_line_search_merit_check_full_step(ocp_nlp_config *config, ocp
     {
         // full step if merit and constraint violation improves
         // TODO: check armijo in this case?
+        merit_backtracking_push_merit(mem->globalization, opts->globalization, merit_fun0);
         return ACADOS_SUCCESS;
     }
     else
@@ -762,14 +938,45 @@ static int ocp_nlp_ddp_backtracking_line_search(ocp_nlp_config *config, ocp_nlp_
     ocp_nlp_globalization_merit_backtracking_opts *merit_opts = nlp_opts->globalization;
     ocp_nlp_globalization_opts *globalization_opts = merit_opts->globalization_opts;
     ocp_nlp_globalization_merit_backtracking_memory *mem = nlp_mem->globalization;
+    ocp_nlp_ddp_memory *ddp_mem = solver_mem;
+    ocp_nlp_out *weight_merit_fun = nlp_work->weight_merit_fun;
     int N = dims->N;
+    int *nx = dims->nx;
     double pred = -nlp_mem->qp_cost_value;
     double alpha = 1.0;
     double trial_cost;
     double negative_ared;
     double *tmp_fun;
 
-    int i;
+    int i, j;
+
+    // multiple shooting rollout: the defects between the segments enter an l1 merit function,
+    // the cost alone does not measure progress of infeasible iterates
+    bool with_defects = ddp_mem->num_segments > 1;
+    double merit0 = nlp_mem->cost_value;
+    if (nlp_mem->iter == 0)
+    {
+        mem->merit_history_len = 0;
+        mem->merit_history_next = 0;
+    }
+    if (with_defects)
+    {
+        if (nlp_mem->iter == 0)
+            merit_backtracking_initialize_weights(dims, weight_merit_fun, nlp_mem->qp_out);
+        else
+            merit_backtracking_update_weights_nonmonotone(dims, weight_merit_fun, nlp_mem->qp_out, mem, merit_opts);
+
+        double defect0 = 0.0;
+        for (i = 0; i < N; i++)
+        {
+            for (j = 0; j < nx[i+1]; j++)
+                defect0 += BLASFEO_DVECEL(weight_merit_fun->pi+i, j) * fabs(BLASFEO_DVECEL(nlp_mem->nlp_res->res_eq+i, j));
+        }
+        merit0 += defect0;
+        // the QP step closes the linearized defects
+        pred += defect0;
+    }
+    double merit_reference = merit_backtracking_nonmonotone_reference(mem, merit0);
 
     while (true)
     {
@@ -799,12 +1006,16 @@ static int ocp_nlp_ddp_backtracking_line_search(ocp_nlp_config *config, ocp_nlp_
             trial_cost += *tmp_fun;
         }
 
-        negative_ared = trial_cost - nlp_mem->cost_value;
+        // nonmonotone: decrease with respect to the maximum merit value of the last iterates
+        negative_ared = trial_cost - merit_reference;
+        if (with_defects)
+            negative_ared += ocp_nlp_ddp_compute_segment_defect(dims, ddp_mem, nlp_work->tmp_nlp_out, weight_merit_fun);
         // Check Armijo sufficient decrease condition
         if (negative_ared <= MIN(-globalization_opts->eps_sufficient_descent*alpha* MAX(pred, 0) + 1e-18, 0))
         {
             // IF step accepted: update x
             // reset evaluation point to SQP iterate
+            merit_backtracking_push_merit(mem, merit_opts, merit0);
             mem->alpha = alpha;
             nlp_mem->cost_value = trial_cost;
             return ACADOS_SUCCESS;
@@ -906,6 +1117,11 @@ int ocp_nlp_globalization_merit_backtracking_needs_qp_objective_value()
     return 0;
 }
 
+int ocp_nlp_globalization_merit_backtracking_needs_merit_weights()
+{
+    return 1;
+}
+
 int ocp_nlp_globalization_merit_backtracking_ddp_needs_qp_objective_value()
 {
     return 1;
@@ -927,12 +1143,15 @@ void ocp_nlp_globalization_merit_backtracking_config_initialize_default(ocp_nlp_
     // memory
     config->memory_calculate_size = &ocp_nlp_globalization_merit_backtracking_memory_calculate_size;
     config->memory_assign = &ocp_nlp_globalization_merit_backtracking_memory_assign;
+    config->memory_state_size = &ocp_nlp_globalization_merit_backtracking_memory_state_size;
 
     // functions
     config->find_acceptable_iterate = &ocp_nlp_globalization_merit_backtracking_find_acceptable_iterate;
     config->print_iteration_header = &ocp_nlp_globalization_merit_backtracking_print_iteration_header;
     config->print_iteration = &ocp_nlp_globalization_merit_backtracking_print_iteration;
+    config->update_qp_bounds = &ocp_nlp_globalization_no_qp_bounds_update;
     config->needs_objective_value = &ocp_nlp_globalization_merit_backtracking_needs_objective_value;
     config->needs_qp_objective_value = &ocp_nlp_globalization_merit_backtracking_needs_qp_objective_value;
+    config->needs_merit_weights = &ocp_nlp_globalization_merit_backtracking_needs_merit_weights;
     config->initialize_memory = &ocp_nlp_globalization_merit_backtracking_initialize_memory;
 }
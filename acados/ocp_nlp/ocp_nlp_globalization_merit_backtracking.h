@@ -52,10 +52,13 @@ extern "C" {
 /************************************************
  * options
  ************************************************/
+#define MERIT_NONMONOTONE_WINDOW_MAX 16
+
 // TODO: remove stufF!
 typedef struct
 {
     ocp_nlp_globalization_opts *globalization_opts;
+    int nonmonotone_window; // accept against the max merit value of the last iterates, 1: monotone
 
 } ocp_nlp_globalization_merit_backtracking_opts;
 
@@ -77,6 +80,9 @@ typedef struct
 {
     double step_norm;
     double alpha;
+    double merit_history[MERIT_NONMONOTONE_WINDOW_MAX]; // merit values at the previous iterates
+    int merit_history_len;
+    int merit_history_next;
 } ocp_nlp_globalization_merit_backtracking_memory;
 
 //
@@ -84,6 +90,8 @@ acados_size_t ocp_nlp_globalization_merit_backtracking_memory_calculate_size(voi
 //
 void *ocp_nlp_globalization_merit_backtracking_memory_assign(void *config, void *dims, void *raw_memory);
 //
+acados_size_t ocp_nlp_globalization_merit_backtracking_memory_state_size(void);
+//
 
 /************************************************
  * functions
@@ -93,6 +101,8 @@ void *ocp_nlp_globalization_merit_backtracking_memory_assign(void *config, void
 double ocp_nlp_evaluate_merit_fun(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_in *in,
           ocp_nlp_out *out, ocp_nlp_opts *opts, ocp_nlp_memory *mem, ocp_nlp_workspace *work);
 //
+double ocp_nlp_evaluate_merit_fun_at_iterate(ocp_nlp_dims *dims, ocp_nlp_memory *mem, ocp_nlp_workspace *work);
+//
 void merit_backtracking_initialize_weights(ocp_nlp_dims *dims, ocp_nlp_out *weight_merit_fun, ocp_qp_out *qp_out);
 //
 void merit_backtracking_update_weights(ocp_nlp_dims *dims, ocp_nlp_out *weight_merit_fun, ocp_qp_out *qp_out);
@@ -111,6 +121,8 @@ int ocp_nlp_globalization_merit_backtracking_needs_objective_value();
 //
 int ocp_nlp_globalization_merit_backtracking_needs_qp_objective_value();
 //
+int ocp_nlp_globalization_merit_backtracking_needs_merit_weights();
+//
 int ocp_nlp_globalization_merit_backtracking_ddp_needs_qp_objective_value();
 //
 void ocp_nlp_globalization_merit_backtracking_initialize_memory(void *config_,
@@ -0,0 +1,519 @@
+/*
+ * Copyright (c) The acados authors.
+ *
+ * This file is part of acados.
+ *
+ * The 2-Clause BSD License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.;
+ */
+
+
+#include "acados/ocp_nlp/ocp_nlp_globalization_common.h"
+#include "acados/ocp_nlp/ocp_nlp_globalization_trust_region.h"
+#include "acados/ocp_nlp/ocp_nlp_globalization_merit_backtracking.h"
+#include "acados/ocp_nlp/ocp_nlp_common.h"
+
+// external
+#include <assert.h>
+#include <math.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+
+// blasfeo
+#include "blasfeo_d_aux.h"
+#include "blasfeo_d_blas.h"
+// acados
+#include "acados/utils/mem.h"
+#include "acados/utils/math.h"
+
+
+/************************************************
+ * options
+ ************************************************/
+
+acados_size_t ocp_nlp_globalization_trust_region_opts_calculate_size(void *config_, void *dims_)
+{
+    ocp_nlp_dims *dims = dims_;
+    ocp_nlp_config *config = config_;
+
+    acados_size_t size = 0;
+
+    size += sizeof(ocp_nlp_globalization_trust_region_opts);
+
+    size += ocp_nlp_globalization_opts_calculate_size(config, dims);
+
+    return size;
+}
+
+
+void ocp_nlp_globalization_trust_region_opts_initialize_default(void *config_, void *dims_, void *opts_)
+{
+    ocp_nlp_dims *dims = dims_;
+    ocp_nlp_globalization_trust_region_opts *opts = opts_;
+    ocp_nlp_globalization_opts *globalization_opts = opts->globalization_opts;
+    ocp_nlp_globalization_config *config = config_;
+
+    ocp_nlp_globalization_opts_initialize_default(config, dims, globalization_opts);
+
+    opts->radius_init = 1.0;
+    opts->radius_max = 1e4;
+    opts->radius_min = 1e-12;
+    opts->eta = 1e-4;
+    // NOTE: keep in sync with TRUST_REGION_ETA_SHRINK in acados_ocp_options.py
+    opts->eta_shrink = 0.25;
+    opts->eta_expand = 0.75;
+    opts->shrink_factor = 0.25;
+    opts->expand_factor = 2.0;
+
+    return;
+}
+
+
+void ocp_nlp_globalization_trust_region_opts_set(void *config_, void *opts_, const char *field, void* value)
+{
+    ocp_nlp_globalization_trust_region_opts *opts = opts_;
+    ocp_nlp_globalization_config *config = config_;
+
+    if (!strcmp(field, "trust_region_radius_init"))
+    {
+        double* radius_init = (double *) value;
+        if (*radius_init <= 0.0)
+        {
+            printf("\nerror: ocp_nlp_globalization_trust_region_opts_set: invalid value for trust_region_radius_init field, need double > 0, got %f.", *radius_init);
+            exit(1);
+        }
+        opts->radius_init = *radius_init;
+    }
+    else if (!strcmp(field, "trust_region_radius_max"))
+    {
+        double* radius_max = (double *) value;
+        if (*radius_max <= 0.0)
+        {
+            printf("\nerror: ocp_nlp_globalization_trust_region_opts_set: invalid value for trust_region_radius_max field, need double > 0, got %f.", *radius_max);
+            exit(1);
+        }
+        opts->radius_max = *radius_max;
+    }
+    else if (!strcmp(field, "trust_region_radius_min"))
+    {
+        double* radius_min = (double *) value;
+        if (*radius_min < 0.0)
+        {
+            printf("\nerror: ocp_nlp_globalization_trust_region_opts_set: invalid value for trust_region_radius_min field, need double >= 0, got %f.", *radius_min);
+            exit(1);
+        }
+        opts->radius_min = *radius_min;
+    }
+    else if (!strcmp(field, "trust_region_eta"))
+    {
+        double* eta = (double *) value;
+        if (*eta < 0.0 || *eta >= opts->eta_shrink)
+        {
+            printf("\nerror: ocp_nlp_globalization_trust_region_opts_set: invalid value for trust_region_eta field, need double in [0, %f), got %f.", opts->eta_shrink, *eta);
+            exit(1);
+        }
+        opts->eta = *eta;
+    }
+    else if (!strcmp(field, "trust_region_shrink_factor"))
+    {
+        double* shrink_factor = (double *) value;
+        if (*shrink_factor <= 0.0 || *shrink_factor >= 1.0)
+        {
+            printf("\nerror: ocp_nlp_globalization_trust_region_opts_set: invalid value for trust_region_shrink_factor field, need double in (0,1), got %f.", *shrink_factor);
+            exit(1);
+        }
+        opts->shrink_factor = *shrink_factor;
+    }
+    else if (!strcmp(field, "trust_region_expand_factor"))
+    {
+        double* expand_factor = (double *) value;
+        if (*expand_factor <= 1.0)
+        {
+            printf("\nerror: ocp_nlp_globalization_trust_region_opts_set: invalid value for trust_region_expand_factor field, need double > 1, got %f.", *expand_factor);
+            exit(1);
+        }
+        opts->expand_factor = *expand_factor;
+    }
+    else
+    {
+        ocp_nlp_globalization_opts_set(config, opts->globalization_opts, field, value);
+    }
+    return;
+}
+
+
+void *ocp_nlp_globalization_trust_region_opts_assign(void *config_, void *dims_, void *raw_memory)
+{
+    ocp_nlp_dims *dims = dims_;
+    ocp_nlp_globalization_config *config = config_;
+
+    char *c_ptr = (char *) raw_memory;
+
+    ocp_nlp_globalization_trust_region_opts *opts = (ocp_nlp_globalization_trust_region_opts *) c_ptr;
+    c_ptr += sizeof(ocp_nlp_globalization_trust_region_opts);
+
+    opts->globalization_opts = ocp_nlp_globalization_opts_assign(config, dims, c_ptr);
+    c_ptr += ocp_nlp_globalization_opts_calculate_size(config, dims);
+
+    assert((char *) raw_memory + ocp_nlp_globalization_trust_region_opts_calculate_size(config_, dims_) >=
+           c_ptr);
+
+    return opts;
+}
+
+/************************************************
+ * memory
+ ************************************************/
+
+acados_size_t ocp_nlp_globalization_trust_region_memory_calculate_size(void *config_, void *dims_)
+{
+    ocp_nlp_dims *dims = dims_;
+    acados_size_t size = 0;
+
+    size += sizeof(ocp_nlp_globalization_trust_region_memory);
+    for (int i = 0; i <= dims->N; i++)
+        size += dims->nb[i] * sizeof(char);  // bound_tightened
+    size += 2*8;
+
+    return size;
+}
+
+
+void *ocp_nlp_globalization_trust_region_memory_assign(void *config_, void *dims_, void *raw_memory)
+{
+    ocp_nlp_dims *dims = dims_;
+    char *c_ptr = (char *) raw_memory;
+
+    // initial align
+    align_char_to(8, &c_ptr);
+
+    ocp_nlp_globalization_trust_region_memory *mem = (ocp_nlp_globalization_trust_region_memory *) c_ptr;
+    c_ptr += sizeof(ocp_nlp_globalization_trust_region_memory);
+
+    align_char_to(8, &c_ptr);
+
+    int nb_tot = 0;
+    for (int i = 0; i <= dims->N; i++)
+        nb_tot += dims->nb[i];
+    assign_and_advance_char(nb_tot, &mem->bound_tightened, &c_ptr);
+    for (int j = 0; j < nb_tot; j++)
+        mem->bound_tightened[j] = 0;
+
+    mem->radius = 1.0;
+    mem->ratio = 0.0;
+    mem->alpha = 1.0;
+
+    assert((char *) raw_memory + ocp_nlp_globalization_trust_region_memory_calculate_size(config_, dims_) >= c_ptr);
+
+    return mem;
+}
+
+
+acados_size_t ocp_nlp_globalization_trust_region_memory_state_size(void)
+{
+    // bound_tightened is set up in every iteration and not part of the state
+    return offsetof(ocp_nlp_globalization_trust_region_memory, bound_tightened);
+}
+
+/************************************************
+ * functions
+ ************************************************/
+
+/* restricts the control bounds of the QP to the trust region, bounds that are not active in the
+ * QP (masked) are left untouched, the step in those components is limited by truncation.
+ * State bounds are not restricted: together with the dynamics defects and the x0 embedding
+ * they could render the QP infeasible. The state step is limited by truncation as well. */
+void ocp_nlp_globalization_trust_region_update_qp_bounds(void *nlp_config_, void *nlp_dims_, void *nlp_mem_, void *nlp_opts_)
+{
+    ocp_nlp_memory *nlp_mem = nlp_mem_;
+    ocp_nlp_opts *nlp_opts = nlp_opts_;
+    ocp_nlp_globalization_trust_region_opts *opts = nlp_opts->globalization;
+    ocp_nlp_globalization_trust_region_memory *mem = nlp_mem->globalization;
+    ocp_qp_in *qp_in = nlp_mem->qp_in;
+
+    int N = qp_in->dim->N;
+    int *nu = qp_in->dim->nu;
+    int *nb = qp_in->dim->nb;
+    int *ng = qp_in->dim->ng;
+
+    if (nlp_mem->iter == 0)
+        mem->radius = opts->radius_init;
+    double radius = mem->radius;
+
+    double lo, hi;
+    char *tightened = mem->bound_tightened;
+    for (int i = 0; i <= N; i++)
+    {
+        for (int j = 0; j < nb[i]; j++)
+        {
+            tightened[j] = 0;
+            // only control bounds
+            if (qp_in->idxb[i][j] >= nu[i])
+                continue;
+            // d holds the lower bound and the negated upper bound on the step
+            if (BLASFEO_DVECEL(qp_in->d_mask+i, j) == 0.0 || BLASFEO_DVECEL(qp_in->d_mask+i, nb[i]+ng[i]+j) == 0.0)
+                continue;
+            lo = BLASFEO_DVECEL(qp_in->d+i, j);
+            hi = -BLASFEO_DVECEL(qp_in->d+i, nb[i]+ng[i]+j);
+            // keep bounds that are violated by more than the radius, restoring them has priority
+            if (MAX(lo, -radius) <= MIN(hi, radius))
+            {
+                if (lo < -radius)
+                {
+                    BLASFEO_DVECEL(qp_in->d+i, j) = -radius;
+                    tightened[j] |= 1;
+                }
+                if (hi > radius)
+                {
+                    BLASFEO_DVECEL(qp_in->d+i, nb[i]+ng[i]+j) = -radius;
+                    tightened[j] |= 2;
+                }
+            }
+        }
+        tightened += nb[i];
+    }
+}
+
+
+/* the multipliers of bounds that are active only because of the trust region are not
+ * multipliers of the NLP, set them to zero before they enter the step and the merit weights */
+static void ocp_nlp_trust_region_zero_tightened_multipliers(ocp_nlp_globalization_trust_region_memory *mem, ocp_qp_out *qp_out)
+{
+    int N = qp_out->dim->N;
+    int *nb = qp_out->dim->nb;
+    int *ng = qp_out->dim->ng;
+
+    char *tightened = mem->bound_tightened;
+    for (int i = 0; i <= N; i++)
+    {
+        for (int j = 0; j < nb[i]; j++)
+        {
+            if (tightened[j] & 1)
+                BLASFEO_DVECEL(qp_out->lam+i, j) = 0.0;
+            if (tightened[j] & 2)
+                BLASFEO_DVECEL(qp_out->lam+i, nb[i]+ng[i]+j) = 0.0;
+        }
+        tightened += nb[i];
+    }
+}
+
+
+/* linear and quadratic term of the QP objective along the QP step */
+static void ocp_nlp_trust_region_qp_model(ocp_nlp_dims *dims, ocp_qp_in *qp_in, ocp_qp_out *qp_out,
+                                          ocp_nlp_workspace *nlp_work, double *lin, double *quad)
+{
+    int N = dims->N;
+    int nux, ns;
+
+    *lin = 0.0;
+    *quad = 0.0;
+    for (int i = 0; i <= N; i++)
+    {
+        nux = dims->nx[i] + dims->nu[i];
+        ns = dims->ns[i];
+        // 0.5 * d.T H d
+        blasfeo_dsymv_l(nux, 0.5, &qp_in->RSQrq[i], 0, 0, &qp_out->ux[i], 0,
+                        0.0, &qp_out->ux[i], 0, &nlp_work->tmp_nv, 0);
+        *quad += blasfeo_ddot(nux, &qp_out->ux[i], 0, &nlp_work->tmp_nv, 0);
+        // 0.5 * slack.T Z slack
+        blasfeo_dvecmul(2*ns, &qp_in->Z[i], 0, &qp_out->ux[i], nux, &nlp_work->tmp_nv, 0);
+        *quad += 0.5 * blasfeo_ddot(2*ns, &nlp_work->tmp_nv, 0, &qp_out->ux[i], nux);
+        // g.T d, including slacks
+        *lin += blasfeo_ddot(nux + 2*ns, &qp_out->ux[i], 0, &qp_in->rqz[i], 0);
+    }
+}
+
+
+int ocp_nlp_globalization_trust_region_find_acceptable_iterate(void *nlp_config_, void *nlp_dims_, void *nlp_in_, void *nlp_out_, void *nlp_mem_, void *solver_mem, void *nlp_work_, void *nlp_opts_, double *step_size)
+{
+    ocp_nlp_config *config = nlp_config_;
+    ocp_nlp_dims *dims = nlp_dims_;
+    ocp_nlp_in *nlp_in = nlp_in_;
+    ocp_nlp_out *nlp_out = nlp_out_;
+    ocp_nlp_memory *nlp_mem = nlp_mem_;
+    ocp_nlp_workspace *nlp_work = nlp_work_;
+    ocp_nlp_opts *nlp_opts = nlp_opts_;
+    ocp_nlp_globalization_trust_region_opts *opts = nlp_opts->globalization;
+    ocp_nlp_globalization_opts *globalization_opts = opts->globalization_opts;
+    ocp_nlp_globalization_trust_region_memory *mem = nlp_mem->globalization;
+
+    ocp_qp_in *qp_in = nlp_mem->qp_in;
+    ocp_qp_out *qp_out = nlp_mem->qp_out;
+
+    int N = dims->N;
+    int *nv = dims->nv;
+
+    ocp_nlp_trust_region_zero_tightened_multipliers(mem, qp_out);
+
+    // l1 merit function weights as in merit backtracking
+    if (nlp_mem->iter == 0)
+        merit_backtracking_initialize_weights(dims, nlp_work->weight_merit_fun, qp_out);
+    else
+        merit_backtracking_update_weights(dims, nlp_work->weight_merit_fun, qp_out);
+
+    double merit_fun0;
+    if (nlp_mem->fun_at_iterate_valid)
+    {
+        merit_fun0 = ocp_nlp_evaluate_merit_fun_at_iterate(dims, nlp_mem, nlp_work);
+    }
+    else
+    {
+        for (int i = 0; i <= N; i++)
+            blasfeo_dveccp(nv[i], nlp_out->ux+i, 0, nlp_work->tmp_nlp_out->ux+i, 0);
+        merit_fun0 = ocp_nlp_evaluate_merit_fun(config, dims, nlp_in, nlp_out, nlp_opts, nlp_mem, nlp_work);
+        ocp_nlp_get_cost_value_from_submodules(config, dims, nlp_in, nlp_out, nlp_opts, nlp_mem, nlp_work);
+    }
+    // weighted l1 infeasibility, the QP step removes it in the linearization
+    double infeasibility0 = merit_fun0 - nlp_mem->cost_value;
+
+    double qp_lin, qp_quad;
+    ocp_nlp_trust_region_qp_model(dims, qp_in, qp_out, nlp_work, &qp_lin, &qp_quad);
+    double step_norm = ocp_qp_out_compute_primal_nrm_inf(qp_out);
+
+    double alpha, merit_fun1, pred, ared;
+    while (true)
+    {
+        // truncate the QP step to the trust region
+        alpha = step_norm > mem->radius ? mem->radius / step_norm : 1.0;
+
+        config->step_update(config, dims, nlp_in, nlp_out, qp_out, nlp_opts, nlp_mem,
+                            nlp_work, nlp_work->tmp_nlp_out, solver_mem, alpha, globalization_opts->full_step_dual);
+        merit_fun1 = ocp_nlp_evaluate_merit_fun(config, dims, nlp_in, nlp_out, nlp_opts, nlp_mem, nlp_work);
+
+        // reduction of the l1 merit function vs. reduction predicted by the QP model
+        pred = alpha * (infeasibility0 - qp_lin) - alpha * alpha * qp_quad;
+        ared = merit_fun0 - merit_fun1;
+        if (isnan(merit_fun1) || isinf(merit_fun1))
+            mem->ratio = -1.0;
+        else if (pred > 0.0)
+            mem->ratio = ared / pred;
+        else
+            mem->ratio = ared >= 0.0 ? 1.0 : -1.0;
+        mem->alpha = alpha;
+
+        if (nlp_opts->print_level > 1)
+        {
+            printf("trust region: radius = %e, alpha = %e, ared = %e, pred = %e, ratio = %e\n",
+                   mem->radius, alpha, ared, pred, mem->ratio);
+        }
+
+        // radius update
+        if (mem->ratio < opts->eta_shrink)
+        {
+            mem->radius = opts->shrink_factor * alpha * step_norm;
+        }
+        else if (mem->ratio > opts->eta_expand && alpha * step_norm >= (1.0 - 1e-8) * mem->radius)
+        {
+            // the step reached the boundary, either by truncation or through the restricted control bounds
+            mem->radius = MIN(opts->expand_factor * mem->radius, opts->radius_max);
+        }
+
+        if (mem->ratio >= opts->eta)
+        {
+            copy_ocp_nlp_out(dims, nlp_work->tmp_nlp_out, nlp_out);
+            *step_size = alpha;
+            return ACADOS_SUCCESS;
+        }
+
+        if (mem->radius < opts->radius_min)
+        {
+            *step_size = 0.0;
+            if (isnan(merit_fun1) || isinf(merit_fun1))
+                return ACADOS_NAN_DETECTED;
+            return ACADOS_MINSTEP;
+        }
+    }
+}
+
+/****************************************************
+Printing functions
+*****************************************************/
+
+void ocp_nlp_globalization_trust_region_print_iteration_header()
+{
+    printf("%8s   %8s   %8s   ", "alpha", "radius", "ratio");
+}
+
+
+void ocp_nlp_globalization_trust_region_print_iteration(double objective_value, void* nlp_opts_, void* mem_)
+{
+    ocp_nlp_globalization_trust_region_memory* mem = (ocp_nlp_globalization_trust_region_memory*) mem_;
+    printf("%8.2e   %8.2e   %8.2e   ", mem->alpha, mem->radius, mem->ratio);
+}
+
+
+int ocp_nlp_globalization_trust_region_needs_objective_value()
+{
+    return 1;
+}
+
+
+int ocp_nlp_globalization_trust_region_needs_qp_objective_value()
+{
+    return 0;
+}
+
+
+int ocp_nlp_globalization_trust_region_needs_merit_weights()
+{
+    return 1;
+}
+
+
+void ocp_nlp_globalization_trust_region_initialize_memory(void *config_, void *dims_, void *nlp_mem_, void *nlp_opts_)
+{
+    ocp_nlp_memory *nlp_mem = nlp_mem_;
+    ocp_nlp_opts *nlp_opts = nlp_opts_;
+    ocp_nlp_globalization_trust_region_opts *opts = nlp_opts->globalization;
+    ocp_nlp_globalization_trust_region_memory *mem = nlp_mem->globalization;
+
+    mem->radius = opts->radius_init;
+    mem->ratio = 0.0;
+    mem->alpha = 1.0;
+}
+
+
+void ocp_nlp_globalization_trust_region_config_initialize_default(ocp_nlp_globalization_config *config)
+{
+    // opts
+    config->opts_calculate_size = &ocp_nlp_globalization_trust_region_opts_calculate_size;
+    config->opts_assign = &ocp_nlp_globalization_trust_region_opts_assign;
+    config->opts_initialize_default = &ocp_nlp_globalization_trust_region_opts_initialize_default;
+    config->opts_set = &ocp_nlp_globalization_trust_region_opts_set;
+    // memory
+    config->memory_calculate_size = &ocp_nlp_globalization_trust_region_memory_calculate_size;
+    config->memory_assign = &ocp_nlp_globalization_trust_region_memory_assign;
+    config->memory_state_size = &ocp_nlp_globalization_trust_region_memory_state_size;
+    // functions
+    config->update_qp_bounds = &ocp_nlp_globalization_trust_region_update_qp_bounds;
+    config->find_acceptable_iterate = &ocp_nlp_globalization_trust_region_find_acceptable_iterate;
+    config->print_iteration_header = &ocp_nlp_globalization_trust_region_print_iteration_header;
+    config->print_iteration = &ocp_nlp_globalization_trust_region_print_iteration;
+    config->needs_objective_value = &ocp_nlp_globalization_trust_region_needs_objective_value;
+    config->needs_qp_objective_value = &ocp_nlp_globalization_trust_region_needs_qp_objective_value;
+    config->needs_merit_weights = &ocp_nlp_globalization_trust_region_needs_merit_weights;
+    config->initialize_memory = &ocp_nlp_globalization_trust_region_initialize_memory;
+}
@@ -183,11 +183,12 @@ acados_size_t ocp_nlp_qpscaling_memory_calculate_size(ocp_nlp_qpscaling_dims *di
     if (opts->scale_qp_constraints)
     {
         size += 32;
-        size += (N + 1) * sizeof(struct blasfeo_dvec);  // constraints_scaling_vec
+        size += 2 * (N + 1) * sizeof(struct blasfeo_dvec);  // constraints_scaling_vec, constr_row_norm
         for (i = 0; i <= N; i++)
         {
-            size += blasfeo_memsize_dvec(orig_qp_dim->ng[i]);
+            size += 2 * blasfeo_memsize_dvec(orig_qp_dim->ng[i]);
         }
+        size += (N + 1) * sizeof(int);  // ng_const
     }
 
     return size;
@@ -210,6 +211,9 @@ void *ocp_nlp_qpscaling_memory_assign(ocp_nlp_qpscaling_dims *dims, void *opts_,
     align_char_to(8, &c_ptr);
 
     mem->status = ACADOS_SUCCESS;
+    mem->constr_cache_valid = false;
+    mem->DCt_shared = false;
+    mem->ng_const = NULL;
 
     if (opts->scale_qp_objective != NO_OBJECTIVE_SCALING ||
         opts->scale_qp_constraints != NO_CONSTRAINT_SCALING)
@@ -223,6 +227,8 @@ void *ocp_nlp_qpscaling_memory_assign(ocp_nlp_qpscaling_dims *dims, void *opts_,
     if (opts->scale_qp_constraints)
     {
         assign_and_advance_blasfeo_dvec_structs(N + 1, &mem->constraints_scaling_vec, &c_ptr);
+        assign_and_advance_blasfeo_dvec_structs(N + 1, &mem->constr_row_norm, &c_ptr);
+        assign_and_advance_int(N + 1, &mem->ng_const, &c_ptr);
         align_char_to(32, &c_ptr);
 
         for (int i = 0; i <= N; ++i)
@@ -230,6 +236,11 @@ void *ocp_nlp_qpscaling_memory_assign(ocp_nlp_qpscaling_dims *dims, void *opts_,
             assign_and_advance_blasfeo_dvec_mem(orig_qp_dim->ng[i], mem->constraints_scaling_vec + i, &c_ptr);
             blasfeo_dvecse(orig_qp_dim->ng[i], 1.0, mem->constraints_scaling_vec+i, 0);
         }
+        for (int i = 0; i <= N; ++i)
+        {
+            assign_and_advance_blasfeo_dvec_mem(orig_qp_dim->ng[i], mem->constr_row_norm + i, &c_ptr);
+            mem->ng_const[i] = 0;
+        }
     }
     assert((char *)mem + ocp_nlp_qpscaling_memory_calculate_size(dims, opts_, orig_qp_dim) >= c_ptr);
 
@@ -308,6 +319,38 @@ void ocp_nlp_qpscaling_memory_get(ocp_nlp_qpscaling_dims *dims, void *mem_, cons
 }
 
 
+void ocp_nlp_qpscaling_memory_set(ocp_nlp_qpscaling_dims *dims, void *mem_, const char *field, int stage, void* value)
+{
+    ocp_nlp_qpscaling_memory *mem = mem_;
+
+    if (!strcmp(field, "ng_const"))
+    {
+        // only relevant with constraint scaling
+        if (mem->ng_const != NULL)
+        {
+            int *ng_const = value;
+            mem->ng_const[stage] = MIN(*ng_const, dims->qp_dim->ng[stage]);
+            mem->constr_cache_valid = false;
+        }
+    }
+    else if (!strcmp(field, "constr_cache_valid"))
+    {
+        bool *constr_cache_valid = value;
+        mem->constr_cache_valid = *constr_cache_valid;
+    }
+    else if (!strcmp(field, "DCt_shared"))
+    {
+        bool *DCt_shared = value;
+        mem->DCt_shared = *DCt_shared;
+    }
+    else
+    {
+        printf("\nerror: ocp_nlp_qpscaling_memory_set: field %s not available\n", field);
+        exit(1);
+    }
+}
+
+
 /************************************************
  * helper functions
  ************************************************/
@@ -555,6 +598,7 @@ void ocp_nlp_qpscaling_scale_constraints(ocp_nlp_qpscaling_dims *dims, void *opt
     ocp_nlp_qpscaling_memory *mem = mem_;
     ocp_nlp_qpscaling_opts *opts = opts_;
     double coeff_norm, scaling_factor;
+    bool row_const;
     ocp_qp_in *scaled_qp_in = mem->scaled_qp_in;
 
     for (i = 0; i <= N; i++)
@@ -570,7 +614,17 @@ void ocp_nlp_qpscaling_scale_constraints(ocp_nlp_qpscaling_dims *dims, void *opt
         // setup DCt, modify d in place
         for (j = 0; j < ng[i]; j++)
         {
-            coeff_norm = norm_inf_matrix_col(j, nu[i]+nx[i], qp_in->DCt+i);
+            // row norms of constant rows are computed once per NLP solve
+            row_const = mem->constr_cache_valid && j < mem->ng_const[i];
+            if (row_const)
+            {
+                coeff_norm = BLASFEO_DVECEL(mem->constr_row_norm+i, j);
+            }
+            else
+            {
+                coeff_norm = norm_inf_matrix_col(j, nu[i]+nx[i], qp_in->DCt+i);
+                BLASFEO_DVECEL(mem->constr_row_norm+i, j) = coeff_norm;
+            }
             mask_value_lower = BLASFEO_DVECEL(qp_in->d_mask+i, nb[i]+j);
             mask_value_upper = BLASFEO_DVECEL(qp_in->d_mask+i, 2*nb[i]+ng[i]+j);
 
@@ -580,12 +634,16 @@ void ocp_nlp_qpscaling_scale_constraints(ocp_nlp_qpscaling_dims *dims, void *opt
             // only scale down.
             scaling_factor = 1.0 / MAX(1.0, MAX(bound_max, coeff_norm));
 
+            // scale the constraint, the scaled row is still valid if neither the row nor its factor changed
+            // and no other scaling memory wrote to the shared DCt
+            if (!row_const || mem->DCt_shared || scaling_factor != BLASFEO_DVECEL(mem->constraints_scaling_vec+i, j))
+            {
+                blasfeo_dgecpsc(nu[i]+nx[i], 1, scaling_factor, qp_in->DCt+i, 0, j, mem->scaled_qp_in->DCt+i, 0, j);
+            }
+
             // store scaling factor
             BLASFEO_DVECEL(mem->constraints_scaling_vec+i, j) = scaling_factor;
 
-            // scale the constraint
-            blasfeo_dgecpsc(nu[i]+nx[i], 1, scaling_factor, qp_in->DCt+i, 0, j, mem->scaled_qp_in->DCt+i, 0, j);
-
             s_idx = qp_in->idxs_rev[i][nb[i] + j];  // index of slack corresponding to this constraint
             if (s_idx != -1)
             {
@@ -615,6 +673,8 @@ void ocp_nlp_qpscaling_scale_constraints(ocp_nlp_qpscaling_dims *dims, void *opt
             }
         }
     }
+    // row norms of the constant rows are cached until the next invalidation
+    mem->constr_cache_valid = true;
 }
 
 
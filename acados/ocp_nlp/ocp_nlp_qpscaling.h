@@ -71,6 +71,10 @@ typedef struct {
     int status;
     double obj_factor;
     struct blasfeo_dvec *constraints_scaling_vec;
+    struct blasfeo_dvec *constr_row_norm;  // cached inf-norms of the rows of [D, C]
+    int *ng_const;  // number of leading general constraints with constant matrix within an NLP solve
+    bool constr_cache_valid;  // false after the constraint matrices may have changed, e.g. at the start of a solve
+    bool DCt_shared;  // scaled DCt is also written by another scaling memory, rows are always rewritten
     ocp_qp_in *scaled_qp_in;
     ocp_qp_out *scaled_qp_out;
 } ocp_nlp_qpscaling_memory;
@@ -90,6 +94,7 @@ acados_size_t ocp_nlp_qpscaling_memory_calculate_size(ocp_nlp_qpscaling_dims *di
 void *ocp_nlp_qpscaling_memory_assign(ocp_nlp_qpscaling_dims *dims, void *opts_, ocp_qp_dims *orig_qp_dim, void *raw_memory);
 void *ocp_nlp_qpscaling_get_constraints_scaling_ptr(void *memory_, void* opts_);
 void ocp_nlp_qpscaling_memory_get(ocp_nlp_qpscaling_dims *dims, void *mem_, const char *field, int stage, void* value);
+void ocp_nlp_qpscaling_memory_set(ocp_nlp_qpscaling_dims *dims, void *mem_, const char *field, int stage, void* value);
 
 
 /************************************************
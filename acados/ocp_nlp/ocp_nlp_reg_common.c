@@ -39,6 +39,9 @@
 
 #include "acados/ocp_nlp/ocp_nlp_reg_common.h"
 
+#include "blasfeo_d_aux.h"
+#include "blasfeo_d_blas.h"
+
 
 
 /************************************************
@@ -59,6 +62,20 @@ void *ocp_nlp_reg_config_assign(void *raw_memory)
 
 
 
+acados_size_t ocp_nlp_reg_memory_state_size_none(void *config, ocp_nlp_reg_dims *dims, void *memory)
+{
+    return 0;
+}
+
+
+
+void ocp_nlp_reg_memory_state_copy_none(void *config, ocp_nlp_reg_dims *dims, void *memory, double *state)
+{
+    return;
+}
+
+
+
 /************************************************
  * dims
  ************************************************/
@@ -181,89 +198,152 @@ void acados_reconstruct_A(int dim, double *A, double *V, double *d)
 
 
 
-// mirroring regularization
-void acados_mirror(int dim, double *A, double *V, double *d, double *e, double epsilon)
+// mirroring eigenvalue map;
+// for max_cond_block > 0, the adaptive epsilon MAX(max_i |d_i| / max_cond_block, epsilon) is used
+void acados_mirror_eig(int dim, double *d, double epsilon, double max_cond_block)
 {
     int i;
+    double eps = epsilon;
 
-    acados_eigen_decomposition(dim, A, V, d, e);
+    if (max_cond_block > 0.0)
+    {
+        double max_eig = 0.0;
+        for (i=0; i < dim; i++)
+        {
+            max_eig = MAX(max_eig, fabs(d[i]));
+        }
+        eps = MAX(max_eig/max_cond_block, epsilon);
+    }
 
     // mirror
     for (i = 0; i < dim; i++)
     {
-        if (d[i] >= -epsilon && d[i] <= epsilon)
-            d[i] = epsilon;
+        if (d[i] >= -eps && d[i] <= eps)
+            d[i] = eps;
         else if (d[i] < 0)
             d[i] = -d[i];
     }
-
-    acados_reconstruct_A(dim, A, V, d);
 }
 
-void acados_mirror_adaptive_eps(int dim, double *A, double *V, double *d, double *e, double max_cond_block, double min_eps)
+// projecting eigenvalue map;
+// for max_cond_block > 0, the adaptive epsilon MAX(max_i d_i / max_cond_block, epsilon) is used
+void acados_project_eig(int dim, double *d, double epsilon, double max_cond_block)
 {
     int i;
-    acados_eigen_decomposition(dim, A, V, d, e);
-    double max_eig = 0.0;
-    double eps;
+    double eps = epsilon;
 
-    // compute max and min eigenvalues
-    for (i=0; i < dim; i++)
+    if (max_cond_block > 0.0)
     {
-        max_eig = MAX(max_eig, fabs(d[i]));
+        double max_eig = 0.0;
+        for (i=0; i < dim; i++)
+        {
+            max_eig = MAX(max_eig, d[i]);
+        }
+        eps = MAX(max_eig/max_cond_block, epsilon);
     }
-    eps = MAX(max_eig/max_cond_block, min_eps);
 
-    // mirror
+    // project
     for (i = 0; i < dim; i++)
     {
-        if (d[i] >= -eps && d[i] <= eps)
+        if (d[i] < eps)
             d[i] = eps;
-        else if (d[i] < 0)
-            d[i] = -d[i];
     }
+}
+
+
+
+// mirroring regularization
+void acados_mirror(int dim, double *A, double *V, double *d, double *e, double epsilon)
+{
+    acados_eigen_decomposition(dim, A, V, d, e);
+    acados_mirror_eig(dim, d, epsilon, 0.0);
+    acados_reconstruct_A(dim, A, V, d);
+}
 
+void acados_mirror_adaptive_eps(int dim, double *A, double *V, double *d, double *e, double max_cond_block, double min_eps)
+{
+    acados_eigen_decomposition(dim, A, V, d, e);
+    acados_mirror_eig(dim, d, min_eps, max_cond_block);
     acados_reconstruct_A(dim, A, V, d);
 }
 
 // projecting regularization
 void acados_project(int dim, double *A, double *V, double *d, double *e, double epsilon)
 {
-    int i;
+    acados_eigen_decomposition(dim, A, V, d, e);
+    acados_project_eig(dim, d, epsilon, 0.0);
+    acados_reconstruct_A(dim, A, V, d);
+}
 
+void acados_project_adaptive_eps(int dim, double *A, double *V, double *d, double *e, double max_cond_block, double min_eps)
+{
     acados_eigen_decomposition(dim, A, V, d, e);
+    acados_project_eig(dim, d, min_eps, max_cond_block);
+    acados_reconstruct_A(dim, A, V, d);
+}
 
-    // project
-    for (i = 0; i < dim; i++)
+
+
+// regularize the Hessian blocks of all stages in parallel by applying eig_map to their eigenvalues;
+// with pd_check, stages which are already sufficiently positive definite are left unchanged;
+// reg_hess, V, d, e and L are per stage workspaces
+void acados_reg_eig_stages(ocp_nlp_reg_dims *dims, struct blasfeo_dmat **RSQrq, double **reg_hess,
+    double **V, double **d, double **e, struct blasfeo_dmat *L, acados_reg_eig_map eig_map,
+    double epsilon, double max_cond_block, bool pd_check)
+{
+#if defined(ACADOS_WITH_OPENMP)
+    #pragma omp parallel for
+#endif
+    for (int ii=0; ii<=dims->N; ii++)
     {
-        if (d[i] < epsilon)
-            d[i] = epsilon;
-    }
+        int nux = dims->nu[ii]+dims->nx[ii];
 
-    acados_reconstruct_A(dim, A, V, d);
+        // make symmetric
+        blasfeo_dtrtr_l(nux, RSQrq[ii], 0, 0, RSQrq[ii], 0, 0);
+
+        // skip if regularization would not change the block
+        if (pd_check && acados_reg_is_pd(nux, RSQrq[ii], L+ii, epsilon, max_cond_block))
+            continue;
+
+        // regularize
+        blasfeo_unpack_dmat(nux, nux, RSQrq[ii], 0, 0, reg_hess[ii], nux);
+        acados_eigen_decomposition(nux, reg_hess[ii], V[ii], d[ii], e[ii]);
+        eig_map(nux, d[ii], epsilon, max_cond_block);
+        acados_reconstruct_A(nux, reg_hess[ii], V[ii], d[ii]);
+        blasfeo_pack_dmat(nux, nux, reg_hess[ii], nux, RSQrq[ii], 0, 0);
+    }
 }
 
 
-void acados_project_adaptive_eps(int dim, double *A, double *V, double *d, double *e, double max_cond_block, double min_eps)
+
+// check if all eigenvalues of the symmetric matrix A are larger than epsilon,
+// i.e. if projecting or mirroring would leave A unchanged;
+// for max_cond_block > 0, epsilon is increased to an upper bound of the adaptive epsilon;
+// uses a Gershgorin estimate and, if inconclusive, a Cholesky factorization of A - epsilon*I into L
+bool acados_reg_is_pd(int dim, struct blasfeo_dmat *A, struct blasfeo_dmat *L, double epsilon, double max_cond_block)
 {
     int i;
-    acados_eigen_decomposition(dim, A, V, d, e);
-    double max_eig = 0.0;
-    double eps;
+    double tmp;
 
-    // compute max and min eigenvalues
-    for (i=0; i < dim; i++)
+    if (max_cond_block > 0)
     {
-        max_eig = MAX(max_eig, d[i]);
+        compute_gershgorin_max_abs_eig_estimate(dim, A, &tmp);
+        epsilon = MAX(tmp/max_cond_block, epsilon);
     }
-    eps = MAX(max_eig/max_cond_block, min_eps);
 
-    // project
+    compute_gershgorin_min_eig_estimate(dim, A, &tmp);
+    if (tmp > epsilon)
+        return true;
+
+    blasfeo_dgecp(dim, dim, A, 0, 0, L, 0, 0);
+    blasfeo_ddiare(dim, -epsilon, L, 0, 0);
+    // blasfeo sets the diagonal entry to zero for non-positive pivots
+    blasfeo_dpotrf_l(dim, L, 0, 0, L, 0, 0);
+
     for (i = 0; i < dim; i++)
     {
-        if (d[i] < eps)
-            d[i] = eps;
+        if (!(BLASFEO_DMATEL(L, i, i) > 0.0))
+            return false;
     }
-
-    acados_reconstruct_A(dim, A, V, d);
+    return true;
 }
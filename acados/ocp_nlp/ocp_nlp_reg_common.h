@@ -94,6 +94,10 @@ typedef struct
     void (*memory_set_ux_ptr)(ocp_nlp_reg_dims *dims, struct blasfeo_dvec *vec, void *memory);
     void (*memory_set_pi_ptr)(ocp_nlp_reg_dims *dims, struct blasfeo_dvec *vec, void *memory);
     void (*memory_set_lam_ptr)(ocp_nlp_reg_dims *dims, struct blasfeo_dvec *vec, void *memory);
+    // state kept across calls, e.g. from regularize_lhs to regularize_rhs, copied as doubles in snapshots
+    acados_size_t (*memory_state_size)(void *config, ocp_nlp_reg_dims *dims, void *memory);
+    void (*memory_state_get)(void *config, ocp_nlp_reg_dims *dims, void *memory, double *state);
+    void (*memory_state_set)(void *config, ocp_nlp_reg_dims *dims, void *memory, double *state);
     /* functions */
     void (*regularize)(void *config, ocp_nlp_reg_dims *dims, void *opts, void *memory);
     void (*regularize_lhs)(void *config, ocp_nlp_reg_dims *dims, void *opts, void *memory);
@@ -105,15 +109,28 @@ typedef struct
 acados_size_t ocp_nlp_reg_config_calculate_size(void);
 //
 void *ocp_nlp_reg_config_assign(void *raw_memory);
+// for modules without state across calls
+acados_size_t ocp_nlp_reg_memory_state_size_none(void *config, ocp_nlp_reg_dims *dims, void *memory);
+//
+void ocp_nlp_reg_memory_state_copy_none(void *config, ocp_nlp_reg_dims *dims, void *memory, double *state);
 
 
 
 /* regularization help functions */
+// maps the eigenvalues d of a Hessian block, adaptive epsilon for max_cond_block > 0
+typedef void (*acados_reg_eig_map)(int dim, double *d, double epsilon, double max_cond_block);
+
 void acados_reconstruct_A(int dim, double *A, double *V, double *d);
+void acados_mirror_eig(int dim, double *d, double epsilon, double max_cond_block);
+void acados_project_eig(int dim, double *d, double epsilon, double max_cond_block);
 void acados_mirror(int dim, double *A, double *V, double *d, double *e, double epsilon);
 void acados_mirror_adaptive_eps(int dim, double *A, double *V, double *d, double *e, double max_cond_block, double min_eps);
 void acados_project(int dim, double *A, double *V, double *d, double *e, double epsilon);
 void acados_project_adaptive_eps(int dim, double *A, double *V, double *d, double *e, double max_cond_block, double min_eps);
+bool acados_reg_is_pd(int dim, struct blasfeo_dmat *A, struct blasfeo_dmat *L, double epsilon, double max_cond_block);
+void acados_reg_eig_stages(ocp_nlp_reg_dims *dims, struct blasfeo_dmat **RSQrq, double **reg_hess,
+    double **V, double **d, double **e, struct blasfeo_dmat *L, acados_reg_eig_map eig_map,
+    double epsilon, double max_cond_block, bool pd_check);
 
 
 #ifdef __cplusplus
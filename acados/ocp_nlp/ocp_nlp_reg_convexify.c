@@ -151,6 +151,7 @@ acados_size_t ocp_nlp_reg_convexify_memory_calculate_size(void *config_, ocp_nlp
     size += nuxM*nuxM*sizeof(double);   // reg_hess
 
     size += (N+1)*sizeof(struct blasfeo_dmat); // original_RSQrq
+    size += (N+1)*sizeof(struct blasfeo_dmat); // Q_bar_stage
 
     size += 1 * 64;
 
@@ -165,6 +166,7 @@ acados_size_t ocp_nlp_reg_convexify_memory_calculate_size(void *config_, ocp_nlp
     for (ii=0; ii<=N; ii++)
     {
         size += 2*blasfeo_memsize_dmat(nu[ii]+nx[ii]+1, nu[ii]+nx[ii]); // original_RSQrq
+        size += blasfeo_memsize_dmat(nx[ii], nx[ii]); // Q_bar_stage
     }
     size += blasfeo_memsize_dmat(nuxM, nuxM); // tmp_RSQ
 
@@ -240,6 +242,9 @@ void *ocp_nlp_reg_convexify_assign_memory(void *config_, ocp_nlp_reg_dims *dims,
     mem->original_RSQrq = (struct blasfeo_dmat *) c_ptr;
     c_ptr += (N+1)*sizeof(struct blasfeo_dmat);
 
+    mem->Q_bar_stage = (struct blasfeo_dmat *) c_ptr;
+    c_ptr += (N+1)*sizeof(struct blasfeo_dmat);
+
     mem->RSQrq = (struct blasfeo_dmat **) c_ptr;
     c_ptr += (N+1)*sizeof(struct blasfeo_dmat *);
 
@@ -279,6 +284,9 @@ void *ocp_nlp_reg_convexify_assign_memory(void *config_, ocp_nlp_reg_dims *dims,
     for (ii=0; ii<=N; ii++)
         assign_and_advance_blasfeo_dmat_mem(nu[ii]+nx[ii]+1, nu[ii]+nx[ii], &mem->original_RSQrq[ii], &c_ptr);
 
+    for (ii=0; ii<=N; ii++)
+        assign_and_advance_blasfeo_dmat_mem(nx[ii], nx[ii], &mem->Q_bar_stage[ii], &c_ptr);
+
 
     assign_and_advance_blasfeo_dmat_mem(nuxM, nuxM, &mem->tmp_RSQ, &c_ptr);
 
@@ -448,6 +456,57 @@ void ocp_nlp_reg_convexify_memory_set_lam_ptr(ocp_nlp_reg_dims *dims, struct bla
 
 
 
+// original_RSQrq and Q_bar_stage, set in regularize_lhs and used in regularize_rhs and correct_dual_sol
+acados_size_t ocp_nlp_reg_convexify_memory_state_size(void *config, ocp_nlp_reg_dims *dims, void *memory_)
+{
+    int *nx = dims->nx;
+    int *nu = dims->nu;
+
+    acados_size_t size = 0;
+    for (int ii = 0; ii <= dims->N; ii++)
+    {
+        size += (nu[ii]+nx[ii]+1) * (nu[ii]+nx[ii]);
+        size += nx[ii] * nx[ii];
+    }
+    return size;
+}
+
+
+
+void ocp_nlp_reg_convexify_memory_state_get(void *config, ocp_nlp_reg_dims *dims, void *memory_, double *state)
+{
+    ocp_nlp_reg_convexify_memory *mem = memory_;
+    int *nx = dims->nx;
+    int *nu = dims->nu;
+
+    for (int ii = 0; ii <= dims->N; ii++)
+    {
+        blasfeo_unpack_dmat(nu[ii]+nx[ii]+1, nu[ii]+nx[ii], &mem->original_RSQrq[ii], 0, 0, state, nu[ii]+nx[ii]+1);
+        state += (nu[ii]+nx[ii]+1) * (nu[ii]+nx[ii]);
+        blasfeo_unpack_dmat(nx[ii], nx[ii], &mem->Q_bar_stage[ii], 0, 0, state, nx[ii]);
+        state += nx[ii] * nx[ii];
+    }
+}
+
+
+
+void ocp_nlp_reg_convexify_memory_state_set(void *config, ocp_nlp_reg_dims *dims, void *memory_, double *state)
+{
+    ocp_nlp_reg_convexify_memory *mem = memory_;
+    int *nx = dims->nx;
+    int *nu = dims->nu;
+
+    for (int ii = 0; ii <= dims->N; ii++)
+    {
+        blasfeo_pack_dmat(nu[ii]+nx[ii]+1, nu[ii]+nx[ii], state, nu[ii]+nx[ii]+1, &mem->original_RSQrq[ii], 0, 0);
+        state += (nu[ii]+nx[ii]+1) * (nu[ii]+nx[ii]);
+        blasfeo_pack_dmat(nx[ii], nx[ii], state, nx[ii], &mem->Q_bar_stage[ii], 0, 0);
+        state += nx[ii] * nx[ii];
+    }
+}
+
+
+
 void ocp_nlp_reg_convexify_memory_set(void *config_, ocp_nlp_reg_dims *dims, void *memory_, char *field, void *value)
 {
 
@@ -513,145 +572,9 @@ void ocp_nlp_reg_convexify_memory_set(void *config_, ocp_nlp_reg_dims *dims, voi
 // Algorithm 6 from Verschueren2017
 // NOTE this only considers the case of (dynamics) equality constraints (no inequality constraints)
 // TODO inequality constraints case
-void ocp_nlp_reg_convexify_regularize(void *config, ocp_nlp_reg_dims *dims, void *opts_, void *mem_)
-{
-    ocp_nlp_reg_convexify_memory *mem = mem_;
-    ocp_nlp_reg_convexify_opts *opts = opts_;
-
-    int ii, jj;
-
-    int *nx = dims->nx;
-    int *nu = dims->nu;
-    int N = dims->N;
-
-    double delta = opts->delta;
-
-    blasfeo_drowin(nu[N]+nx[N], 1.0, mem->rq[N], 0, mem->RSQrq[N], nu[N]+nx[N], 0);
-    blasfeo_dgecp(nu[N]+nx[N]+1, nu[N]+nx[N], mem->RSQrq[N], 0, 0, &mem->original_RSQrq[N], 0, 0);
-
-    // TODO regularize R at last stage if needed !!!
-    // TODO fix for nu[N]>0 !!!!!!!!!!
-
-    // delta_eye = delta * eye(nx[N])
-    blasfeo_dgese(nx[N], nx[N], 0.0, &mem->delta_eye, 0, 0);
-    blasfeo_ddiare(nx[N], delta, &mem->delta_eye, 0, 0);
-    // Q_tilde = delta_eye
-    blasfeo_dgecp(nx[N], nx[N], &mem->delta_eye, 0, 0, &mem->Q_tilde, 0, 0);
-    // Q_bar = RSQ[N]
-    blasfeo_dgecp(nx[N], nx[N], mem->RSQrq[N], nu[N], nu[N], &mem->Q_bar, 0, 0);
-    // RSQ[N] = Q_tilde
-    blasfeo_dgecp(nx[N], nx[N], &mem->Q_tilde, 0, 0, mem->RSQrq[N], nu[N], nu[N]);
-    // Q_bar -= Q_tilde
-    blasfeo_dgead(nx[N], nx[N], -1.0, &mem->Q_tilde, 0, 0, &mem->Q_bar, 0, 0);
-    // make Q_bar symmetric
-    blasfeo_dtrtr_l(nx[N], &mem->Q_bar, 0, 0, &mem->Q_bar, 0, 0);
-
-    for (ii = N-1; ii >= 0; --ii)
-    {
-        // add b in BAbt, rq in RSQrq
-        blasfeo_drowin(nx[ii+1], 1.0, mem->b[ii], 0, mem->BAbt[ii], nu[ii]+nx[ii], 0);
-        blasfeo_drowin(nu[ii]+nx[ii], 1.0, mem->rq[ii], 0, mem->RSQrq[ii], nu[ii]+nx[ii], 0);
-        // backup RSQrq -> original_RSQrq
-        blasfeo_dgecp(nu[ii]+nx[ii]+1, nu[ii]+nx[ii], mem->RSQrq[ii], 0, 0, &mem->original_RSQrq[ii], 0, 0);
-
-        // printf("----------------\n");
-        // printf("--- stage %d ---\n", i);
-        // printf("----------------\n");
-
-        // printf("QSR\n");
-        // blasfeo_print_dmat(nx+nu+1, nx+nu, &work->qp_in->RSQrq[i], 0, 0);
-
-        // printf("Q_bar\n");
-        // blasfeo_print_dmat(nx, nx, &Q_bar, 0, 0);
-
-        // printf("BAbt\n");
-        // blasfeo_print_dmat(nx+nu, nx, &work->qp_in->BAbt[i], 0, 0);
-
-        // TODO implement using cholesky
-
-        // BAQ = BA * Q_bar
-        blasfeo_dgemm_nt(nu[ii]+nx[ii], nx[ii], nx[ii+1], 1.0, mem->BAbt[ii], 0, 0, &mem->Q_bar, 0, 0, 0.0, &mem->BAQ, 0, 0, &mem->BAQ, 0, 0);
-        // rank nx[ii+1] update to RSQrq with BAQ
-        blasfeo_dsyrk_ln_mn(nu[ii]+nx[ii]+1, nu[ii]+nx[ii], nx[ii+1], 1.0, mem->BAbt[ii], 0, 0, &mem->BAQ, 0, 0, 1.0, mem->RSQrq[ii], 0, 0, mem->RSQrq[ii], 0, 0);
-
-        blasfeo_drowex(nu[ii]+nx[ii], 1.0, mem->RSQrq[ii], nu[ii]+nx[ii], 0, mem->rq[ii], 0);
-
-        // printf("BAQ\n");
-        // blasfeo_print_dmat(nx+nu, nx, &BAQ, 0, 0);
-
-        blasfeo_unpack_dmat(nu[ii], nu[ii], mem->RSQrq[ii], 0, 0, mem->R, nu[ii]);
-        acados_eigen_decomposition(nu[ii], mem->R, mem->V, mem->d, mem->e);
-
-        bool needs_regularization = false;
-        for (jj = 0; jj < nu[ii]; jj++)
-            if (mem->d[jj] < 1e-10)
-                needs_regularization = true;
-
-        if (needs_regularization)
-        {
-            blasfeo_dgecp(nu[ii]+nx[ii], nu[ii]+nx[ii], mem->RSQrq[ii], 0, 0, &mem->tmp_RSQ, 0, 0);
-            // TODO project only nu instead ???????????
-            // TODO compute correction as a separate matrix, and apply to original_RSQrq too (TODO change this name then)
-//            acados_mirror(nu[ii]+nx[ii], mem->reg_hess, mem->V, mem->d, mem->e, 1e-4);
-            blasfeo_unpack_dmat(nu[ii]+nx[ii], nu[ii]+nx[ii], mem->RSQrq[ii], 0, 0, mem->reg_hess, nu[ii]+nx[ii]);
-            acados_project(nu[ii]+nx[ii], mem->reg_hess, mem->V, mem->d, mem->e, 1e-4);
-            blasfeo_pack_dmat(nu[ii]+nx[ii], nu[ii]+nx[ii], mem->reg_hess, nu[ii]+nx[ii], mem->RSQrq[ii], 0, 0);
-
-            blasfeo_dgead(nu[ii]+nx[ii], nu[ii]+nx[ii], -1.0, mem->RSQrq[ii], 0, 0, &mem->tmp_RSQ, 0, 0);
-            blasfeo_dgead(nu[ii]+nx[ii], nu[ii]+nx[ii], -1.0, &mem->tmp_RSQ, 0, 0, &mem->original_RSQrq[ii], 0, 0);
-        }
-
-        // printf("QSR_hat\n");
-        // blasfeo_print_dmat(nx+nu+1, nx+nu, &work->qp_in->RSQrq[i], 0, 0);
-
-
-        // backup Q
-        blasfeo_dgecp(nx[ii], nx[ii], mem->RSQrq[ii], nu[ii], nu[ii], &mem->Q_bar, 0, 0);
-
-        // R = L * L^T
-        blasfeo_dpotrf_l(nu[ii], mem->RSQrq[ii], 0, 0, &mem->L, 0, 0);
-        // Q = S^T * L^-T
-        blasfeo_dgecp(nx[ii], nu[ii], mem->RSQrq[ii], nu[ii], 0, &mem->St_copy, 0, 0);
-//        blasfeo_dtrsm_rltn(nx[ii], nu[ii], 1.0, &mem->L, 0, 0, &mem->St_copy, 0, 0, &mem->Q_tilde, 0, 0);
-        blasfeo_dtrsm_rltn(nx[ii], nu[ii], 1.0, &mem->L, 0, 0, &mem->St_copy, 0, 0, &mem->St_copy, 0, 0);
-
-        // Q = S^T * R^-1 * S + delta*I
-        blasfeo_dgese(nx[ii], nx[ii], 0.0, &mem->delta_eye, 0, 0);
-        blasfeo_ddiare(nx[ii], delta, &mem->delta_eye, 0, 0);
-//        blasfeo_dsyrk_ln(nx[ii], nx[ii], 1.0, &mem->Q_tilde, 0, 0, &mem->Q_tilde, 0, 0, 1.0, &mem->delta_eye, 0, 0, mem->RSQrq[ii], nu[ii], nu[ii]);
-        blasfeo_dsyrk_ln(nx[ii], nu[ii], 1.0, &mem->St_copy, 0, 0, &mem->St_copy, 0, 0, 1.0, &mem->delta_eye, 0, 0, mem->RSQrq[ii], nu[ii], nu[ii]);
-
-        // printf("H_tilde\n");
-        // blasfeo_print_dmat(nu+nx, nu+nx, &work->qp_in->RSQrq[i], 0, 0);
-
-        // make symmetric
-//        blasfeo_dtrtr_l(nx[ii], &mem->Q_bar, 0, 0, &mem->Q_bar, 0, 0);
-
-        // TODO take from b !!!!!!
-//        for (jj = 0; jj < nx[ii+1]; jj++)
-//            BLASFEO_DVECEL(&mem->b2, jj) = BLASFEO_DMATEL(mem->BAbt[ii], nu[ii]+nx[ii], jj);
-
-        // TODO nx stage is not consistent with above !!!!!!!
-//        blasfeo_dgemv_n(nx[ii+1], nx[ii+1], 1.0, &mem->Q_bar, 0, 0, &mem->b2, 0, 0.0, &mem->grad, 0, &mem->grad, 0);
-//        blasfeo_dgemv_n(nu[ii]+nx[ii], nx[ii+1], 1.0, mem->BAbt[ii], 0, 0, &mem->grad, 0, 0.0, &mem->b2, 0, &mem->b2, 0);
-
-//        for (jj = 0; jj < nu[ii]+nx[ii]; jj++)
-            // TODO maybe 'b' is a bad naming...
-//            BLASFEO_DMATEL(mem->RSQrq[ii], nu[ii]+nx[ii], jj) = BLASFEO_DMATEL(mem->RSQrq[ii], nu[ii]+nx[ii], jj) + BLASFEO_DVECEL(&mem->b2, jj);
-
-        blasfeo_dgead(nx[ii], nx[ii], -1.0, mem->RSQrq[ii], nu[ii], nu[ii], &mem->Q_bar, 0, 0);
-
-        // make symmetric
-        blasfeo_dtrtr_l(nx[ii], &mem->Q_bar, 0, 0, &mem->Q_bar, 0, 0);
-
-    }
-
-    return;
-}
-
-
-// TODO: implement proper split! Right now, we basically do everything twice.
 
+// lhs: Hessian part of the convexification, which does not depend on the gradient and b;
+// Q_bar of each stage is kept in memory for the gradient correction in regularize_rhs
 void ocp_nlp_reg_convexify_regularize_lhs(void *config, ocp_nlp_reg_dims *dims, void *opts_, void *mem_)
 {
     ocp_nlp_reg_convexify_memory *mem = mem_;
@@ -666,8 +589,8 @@ void ocp_nlp_reg_convexify_regularize_lhs(void *config, ocp_nlp_reg_dims *dims,
 
     double delta = opts->delta;
 
-    // regularize() without updating mem->rq!
-    // blasfeo_drowin(nu[N]+nx[N], 1.0, mem->rq[N], 0, mem->RSQrq[N], nu[N]+nx[N], 0);
+    // TODO regularize R at last stage if needed !!!
+    // TODO fix for nu[N]>0 !!!!!!!!!!
 
     blasfeo_dgecp(nu[N]+nx[N]+1, nu[N]+nx[N], mem->RSQrq[N], 0, 0, &mem->original_RSQrq[N], 0, 0);
 
@@ -678,18 +601,15 @@ void ocp_nlp_reg_convexify_regularize_lhs(void *config, ocp_nlp_reg_dims *dims,
     blasfeo_dgecp(nx[N], nx[N], &mem->Q_tilde, 0, 0, mem->RSQrq[N], nu[N], nu[N]);
     blasfeo_dgead(nx[N], nx[N], -1.0, &mem->Q_tilde, 0, 0, &mem->Q_bar, 0, 0);
     blasfeo_dtrtr_l(nx[N], &mem->Q_bar, 0, 0, &mem->Q_bar, 0, 0);
+    blasfeo_dgecp(nx[N], nx[N], &mem->Q_bar, 0, 0, &mem->Q_bar_stage[N], 0, 0);
 
     for (ii = N-1; ii >= 0; --ii)
     {
-        blasfeo_drowin(nx[ii+1], 1.0, mem->b[ii], 0, mem->BAbt[ii], nu[ii]+nx[ii], 0);
-        // blasfeo_drowin(nu[ii]+nx[ii], 1.0, mem->rq[ii], 0, mem->RSQrq[ii], nu[ii]+nx[ii], 0);
-
         blasfeo_dgecp(nu[ii]+nx[ii]+1, nu[ii]+nx[ii], mem->RSQrq[ii], 0, 0, &mem->original_RSQrq[ii], 0, 0);
 
         blasfeo_dgemm_nt(nu[ii]+nx[ii], nx[ii], nx[ii+1], 1.0, mem->BAbt[ii], 0, 0, &mem->Q_bar, 0, 0, 0.0, &mem->BAQ, 0, 0, &mem->BAQ, 0, 0);
-        blasfeo_dsyrk_ln_mn(nu[ii]+nx[ii]+1, nu[ii]+nx[ii], nx[ii+1], 1.0, mem->BAbt[ii], 0, 0, &mem->BAQ, 0, 0, 1.0, mem->RSQrq[ii], 0, 0, mem->RSQrq[ii], 0, 0);
-
-        // blasfeo_drowex(nu[ii]+nx[ii], 1.0, mem->RSQrq[ii], nu[ii]+nx[ii], 0, mem->rq[ii], 0);
+        // rank nx[ii+1] update to RSQ with BAQ, the gradient row is updated in regularize_rhs
+        blasfeo_dsyrk_ln_mn(nu[ii]+nx[ii], nu[ii]+nx[ii], nx[ii+1], 1.0, mem->BAbt[ii], 0, 0, &mem->BAQ, 0, 0, 1.0, mem->RSQrq[ii], 0, 0, mem->RSQrq[ii], 0, 0);
 
         blasfeo_unpack_dmat(nu[ii], nu[ii], mem->RSQrq[ii], 0, 0, mem->R, nu[ii]);
         acados_eigen_decomposition(nu[ii], mem->R, mem->V, mem->d, mem->e);
@@ -731,6 +651,7 @@ void ocp_nlp_reg_convexify_regularize_lhs(void *config, ocp_nlp_reg_dims *dims,
 
         // make symmetric
         blasfeo_dtrtr_l(nx[ii], &mem->Q_bar, 0, 0, &mem->Q_bar, 0, 0);
+        blasfeo_dgecp(nx[ii], nx[ii], &mem->Q_bar, 0, 0, &mem->Q_bar_stage[ii], 0, 0);
 
     }
 
@@ -739,91 +660,44 @@ void ocp_nlp_reg_convexify_regularize_lhs(void *config, ocp_nlp_reg_dims *dims,
 
 
 
+// rhs: gradient part of the convexification, rq += BA * Q_bar * b,
+// using Q_bar from regularize_lhs
 void ocp_nlp_reg_convexify_regularize_rhs(void *config, ocp_nlp_reg_dims *dims, void *opts_, void *mem_)
 {
     ocp_nlp_reg_convexify_memory *mem = mem_;
-    ocp_nlp_reg_convexify_opts *opts = opts_;
 
-    int ii, jj;
+    int ii;
 
     int *nx = dims->nx;
     int *nu = dims->nu;
     int N = dims->N;
 
-
-    double delta = opts->delta;
-
-    // start from original qp and do it all from scratch
+    // backup original gradient
     for (ii = 0; ii<=N; ii++)
     {
-        blasfeo_dgecp(nu[ii]+nx[ii]+1, nu[ii]+nx[ii], &mem->original_RSQrq[ii], 0, 0, mem->RSQrq[ii], 0, 0);
+        blasfeo_drowin(nu[ii]+nx[ii], 1.0, mem->rq[ii], 0, &mem->original_RSQrq[ii], nu[ii]+nx[ii], 0);
     }
 
     blasfeo_drowin(nu[N]+nx[N], 1.0, mem->rq[N], 0, mem->RSQrq[N], nu[N]+nx[N], 0);
-    blasfeo_dgecp(nu[N]+nx[N]+1, nu[N]+nx[N], mem->RSQrq[N], 0, 0, &mem->original_RSQrq[N], 0, 0);
-
-    blasfeo_dgese(nx[N], nx[N], 0.0, &mem->delta_eye, 0, 0);
-    blasfeo_ddiare(nx[N], delta, &mem->delta_eye, 0, 0);
-    blasfeo_dgecp(nx[N], nx[N], &mem->delta_eye, 0, 0, &mem->Q_tilde, 0, 0);
-    blasfeo_dgecp(nx[N], nx[N], mem->RSQrq[N], nu[N], nu[N], &mem->Q_bar, 0, 0);
-    blasfeo_dgecp(nx[N], nx[N], &mem->Q_tilde, 0, 0, mem->RSQrq[N], nu[N], nu[N]);
-    blasfeo_dgead(nx[N], nx[N], -1.0, &mem->Q_tilde, 0, 0, &mem->Q_bar, 0, 0);
-    blasfeo_dtrtr_l(nx[N], &mem->Q_bar, 0, 0, &mem->Q_bar, 0, 0);
 
     for (ii = N-1; ii >= 0; --ii)
     {
         blasfeo_drowin(nx[ii+1], 1.0, mem->b[ii], 0, mem->BAbt[ii], nu[ii]+nx[ii], 0);
-        blasfeo_drowin(nu[ii]+nx[ii], 1.0, mem->rq[ii], 0, mem->RSQrq[ii], nu[ii]+nx[ii], 0);
-
-        // blasfeo_dgecp(nu[ii]+nx[ii]+1, nu[ii]+nx[ii], mem->RSQrq[ii], 0, 0, &mem->original_RSQrq[ii], 0, 0);
-
-        blasfeo_dgemm_nt(nu[ii]+nx[ii], nx[ii], nx[ii+1], 1.0, mem->BAbt[ii], 0, 0, &mem->Q_bar, 0, 0, 0.0, &mem->BAQ, 0, 0, &mem->BAQ, 0, 0);
-        blasfeo_dsyrk_ln_mn(nu[ii]+nx[ii]+1, nu[ii]+nx[ii], nx[ii+1], 1.0, mem->BAbt[ii], 0, 0, &mem->BAQ, 0, 0, 1.0, mem->RSQrq[ii], 0, 0, mem->RSQrq[ii], 0, 0);
-
-        blasfeo_drowex(nu[ii]+nx[ii], 1.0, mem->RSQrq[ii], nu[ii]+nx[ii], 0, mem->rq[ii], 0);
-
-        blasfeo_unpack_dmat(nu[ii], nu[ii], mem->RSQrq[ii], 0, 0, mem->R, nu[ii]);
-        acados_eigen_decomposition(nu[ii], mem->R, mem->V, mem->d, mem->e);
-
-        bool needs_regularization = false;
-        for (jj = 0; jj < nu[ii]; jj++)
-            if (mem->d[jj] < 1e-10)
-                needs_regularization = true;
-
-        if (needs_regularization)
-        {
-            blasfeo_dgecp(nu[ii]+nx[ii], nu[ii]+nx[ii], mem->RSQrq[ii], 0, 0, &mem->tmp_RSQ, 0, 0);
-
-            blasfeo_unpack_dmat(nu[ii]+nx[ii], nu[ii]+nx[ii], mem->RSQrq[ii], 0, 0, mem->reg_hess, nu[ii]+nx[ii]);
-            acados_project(nu[ii]+nx[ii], mem->reg_hess, mem->V, mem->d, mem->e, 1e-4);
-            blasfeo_pack_dmat(nu[ii]+nx[ii], nu[ii]+nx[ii], mem->reg_hess, nu[ii]+nx[ii], mem->RSQrq[ii], 0, 0);
-
-            blasfeo_dgead(nu[ii]+nx[ii], nu[ii]+nx[ii], -1.0, mem->RSQrq[ii], 0, 0, &mem->tmp_RSQ, 0, 0);
-            blasfeo_dgead(nu[ii]+nx[ii], nu[ii]+nx[ii], -1.0, &mem->tmp_RSQ, 0, 0, &mem->original_RSQrq[ii], 0, 0);
-        }
 
-        // backup Q
-        blasfeo_dgecp(nx[ii], nx[ii], mem->RSQrq[ii], nu[ii], nu[ii], &mem->Q_bar, 0, 0);
+        // rq += BA * Q_bar * b
+        blasfeo_dgemv_n(nx[ii+1], nx[ii+1], 1.0, &mem->Q_bar_stage[ii+1], 0, 0, mem->b[ii], 0, 0.0, &mem->tmp_nuxM, 0, &mem->tmp_nuxM, 0);
+        blasfeo_dgemv_n(nu[ii]+nx[ii], nx[ii+1], 1.0, mem->BAbt[ii], 0, 0, &mem->tmp_nuxM, 0, 1.0, mem->rq[ii], 0, mem->rq[ii], 0);
 
-        // R = L * L^T
-        blasfeo_dpotrf_l(nu[ii], mem->RSQrq[ii], 0, 0, &mem->L, 0, 0);
-        // Q = S^T * L^-T
-        blasfeo_dgecp(nx[ii], nu[ii], mem->RSQrq[ii], nu[ii], 0, &mem->St_copy, 0, 0);
-//        blasfeo_dtrsm_rltn(nx[ii], nu[ii], 1.0, &mem->L, 0, 0, &mem->St_copy, 0, 0, &mem->Q_tilde, 0, 0);
-        blasfeo_dtrsm_rltn(nx[ii], nu[ii], 1.0, &mem->L, 0, 0, &mem->St_copy, 0, 0, &mem->St_copy, 0, 0);
-
-        // Q = S^T * R^-1 * S + delta*I
-        blasfeo_dgese(nx[ii], nx[ii], 0.0, &mem->delta_eye, 0, 0);
-        blasfeo_ddiare(nx[ii], delta, &mem->delta_eye, 0, 0);
-//        blasfeo_dsyrk_ln(nx[ii], nx[ii], 1.0, &mem->Q_tilde, 0, 0, &mem->Q_tilde, 0, 0, 1.0, &mem->delta_eye, 0, 0, mem->RSQrq[ii], nu[ii], nu[ii]);
-        blasfeo_dsyrk_ln(nx[ii], nu[ii], 1.0, &mem->St_copy, 0, 0, &mem->St_copy, 0, 0, 1.0, &mem->delta_eye, 0, 0, mem->RSQrq[ii], nu[ii], nu[ii]);
+        blasfeo_drowin(nu[ii]+nx[ii], 1.0, mem->rq[ii], 0, mem->RSQrq[ii], nu[ii]+nx[ii], 0);
+    }
+}
 
-        blasfeo_dgead(nx[ii], nx[ii], -1.0, mem->RSQrq[ii], nu[ii], nu[ii], &mem->Q_bar, 0, 0);
 
-        // make symmetric
-        blasfeo_dtrtr_l(nx[ii], &mem->Q_bar, 0, 0, &mem->Q_bar, 0, 0);
 
-    }
+void ocp_nlp_reg_convexify_regularize(void *config, ocp_nlp_reg_dims *dims, void *opts_, void *mem_)
+{
+    ocp_nlp_reg_convexify_regularize_lhs(config, dims, opts_, mem_);
+    ocp_nlp_reg_convexify_regularize_rhs(config, dims, opts_, mem_);
 }
 
 
@@ -927,8 +801,10 @@ void ocp_nlp_reg_convexify_config_initialize_default(ocp_nlp_reg_config *config)
     config->memory_set_ux_ptr = &ocp_nlp_reg_convexify_memory_set_ux_ptr;
     config->memory_set_pi_ptr = &ocp_nlp_reg_convexify_memory_set_pi_ptr;
     config->memory_set_lam_ptr = &ocp_nlp_reg_convexify_memory_set_lam_ptr;
+    config->memory_state_size = &ocp_nlp_reg_convexify_memory_state_size;
+    config->memory_state_get = &ocp_nlp_reg_convexify_memory_state_get;
+    config->memory_state_set = &ocp_nlp_reg_convexify_memory_state_set;
     // functions
-    // TODO: fix split
     config->regularize = &ocp_nlp_reg_convexify_regularize;
     config->regularize_lhs = &ocp_nlp_reg_convexify_regularize_lhs;
     config->regularize_rhs = &ocp_nlp_reg_convexify_regularize_rhs;
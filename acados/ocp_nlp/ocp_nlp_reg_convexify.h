@@ -98,6 +98,7 @@ typedef struct {
     struct blasfeo_dmat St_copy;
 
     struct blasfeo_dmat *original_RSQrq;
+    struct blasfeo_dmat *Q_bar_stage; // Q_bar of each stage, computed in regularize_lhs
     struct blasfeo_dmat tmp_RSQ;
 
     struct blasfeo_dvec tmp_nuxM;
@@ -123,6 +124,12 @@ typedef struct {
 acados_size_t ocp_nlp_reg_convexify_memory_calculate_size(void *config, ocp_nlp_reg_dims *dims, void *opts);
 //
 void *ocp_nlp_reg_convexify_assign_memory(void *config, ocp_nlp_reg_dims *dims, void *opts, void *raw_memory);
+//
+acados_size_t ocp_nlp_reg_convexify_memory_state_size(void *config, ocp_nlp_reg_dims *dims, void *memory);
+//
+void ocp_nlp_reg_convexify_memory_state_get(void *config, ocp_nlp_reg_dims *dims, void *memory, double *state);
+//
+void ocp_nlp_reg_convexify_memory_state_set(void *config, ocp_nlp_reg_dims *dims, void *memory, double *state);
 
 /************************************************
  * workspace
@@ -0,0 +1,508 @@
+/*
+ * Copyright (c) The acados authors.
+ *
+ * This file is part of acados.
+ *
+ * The 2-Clause BSD License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.;
+ */
+
+
+#include "acados/ocp_nlp/ocp_nlp_reg_inertia.h"
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+#include <math.h>
+
+#include "acados/ocp_nlp/ocp_nlp_reg_common.h"
+#include "acados/utils/math.h"
+#include "acados/utils/mem.h"
+
+#include "blasfeo_d_aux.h"
+#include "blasfeo_d_blas.h"
+
+
+
+/************************************************
+ * opts
+ ************************************************/
+
+acados_size_t ocp_nlp_reg_inertia_opts_calculate_size(void)
+{
+    return sizeof(ocp_nlp_reg_inertia_opts);
+}
+
+
+
+void *ocp_nlp_reg_inertia_opts_assign(void *raw_memory)
+{
+    return raw_memory;
+}
+
+
+
+void ocp_nlp_reg_inertia_opts_initialize_default(void *config_, ocp_nlp_reg_dims *dims, void *opts_)
+{
+    ocp_nlp_reg_inertia_opts *opts = opts_;
+    opts->epsilon = 1e-4;
+    opts->min_epsilon = 1e-20;
+    opts->max_epsilon = 1e40;
+    return;
+}
+
+
+
+void ocp_nlp_reg_inertia_opts_set(void *config_, void *opts_, const char *field, void* value)
+{
+
+    ocp_nlp_reg_inertia_opts *opts = opts_;
+    if (!strcmp(field, "epsilon"))
+    {
+        double *d_ptr = value;
+        opts->epsilon = *d_ptr;
+    }
+    else if (!strcmp(field, "min_epsilon"))
+    {
+        double *d_ptr = value;
+        opts->min_epsilon = *d_ptr;
+    }
+    else if (!strcmp(field, "max_epsilon"))
+    {
+        double *d_ptr = value;
+        opts->max_epsilon = *d_ptr;
+    }
+    else
+    {
+        printf("\nerror: field %s not available in ocp_nlp_reg_inertia_opts_set\n", field);
+        exit(1);
+    }
+
+    return;
+}
+
+
+
+/************************************************
+ * memory
+ ************************************************/
+
+acados_size_t ocp_nlp_reg_inertia_memory_calculate_size(void *config_, ocp_nlp_reg_dims *dims, void *opts_)
+{
+    int *nx = dims->nx;
+    int *nu = dims->nu;
+    int N = dims->N;
+
+    int ii;
+
+    int nuM = nu[0];
+    int nxM = nx[0];
+    for(ii=1; ii<=N; ii++)
+    {
+        nuM = nu[ii]>nuM ? nu[ii] : nuM;
+        nxM = nx[ii]>nxM ? nx[ii] : nxM;
+    }
+    int nuxM = nuM+nxM;
+
+    acados_size_t size = 0;
+
+    size += sizeof(ocp_nlp_reg_inertia_memory);
+
+    size += (N+1)*sizeof(double); // shift
+    size += (2*N+1)*sizeof(struct blasfeo_dmat *); // RSQrq BAbt
+
+    size += 1 * 64; // blasfeo_mem align
+
+    size += blasfeo_memsize_dmat(nxM, nxM);   // P
+    size += blasfeo_memsize_dmat(nuxM, nxM);  // BAtP
+    size += blasfeo_memsize_dmat(nuxM, nuxM); // M
+    size += blasfeo_memsize_dmat(nuxM, nuM);  // L
+
+    return size;
+}
+
+
+
+void *ocp_nlp_reg_inertia_memory_assign(void *config_, ocp_nlp_reg_dims *dims, void *opts_, void *raw_memory)
+{
+    int *nx = dims->nx;
+    int *nu = dims->nu;
+    int N = dims->N;
+
+    int ii;
+
+    int nuM = nu[0];
+    int nxM = nx[0];
+    for(ii=1; ii<=N; ii++)
+    {
+        nuM = nu[ii]>nuM ? nu[ii] : nuM;
+        nxM = nx[ii]>nxM ? nx[ii] : nxM;
+    }
+    int nuxM = nuM+nxM;
+
+    char *c_ptr = (char *) raw_memory;
+
+    ocp_nlp_reg_inertia_memory *mem = (ocp_nlp_reg_inertia_memory *) c_ptr;
+    c_ptr += sizeof(ocp_nlp_reg_inertia_memory);
+
+    mem->shift = (double *) c_ptr;
+    c_ptr += (N+1)*sizeof(double); // shift
+
+    mem->RSQrq = (struct blasfeo_dmat **) c_ptr;
+    c_ptr += (N+1)*sizeof(struct blasfeo_dmat *); // RSQrq
+
+    mem->BAbt = (struct blasfeo_dmat **) c_ptr;
+    c_ptr += N*sizeof(struct blasfeo_dmat *); // BAbt
+
+    align_char_to(64, &c_ptr);
+
+    assign_and_advance_blasfeo_dmat_mem(nxM, nxM, &mem->P, &c_ptr);
+    assign_and_advance_blasfeo_dmat_mem(nuxM, nxM, &mem->BAtP, &c_ptr);
+    assign_and_advance_blasfeo_dmat_mem(nuxM, nuxM, &mem->M, &c_ptr);
+    assign_and_advance_blasfeo_dmat_mem(nuxM, nuM, &mem->L, &c_ptr);
+
+    for(ii=0; ii<=N; ii++)
+    {
+        mem->shift[ii] = 0.0;
+    }
+    mem->shift_x0 = 0.0;
+    mem->num_shifted = 0;
+
+    assert((char *) mem + ocp_nlp_reg_inertia_memory_calculate_size(config_, dims, opts_) >= c_ptr);
+
+    return mem;
+}
+
+
+
+void ocp_nlp_reg_inertia_memory_set_RSQrq_ptr(ocp_nlp_reg_dims *dims, struct blasfeo_dmat *RSQrq, void *memory_)
+{
+    ocp_nlp_reg_inertia_memory *memory = memory_;
+
+    int ii;
+
+    int N = dims->N;
+
+    for(ii=0; ii<=N; ii++)
+    {
+        memory->RSQrq[ii] = RSQrq+ii;
+    }
+
+    return;
+}
+
+
+
+void ocp_nlp_reg_inertia_memory_set_rq_ptr(ocp_nlp_reg_dims *dims, struct blasfeo_dvec *rq, void *memory_)
+{
+    return;
+}
+
+
+
+void ocp_nlp_reg_inertia_memory_set_BAbt_ptr(ocp_nlp_reg_dims *dims, struct blasfeo_dmat *BAbt, void *memory_)
+{
+    ocp_nlp_reg_inertia_memory *memory = memory_;
+
+    int ii;
+
+    int N = dims->N;
+
+    for(ii=0; ii<N; ii++)
+    {
+        memory->BAbt[ii] = BAbt+ii;
+    }
+
+    return;
+}
+
+
+
+void ocp_nlp_reg_inertia_memory_set_b_ptr(ocp_nlp_reg_dims *dims, struct blasfeo_dvec *b, void *memory_)
+{
+    return;
+}
+
+
+
+void ocp_nlp_reg_inertia_memory_set_idxb_ptr(ocp_nlp_reg_dims *dims, int **idxb, void *memory_)
+{
+    return;
+}
+
+
+
+void ocp_nlp_reg_inertia_memory_set_DCt_ptr(ocp_nlp_reg_dims *dims, struct blasfeo_dmat *DCt, void *memory_)
+{
+    return;
+}
+
+
+
+void ocp_nlp_reg_inertia_memory_set_ux_ptr(ocp_nlp_reg_dims *dims, struct blasfeo_dvec *ux, void *memory_)
+{
+    return;
+}
+
+
+
+void ocp_nlp_reg_inertia_memory_set_pi_ptr(ocp_nlp_reg_dims *dims, struct blasfeo_dvec *pi, void *memory_)
+{
+    return;
+}
+
+
+
+void ocp_nlp_reg_inertia_memory_set_lam_ptr(ocp_nlp_reg_dims *dims, struct blasfeo_dvec *lam, void *memory_)
+{
+    return;
+}
+
+
+
+// the shifts of the last call, which warm start the next one
+acados_size_t ocp_nlp_reg_inertia_memory_state_size(void *config, ocp_nlp_reg_dims *dims, void *memory_)
+{
+    return dims->N + 3;
+}
+
+
+
+void ocp_nlp_reg_inertia_memory_state_get(void *config, ocp_nlp_reg_dims *dims, void *memory_, double *state)
+{
+    ocp_nlp_reg_inertia_memory *mem = memory_;
+    int N = dims->N;
+
+    for (int ii = 0; ii <= N; ii++)
+        state[ii] = mem->shift[ii];
+    state[N+1] = mem->shift_x0;
+    state[N+2] = mem->num_shifted;
+}
+
+
+
+void ocp_nlp_reg_inertia_memory_state_set(void *config, ocp_nlp_reg_dims *dims, void *memory_, double *state)
+{
+    ocp_nlp_reg_inertia_memory *mem = memory_;
+    int N = dims->N;
+
+    for (int ii = 0; ii <= N; ii++)
+        mem->shift[ii] = state[ii];
+    mem->shift_x0 = state[N+1];
+    mem->num_shifted = (int) state[N+2];
+}
+
+
+
+void ocp_nlp_reg_inertia_memory_set(void *config_, ocp_nlp_reg_dims *dims, void *memory_, char *field, void *value)
+{
+    // TODO: remove this function in all regularizaiton modules
+    printf("\nerror: field %s not available in ocp_nlp_reg_inertia_set\n", field);
+    exit(1);
+
+    return;
+}
+
+
+
+/************************************************
+ * functions
+ ************************************************/
+
+// check if the first n diagonal entries of the Cholesky factor are positive;
+// blasfeo sets the diagonal entry to zero for non-positive pivots
+static bool ocp_nlp_reg_inertia_factorization_ok(int n, struct blasfeo_dmat *L)
+{
+    for (int jj = 0; jj < n; jj++)
+    {
+        if (!(BLASFEO_DMATEL(L, jj, jj) > 0.0))
+            return false;
+    }
+    return true;
+}
+
+
+
+// factorize the first n columns of the m x m matrix M into L and, if this breaks down,
+// increase the diagonal of the leading n x n block of M until it succeeds;
+// returns the shift, which is warm started from shift_prev
+static double ocp_nlp_reg_inertia_shift(int m, int n, struct blasfeo_dmat *M, struct blasfeo_dmat *L,
+                                        double shift_prev, ocp_nlp_reg_inertia_opts *opts)
+{
+    double delta, delta_old;
+
+    blasfeo_dpotrf_l_mn(m, n, M, 0, 0, L, 0, 0);
+    if (ocp_nlp_reg_inertia_factorization_ok(n, L))
+        return 0.0;
+
+    // first trial shift, warm started from the previous call
+    if (shift_prev > 0.0)
+        delta = MAX(opts->min_epsilon, shift_prev / 3.0);
+    else
+        delta = opts->epsilon;
+
+    delta_old = 0.0;
+    while (1)
+    {
+        blasfeo_ddiare(n, delta - delta_old, M, 0, 0);
+        blasfeo_dpotrf_l_mn(m, n, M, 0, 0, L, 0, 0);
+        if (ocp_nlp_reg_inertia_factorization_ok(n, L) || delta >= opts->max_epsilon)
+            break;
+        delta_old = delta;
+        delta = shift_prev > 0.0 ? 8.0 * delta : 100.0 * delta;
+    }
+    return delta;
+}
+
+
+
+// Backward Riccati recursion on the equality constrained QP, which detects
+// negative curvature of the reduced Hessian stage by stage, cf. the inertia
+// correction in IPOPT: wherever the factorization of R + B' * P * B breaks down,
+// the smallest trial shift delta*I on R that restores it is added to the QP Hessian.
+// If the initial state is not fixed by bounds, the cost-to-go Hessian P_0 is checked as
+// well and the shift is added to the Q block of stage 0.
+void ocp_nlp_reg_inertia_regularize(void *config, ocp_nlp_reg_dims *dims, void *opts_, void *mem_)
+{
+    ocp_nlp_reg_inertia_memory *mem = (ocp_nlp_reg_inertia_memory *) mem_;
+    ocp_nlp_reg_inertia_opts *opts = opts_;
+
+    int ii;
+
+    int *nx = dims->nx;
+    int *nu = dims->nu;
+    int N = dims->N;
+    int nux;
+    double delta;
+
+    mem->num_shifted = 0;
+
+    for(ii=N; ii>=0; ii--)
+    {
+        nux = nu[ii]+nx[ii];
+
+        // make symmetric
+        blasfeo_dtrtr_l(nux, mem->RSQrq[ii], 0, 0, mem->RSQrq[ii], 0, 0);
+
+        // M = RSQ + BAt * P * BA
+        if (ii < N)
+        {
+            blasfeo_dgemm_nn(nux, nx[ii+1], nx[ii+1], 1.0, mem->BAbt[ii], 0, 0, &mem->P, 0, 0, 0.0, &mem->BAtP, 0, 0, &mem->BAtP, 0, 0);
+            blasfeo_dgemm_nt(nux, nux, nx[ii+1], 1.0, &mem->BAtP, 0, 0, mem->BAbt[ii], 0, 0, 1.0, mem->RSQrq[ii], 0, 0, &mem->M, 0, 0);
+        }
+        else
+        {
+            blasfeo_dgecp(nux, nux, mem->RSQrq[ii], 0, 0, &mem->M, 0, 0);
+        }
+
+        if (nu[ii] == 0)
+        {
+            blasfeo_dgecp(nx[ii], nx[ii], &mem->M, 0, 0, &mem->P, 0, 0);
+            mem->shift[ii] = 0.0;
+            continue;
+        }
+
+        delta = ocp_nlp_reg_inertia_shift(nux, nu[ii], &mem->M, &mem->L, mem->shift[ii], opts);
+        if (delta > 0.0)
+        {
+            blasfeo_ddiare(nu[ii], delta, mem->RSQrq[ii], 0, 0);
+            mem->num_shifted++;
+        }
+        mem->shift[ii] = delta;
+
+        // P = Q + A' * P * A - S' * R^-1 * S
+        blasfeo_dsyrk_ln(nx[ii], nu[ii], -1.0, &mem->L, nu[ii], 0, &mem->L, nu[ii], 0, 1.0, &mem->M, nu[ii], nu[ii], &mem->P, 0, 0);
+        blasfeo_dtrtr_l(nx[ii], &mem->P, 0, 0, &mem->P, 0, 0);
+    }
+
+    // free initial state: x0 is an optimization variable, so P_0 has to be positive definite too;
+    // a shift on P_0 equals the same shift on the Q block of stage 0
+    if (nx[0] > 0 && dims->nbx[0] < nx[0])
+    {
+        // BAtP is only needed inside the recursion, use it as workspace for the factor of P_0
+        delta = ocp_nlp_reg_inertia_shift(nx[0], nx[0], &mem->P, &mem->BAtP, mem->shift_x0, opts);
+        if (delta > 0.0)
+        {
+            blasfeo_ddiare(nx[0], delta, mem->RSQrq[0], nu[0], nu[0]);
+            mem->num_shifted++;
+        }
+        mem->shift_x0 = delta;
+    }
+}
+
+
+void ocp_nlp_reg_inertia_regularize_lhs(void *config, ocp_nlp_reg_dims *dims, void *opts_, void *mem_)
+{
+    ocp_nlp_reg_inertia_regularize(config, dims, opts_, mem_);
+}
+
+
+void ocp_nlp_reg_inertia_regularize_rhs(void *config, ocp_nlp_reg_dims *dims, void *opts_, void *mem_)
+{
+    return;
+}
+
+
+void ocp_nlp_reg_inertia_correct_dual_sol(void *config, ocp_nlp_reg_dims *dims, void *opts_, void *mem_)
+{
+    return;
+}
+
+
+
+void ocp_nlp_reg_inertia_config_initialize_default(ocp_nlp_reg_config *config)
+{
+    // dims
+    config->dims_calculate_size = &ocp_nlp_reg_dims_calculate_size;
+    config->dims_assign = &ocp_nlp_reg_dims_assign;
+    config->dims_set = &ocp_nlp_reg_dims_set;
+    // opts
+    config->opts_calculate_size = &ocp_nlp_reg_inertia_opts_calculate_size;
+    config->opts_assign = &ocp_nlp_reg_inertia_opts_assign;
+    config->opts_initialize_default = &ocp_nlp_reg_inertia_opts_initialize_default;
+    config->opts_set = &ocp_nlp_reg_inertia_opts_set;
+    // memory
+    config->memory_calculate_size = &ocp_nlp_reg_inertia_memory_calculate_size;
+    config->memory_assign = &ocp_nlp_reg_inertia_memory_assign;
+    config->memory_set = &ocp_nlp_reg_inertia_memory_set;
+    config->memory_set_RSQrq_ptr = &ocp_nlp_reg_inertia_memory_set_RSQrq_ptr;
+    config->memory_set_rq_ptr = &ocp_nlp_reg_inertia_memory_set_rq_ptr;
+    config->memory_set_BAbt_ptr = &ocp_nlp_reg_inertia_memory_set_BAbt_ptr;
+    config->memory_set_b_ptr = &ocp_nlp_reg_inertia_memory_set_b_ptr;
+    config->memory_set_idxb_ptr = &ocp_nlp_reg_inertia_memory_set_idxb_ptr;
+    config->memory_set_DCt_ptr = &ocp_nlp_reg_inertia_memory_set_DCt_ptr;
+    config->memory_set_ux_ptr = &ocp_nlp_reg_inertia_memory_set_ux_ptr;
+    config->memory_set_pi_ptr = &ocp_nlp_reg_inertia_memory_set_pi_ptr;
+    config->memory_set_lam_ptr = &ocp_nlp_reg_inertia_memory_set_lam_ptr;
+    config->memory_state_size = &ocp_nlp_reg_inertia_memory_state_size;
+    config->memory_state_get = &ocp_nlp_reg_inertia_memory_state_get;
+    config->memory_state_set = &ocp_nlp_reg_inertia_memory_state_set;
+    // functions
+    config->regularize = &ocp_nlp_reg_inertia_regularize;
+    config->regularize_rhs = &ocp_nlp_reg_inertia_regularize_rhs;
+    config->regularize_lhs = &ocp_nlp_reg_inertia_regularize_lhs;
+    config->correct_dual_sol = &ocp_nlp_reg_inertia_correct_dual_sol;
+}
+
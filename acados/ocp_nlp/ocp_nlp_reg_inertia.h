@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) The acados authors.
+ *
+ * This file is part of acados.
+ *
+ * The 2-Clause BSD License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.;
+ */
+
+
+/// \addtogroup ocp_nlp
+/// @{
+/// \addtogroup ocp_nlp_reg
+/// @{
+
+#ifndef ACADOS_OCP_NLP_OCP_NLP_REG_INERTIA_H_
+#define ACADOS_OCP_NLP_OCP_NLP_REG_INERTIA_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+
+// blasfeo
+#include "blasfeo_common.h"
+
+// acados
+#include "acados/ocp_nlp/ocp_nlp_reg_common.h"
+
+
+
+/************************************************
+ * dims
+ ************************************************/
+
+// use the functions in ocp_nlp_reg_common
+
+/************************************************
+ * options
+ ************************************************/
+
+typedef struct
+{
+    double epsilon;      // first trial shift
+    double min_epsilon;  // smallest shift used when warm starting from the previous shift
+    double max_epsilon;  // largest trial shift
+} ocp_nlp_reg_inertia_opts;
+
+//
+acados_size_t ocp_nlp_reg_inertia_opts_calculate_size(void);
+//
+void *ocp_nlp_reg_inertia_opts_assign(void *raw_memory);
+//
+void ocp_nlp_reg_inertia_opts_initialize_default(void *config_, ocp_nlp_reg_dims *dims, void *opts_);
+//
+void ocp_nlp_reg_inertia_opts_set(void *config_, void *opts_, const char *field, void* value);
+
+
+
+/************************************************
+ * memory
+ ************************************************/
+
+typedef struct
+{
+    struct blasfeo_dmat P;   // cost-to-go Hessian of the next stage
+    struct blasfeo_dmat BAtP;
+    struct blasfeo_dmat M;   // RSQ + BAt * P * BA
+    struct blasfeo_dmat L;
+
+    double *shift;           // shift of the last call, per stage
+    double shift_x0;         // shift of the last call on the Q block of stage 0, if x0 is free
+    int num_shifted;         // number of stages shifted in the last call
+
+    struct blasfeo_dmat **RSQrq;  // pointer to RSQrq in qp_in
+    struct blasfeo_dmat **BAbt;   // pointer to BAbt in qp_in
+} ocp_nlp_reg_inertia_memory;
+
+//
+acados_size_t ocp_nlp_reg_inertia_memory_calculate_size(void *config, ocp_nlp_reg_dims *dims, void *opts);
+//
+void *ocp_nlp_reg_inertia_memory_assign(void *config, ocp_nlp_reg_dims *dims, void *opts, void *raw_memory);
+//
+acados_size_t ocp_nlp_reg_inertia_memory_state_size(void *config, ocp_nlp_reg_dims *dims, void *memory);
+//
+void ocp_nlp_reg_inertia_memory_state_get(void *config, ocp_nlp_reg_dims *dims, void *memory, double *state);
+//
+void ocp_nlp_reg_inertia_memory_state_set(void *config, ocp_nlp_reg_dims *dims, void *memory, double *state);
+
+/************************************************
+ * functions
+ ************************************************/
+
+//
+void ocp_nlp_reg_inertia_config_initialize_default(ocp_nlp_reg_config *config);
+
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif  // ACADOS_OCP_NLP_OCP_NLP_REG_INERTIA_H_
+/// @}
+/// @}
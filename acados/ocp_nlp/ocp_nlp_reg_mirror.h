@@ -67,6 +67,7 @@ typedef struct
     double min_epsilon;
     bool adaptive_eps;
     double max_cond_block;
+    bool pd_check; // skip stages which are already sufficiently positive definite
 } ocp_nlp_reg_mirror_opts;
 
 //
@@ -86,10 +87,12 @@ void ocp_nlp_reg_mirror_opts_set(void *config_, void *opts_, const char *field,
 
 typedef struct
 {
-    double *reg_hess; // TODO move to workspace
-    double *V; // TODO move to workspace
-    double *d; // TODO move to workspace
-    double *e; // TODO move to workspace
+    // per stage, such that the stages can be regularized in parallel
+    double **reg_hess; // TODO move to workspace
+    double **V; // TODO move to workspace
+    double **d; // TODO move to workspace
+    double **e; // TODO move to workspace
+    struct blasfeo_dmat *L; // Cholesky factor for the positive definiteness check
 
     // giaf's
     struct blasfeo_dmat **RSQrq;  // pointer to RSQrq in qp_in
@@ -38,6 +38,7 @@
 
 #include "acados/ocp_nlp/ocp_nlp_reg_common.h"
 #include "acados/utils/math.h"
+#include "acados/utils/mem.h"
 
 #include "blasfeo_d_aux.h"
 #include "blasfeo_d_blas.h"
@@ -70,6 +71,7 @@ void ocp_nlp_reg_project_opts_initialize_default(void *config_, ocp_nlp_reg_dims
     opts->min_epsilon = 1e-8;
     opts->adaptive_eps = false;
     opts->max_cond_block = 1e7;
+    opts->pd_check = true;
 
     return;
 }
@@ -101,6 +103,11 @@ void ocp_nlp_reg_project_opts_set(void *config_, void *opts_, const char *field,
         bool *b_ptr = value;
         opts->adaptive_eps = *b_ptr;
     }
+    else if (!strcmp(field, "pd_check"))
+    {
+        bool *b_ptr = value;
+        opts->pd_check = *b_ptr;
+    }
     else
     {
         printf("\nerror: field %s not available in ocp_nlp_reg_project_opts_set\n", field);
@@ -122,23 +129,26 @@ acados_size_t ocp_nlp_reg_project_memory_calculate_size(void *config_, ocp_nlp_r
     int *nu = dims->nu;
     int N = dims->N;
 
-    int ii;
-
-    int nuxM = nu[0]+nx[0];
-    for(ii=1; ii<=N; ii++)
-    {
-        nuxM = nu[ii]+nx[ii]>nuxM ? nu[ii]+nx[ii] : nuxM;
-    }
+    int ii, nux;
 
     acados_size_t size = 0;
 
     size += sizeof(ocp_nlp_reg_project_memory);
 
-    size += nuxM*nuxM*sizeof(double);  // reg_hess
-    size += nuxM*nuxM*sizeof(double);  // V
-    size += 2*nuxM*sizeof(double);     // d e
+    size += (N+1)*sizeof(struct blasfeo_dmat); // L
+    size += 4*(N+1)*sizeof(double *);  // reg_hess V d e
     size += (N+1)*sizeof(struct blasfeo_dmat *); // RSQrq
 
+    for(ii=0; ii<=N; ii++)
+    {
+        nux = nu[ii]+nx[ii];
+        size += 2*nux*nux*sizeof(double);  // reg_hess V
+        size += 2*nux*sizeof(double);      // d e
+        size += blasfeo_memsize_dmat(nux, nux); // L
+    }
+
+    size += 1 * 64; // blasfeo_mem align
+
     return size;
 }
 
@@ -150,34 +160,56 @@ void *ocp_nlp_reg_project_memory_assign(void *config_, ocp_nlp_reg_dims *dims, v
     int *nu = dims->nu;
     int N = dims->N;
 
-    int ii;
-
-    int nuxM = nu[0]+nx[0];
-    for(ii=1; ii<=N; ii++)
-    {
-        nuxM = nu[ii]+nx[ii]>nuxM ? nu[ii]+nx[ii] : nuxM;
-    }
+    int ii, nux;
 
     char *c_ptr = (char *) raw_memory;
 
     ocp_nlp_reg_project_memory *mem = (ocp_nlp_reg_project_memory *) c_ptr;
     c_ptr += sizeof(ocp_nlp_reg_project_memory);
 
-    mem->reg_hess = (double *) c_ptr;
-    c_ptr += nuxM*nuxM*sizeof(double);  // reg_hess
+    mem->L = (struct blasfeo_dmat *) c_ptr;
+    c_ptr += (N+1)*sizeof(struct blasfeo_dmat); // L
+
+    mem->reg_hess = (double **) c_ptr;
+    c_ptr += (N+1)*sizeof(double *); // reg_hess
 
-    mem->V = (double *) c_ptr;
-    c_ptr += nuxM*nuxM*sizeof(double);  // V
+    mem->V = (double **) c_ptr;
+    c_ptr += (N+1)*sizeof(double *); // V
 
-    mem->d = (double *) c_ptr;
-    c_ptr += nuxM*sizeof(double); // d
+    mem->d = (double **) c_ptr;
+    c_ptr += (N+1)*sizeof(double *); // d
 
-    mem->e = (double *) c_ptr;
-    c_ptr += nuxM*sizeof(double); // e
+    mem->e = (double **) c_ptr;
+    c_ptr += (N+1)*sizeof(double *); // e
 
     mem->RSQrq = (struct blasfeo_dmat **) c_ptr;
     c_ptr += (N+1)*sizeof(struct blasfeo_dmat *); // RSQrq
 
+    for(ii=0; ii<=N; ii++)
+    {
+        nux = nu[ii]+nx[ii];
+
+        mem->reg_hess[ii] = (double *) c_ptr;
+        c_ptr += nux*nux*sizeof(double); // reg_hess
+
+        mem->V[ii] = (double *) c_ptr;
+        c_ptr += nux*nux*sizeof(double); // V
+
+        mem->d[ii] = (double *) c_ptr;
+        c_ptr += nux*sizeof(double); // d
+
+        mem->e[ii] = (double *) c_ptr;
+        c_ptr += nux*sizeof(double); // e
+    }
+
+    align_char_to(64, &c_ptr);
+
+    for(ii=0; ii<=N; ii++)
+    {
+        nux = nu[ii]+nx[ii];
+        assign_and_advance_blasfeo_dmat_mem(nux, nux, mem->L+ii, &c_ptr);
+    }
+
     assert((char *) mem + ocp_nlp_reg_project_memory_calculate_size(config_, dims, opts_) >= c_ptr);
 
     return mem;
@@ -290,31 +322,20 @@ void ocp_nlp_reg_project_regularize(void *config, ocp_nlp_reg_dims *dims, void *
     ocp_nlp_reg_project_memory *mem = (ocp_nlp_reg_project_memory *) mem_;
     ocp_nlp_reg_project_opts *opts = opts_;
 
-    int ii;
-
-    int *nx = dims->nx;
-    int *nu = dims->nu;
-
-    for(ii=0; ii<=dims->N; ii++)
+    if (opts->adaptive_eps)
     {
-        // make symmetric
-        blasfeo_dtrtr_l(nu[ii]+nx[ii], mem->RSQrq[ii], 0, 0, mem->RSQrq[ii], 0, 0);
-
-        // regularize
-        blasfeo_unpack_dmat(nu[ii]+nx[ii], nu[ii]+nx[ii], mem->RSQrq[ii], 0, 0, mem->reg_hess, nu[ii]+nx[ii]);
-        if (opts->adaptive_eps)
-        {
-            acados_project_adaptive_eps(nu[ii]+nx[ii], mem->reg_hess, mem->V, mem->d, mem->e, opts->max_cond_block, opts->min_epsilon);
-        }
-        else
-        {
-            acados_project(nu[ii]+nx[ii], mem->reg_hess, mem->V, mem->d, mem->e, opts->epsilon);
-        }
-        blasfeo_pack_dmat(nu[ii]+nx[ii], nu[ii]+nx[ii], mem->reg_hess, nu[ii]+nx[ii], mem->RSQrq[ii], 0, 0);
+        acados_reg_eig_stages(dims, mem->RSQrq, mem->reg_hess, mem->V, mem->d, mem->e, mem->L,
+            &acados_project_eig, opts->min_epsilon, opts->max_cond_block, opts->pd_check);
+    }
+    else
+    {
+        acados_reg_eig_stages(dims, mem->RSQrq, mem->reg_hess, mem->V, mem->d, mem->e, mem->L,
+            &acados_project_eig, opts->epsilon, 0.0, opts->pd_check);
     }
 }
 
 
+
 void ocp_nlp_reg_project_regularize_lhs(void *config, ocp_nlp_reg_dims *dims, void *opts_, void *mem_)
 {
     ocp_nlp_reg_project_regularize(config, dims, opts_, mem_);
@@ -358,6 +379,9 @@ void ocp_nlp_reg_project_config_initialize_default(ocp_nlp_reg_config *config)
     config->memory_set_ux_ptr = &ocp_nlp_reg_project_memory_set_ux_ptr;
     config->memory_set_pi_ptr = &ocp_nlp_reg_project_memory_set_pi_ptr;
     config->memory_set_lam_ptr = &ocp_nlp_reg_project_memory_set_lam_ptr;
+    config->memory_state_size = &ocp_nlp_reg_memory_state_size_none;
+    config->memory_state_get = &ocp_nlp_reg_memory_state_copy_none;
+    config->memory_state_set = &ocp_nlp_reg_memory_state_copy_none;
     // functions
     config->regularize = &ocp_nlp_reg_project_regularize;
     config->regularize_rhs = &ocp_nlp_reg_project_regularize_rhs;
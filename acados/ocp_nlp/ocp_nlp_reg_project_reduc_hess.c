@@ -565,6 +565,9 @@ void ocp_nlp_reg_project_reduc_hess_config_initialize_default(ocp_nlp_reg_config
     config->memory_set_ux_ptr = &ocp_nlp_reg_project_reduc_hess_memory_set_ux_ptr;
     config->memory_set_pi_ptr = &ocp_nlp_reg_project_reduc_hess_memory_set_pi_ptr;
     config->memory_set_lam_ptr = &ocp_nlp_reg_project_reduc_hess_memory_set_lam_ptr;
+    config->memory_state_size = &ocp_nlp_reg_memory_state_size_none;
+    config->memory_state_get = &ocp_nlp_reg_memory_state_copy_none;
+    config->memory_state_set = &ocp_nlp_reg_memory_state_copy_none;
     // functions
     config->regularize = &ocp_nlp_reg_project_reduc_hess_regularize;
     config->regularize_rhs = &ocp_nlp_reg_project_reduc_hess_regularize_rhs;
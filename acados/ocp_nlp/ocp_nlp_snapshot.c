@@ -0,0 +1,382 @@
+/*
+ * Copyright (c) The acados authors.
+ *
+ * This file is part of acados.
+ *
+ * The 2-Clause BSD License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.;
+ */
+
+
+#include "acados/ocp_nlp/ocp_nlp_snapshot.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "acados/utils/mem.h"
+
+#include "blasfeo_d_aux.h"
+
+
+typedef enum
+{
+    SNAPSHOT_SIZE,
+    SNAPSHOT_WRITE,
+    SNAPSHOT_READ,
+} snapshot_mode;
+
+typedef struct
+{
+    snapshot_mode mode;
+    double *data;
+    acados_size_t n;  // number of doubles visited
+} snapshot_cursor;
+
+
+
+static void snapshot_dvec(snapshot_cursor *cur, int n, struct blasfeo_dvec *v)
+{
+    if (cur->mode == SNAPSHOT_WRITE)
+        blasfeo_unpack_dvec(n, v, 0, cur->data + cur->n, 1);
+    else if (cur->mode == SNAPSHOT_READ)
+        blasfeo_pack_dvec(n, cur->data + cur->n, 1, v, 0);
+    cur->n += n;
+}
+
+
+
+static void snapshot_dmat(snapshot_cursor *cur, int m, int n, struct blasfeo_dmat *A)
+{
+    if (cur->mode == SNAPSHOT_WRITE)
+        blasfeo_unpack_dmat(m, n, A, 0, 0, cur->data + cur->n, m);
+    else if (cur->mode == SNAPSHOT_READ)
+        blasfeo_pack_dmat(m, n, cur->data + cur->n, m, A, 0, 0);
+    cur->n += m * n;
+}
+
+
+
+static void snapshot_double(snapshot_cursor *cur, double *value)
+{
+    if (cur->mode == SNAPSHOT_WRITE)
+        cur->data[cur->n] = *value;
+    else if (cur->mode == SNAPSHOT_READ)
+        *value = cur->data[cur->n];
+    cur->n += 1;
+}
+
+
+
+static void snapshot_int(snapshot_cursor *cur, int *value)
+{
+    double tmp = *value;
+    snapshot_double(cur, &tmp);
+    *value = (int) tmp;
+}
+
+
+
+static void snapshot_bool(snapshot_cursor *cur, bool *value)
+{
+    double tmp = *value;
+    snapshot_double(cur, &tmp);
+    *value = tmp != 0.0;
+}
+
+
+
+static void snapshot_reg_state(snapshot_cursor *cur, ocp_nlp_config *config, ocp_nlp_dims *dims,
+                               ocp_nlp_memory *mem)
+{
+    ocp_nlp_reg_config *reg = config->regularize;
+    if (cur->mode == SNAPSHOT_WRITE)
+        reg->memory_state_get(reg, dims->regularize, mem->regularize_mem, cur->data + cur->n);
+    else if (cur->mode == SNAPSHOT_READ)
+        reg->memory_state_set(reg, dims->regularize, mem->regularize_mem, cur->data + cur->n);
+    cur->n += reg->memory_state_size(reg, dims->regularize, mem->regularize_mem);
+}
+
+
+
+static void snapshot_bytes(snapshot_cursor *cur, int size, void *value)
+{
+    int n = (size + sizeof(double) - 1) / sizeof(double);
+    if (cur->mode == SNAPSHOT_WRITE)
+    {
+        memset(cur->data + cur->n, 0, n * sizeof(double));
+        memcpy(cur->data + cur->n, value, size);
+    }
+    else if (cur->mode == SNAPSHOT_READ)
+    {
+        memcpy(value, cur->data + cur->n, size);
+    }
+    cur->n += n;
+}
+
+
+
+// visits the warm state in a fixed order: NLP iterate, QP data, NLP memory, algorithm state
+static void ocp_nlp_snapshot_visit(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_out *out,
+                                   ocp_nlp_memory *mem, snapshot_cursor *cur)
+{
+    int N = dims->N;
+    int *nv = dims->nv;
+    int *nx = dims->nx;
+    int *nu = dims->nu;
+    int *ni = dims->ni;
+    int *nz = dims->nz;
+
+    ocp_qp_in *qp_in = mem->qp_in;
+    ocp_qp_out *qp_out = mem->qp_out;
+    ocp_qp_dims *qp_dims = qp_in->dim;
+    int *nb = qp_dims->nb;
+    int *ng = qp_dims->ng;
+    int *ns = qp_dims->ns;
+
+    for (int i = 0; i <= N; i++)
+    {
+        int nux = nu[i] + nx[i];
+        int n_ineq = 2 * (nb[i] + ng[i] + ns[i]);
+
+        // nlp iterate
+        snapshot_dvec(cur, nv[i], out->ux + i);
+        snapshot_dvec(cur, nz[i], out->z + i);
+        if (i < N)
+            snapshot_dvec(cur, nx[i+1], out->pi + i);
+        snapshot_dvec(cur, 2 * ni[i], out->lam + i);
+
+        // qp in, contains the sensitivities of the integrators
+        if (i < N)
+        {
+            snapshot_dmat(cur, nux + 1, nx[i+1], qp_in->BAbt + i);
+            snapshot_dvec(cur, nx[i+1], qp_in->b + i);
+        }
+        snapshot_dmat(cur, nux + 1, nux, qp_in->RSQrq + i);
+        snapshot_dmat(cur, nux, ng[i], qp_in->DCt + i);
+        snapshot_dvec(cur, nux + 2 * ns[i], qp_in->rqz + i);
+        snapshot_dvec(cur, n_ineq, qp_in->d + i);
+        snapshot_dvec(cur, n_ineq, qp_in->d_mask + i);
+        snapshot_dvec(cur, n_ineq, qp_in->m + i);
+        snapshot_dvec(cur, 2 * ns[i], qp_in->Z + i);
+
+        // qp out, warm start of the next qp
+        snapshot_dvec(cur, nux + 2 * ns[i], qp_out->ux + i);
+        if (i < N)
+            snapshot_dvec(cur, nx[i+1], qp_out->pi + i);
+        snapshot_dvec(cur, n_ineq, qp_out->lam + i);
+        snapshot_dvec(cur, n_ineq, qp_out->t + i);
+
+        // nlp memory
+        snapshot_dmat(cur, nu[i] + nx[i], nz[i], mem->dzduxt + i);
+        snapshot_dvec(cur, nx[i] + nz[i], mem->sim_guess + i);
+        snapshot_bool(cur, mem->set_sim_guess + i);
+        snapshot_dvec(cur, nz[i], mem->z_alg + i);
+        if (i < N)
+            snapshot_dvec(cur, nx[i+1], mem->dyn_fun + i);
+        snapshot_dvec(cur, nu[i] + nx[i], mem->dyn_adj + i);
+        snapshot_dvec(cur, nv[i], mem->cost_grad + i);
+        snapshot_dvec(cur, 2 * ni[i], mem->ineq_fun + i);
+        snapshot_dvec(cur, nv[i], mem->ineq_adj + i);
+    }
+
+    // algorithm state
+    snapshot_double(cur, &out->inf_norm_res);
+    snapshot_double(cur, &mem->cost_value);
+    snapshot_double(cur, &mem->qp_cost_value);
+    snapshot_double(cur, &mem->predicted_infeasibility_reduction);
+    snapshot_double(cur, &mem->predicted_optimality_reduction);
+    snapshot_double(cur, &mem->objective_multiplier);
+    snapshot_double(cur, &mem->adaptive_levenberg_marquardt_mu);
+    snapshot_double(cur, &mem->adaptive_levenberg_marquardt_mu_bar);
+    snapshot_int(cur, &mem->compute_hess);
+    snapshot_int(cur, &mem->iter);
+    snapshot_int(cur, &mem->status);
+
+    snapshot_bytes(cur, config->globalization->memory_state_size(), mem->globalization);
+
+    // e.g. the convexification of the last regularize_lhs, needed by regularize_rhs in RTI feedback steps
+    snapshot_reg_state(cur, config, dims, mem);
+}
+
+
+
+static uint64_t ocp_nlp_snapshot_dims_hash(ocp_nlp_dims *dims, ocp_nlp_memory *mem)
+{
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ULL;
+    ocp_qp_dims *qp_dims = mem->qp_in->dim;
+    int N = dims->N;
+
+    int *fields[] = {dims->nv, dims->nx, dims->nu, dims->ni, dims->nz,
+                     qp_dims->nb, qp_dims->ng, qp_dims->ns};
+    int num_fields = sizeof(fields) / sizeof(fields[0]);
+
+    for (int j = 0; j < num_fields; j++)
+    {
+        for (int i = 0; i <= N; i++)
+        {
+            uint32_t value = (uint32_t) fields[j][i];
+            for (int k = 0; k < 4; k++)
+            {
+                hash ^= (value >> (8 * k)) & 0xff;
+                hash *= 1099511628211ULL;
+            }
+        }
+    }
+    return hash;
+}
+
+
+
+acados_size_t ocp_nlp_snapshot_calculate_size(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_out *out,
+                                              ocp_nlp_memory *mem)
+{
+    snapshot_cursor cur = {SNAPSHOT_SIZE, NULL, 0};
+    ocp_nlp_snapshot_visit(config, dims, out, mem, &cur);
+
+    return sizeof(ocp_nlp_snapshot_header) + cur.n * sizeof(double);
+}
+
+
+
+acados_size_t ocp_nlp_snapshot_write(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_out *out,
+                                     ocp_nlp_memory *mem, void *buffer, acados_size_t buffer_size)
+{
+    acados_size_t size = ocp_nlp_snapshot_calculate_size(config, dims, out, mem);
+    if (buffer_size < size)
+        return 0;
+
+    ocp_nlp_snapshot_header *header = buffer;
+    memset(header, 0, sizeof(ocp_nlp_snapshot_header));
+    memcpy(header->magic, OCP_NLP_SNAPSHOT_MAGIC, sizeof(OCP_NLP_SNAPSHOT_MAGIC));
+    header->version = OCP_NLP_SNAPSHOT_VERSION;
+    header->endianness = OCP_NLP_SNAPSHOT_ENDIANNESS;
+    header->size = size;
+    header->dims_hash = ocp_nlp_snapshot_dims_hash(dims, mem);
+    header->N = dims->N;
+    header->globalization_size = config->globalization->memory_state_size();
+    header->regularize_size = config->regularize->memory_state_size(config->regularize, dims->regularize,
+                                                                    mem->regularize_mem);
+
+    snapshot_cursor cur = {SNAPSHOT_WRITE, (double *) (header + 1), 0};
+    ocp_nlp_snapshot_visit(config, dims, out, mem, &cur);
+
+    assert(sizeof(ocp_nlp_snapshot_header) + cur.n * sizeof(double) == size);
+
+    return size;
+}
+
+
+
+int ocp_nlp_snapshot_read(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_out *out,
+                          ocp_nlp_memory *mem, const void *buffer, acados_size_t buffer_size)
+{
+    const ocp_nlp_snapshot_header *header = buffer;
+
+    if (buffer_size < sizeof(ocp_nlp_snapshot_header) ||
+        strncmp(header->magic, OCP_NLP_SNAPSHOT_MAGIC, sizeof(header->magic)))
+    {
+        printf("\nocp_nlp_snapshot_read: not an acados snapshot.\n");
+        return ACADOS_UNKNOWN;
+    }
+    if (header->version != OCP_NLP_SNAPSHOT_VERSION || header->endianness != OCP_NLP_SNAPSHOT_ENDIANNESS)
+    {
+        printf("\nocp_nlp_snapshot_read: snapshot version %u not supported, expected version %d with native byte order.\n",
+               header->version, OCP_NLP_SNAPSHOT_VERSION);
+        return ACADOS_UNKNOWN;
+    }
+    if (header->size != ocp_nlp_snapshot_calculate_size(config, dims, out, mem) || header->size > buffer_size ||
+        header->N != dims->N || header->dims_hash != ocp_nlp_snapshot_dims_hash(dims, mem) ||
+        header->globalization_size != (int32_t) config->globalization->memory_state_size() ||
+        header->regularize_size != (int32_t) config->regularize->memory_state_size(config->regularize,
+                                                 dims->regularize, mem->regularize_mem))
+    {
+        printf("\nocp_nlp_snapshot_read: snapshot was taken from a solver with different dimensions or modules.\n");
+        return ACADOS_UNKNOWN;
+    }
+
+    snapshot_cursor cur = {SNAPSHOT_READ, (double *) (header + 1), 0};
+    ocp_nlp_snapshot_visit(config, dims, out, mem, &cur);
+
+    return ACADOS_SUCCESS;
+}
+
+
+
+int ocp_nlp_snapshot_save(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_out *out,
+                          ocp_nlp_memory *mem, const char *filename)
+{
+    acados_size_t size = ocp_nlp_snapshot_calculate_size(config, dims, out, mem);
+    void *buffer = acados_malloc(size, 1);
+    if (buffer == NULL)
+    {
+        printf("\nocp_nlp_snapshot_save: failed to allocate the buffer.\n");
+        return ACADOS_UNKNOWN;
+    }
+    ocp_nlp_snapshot_write(config, dims, out, mem, buffer, size);
+
+    int status = ACADOS_SUCCESS;
+    FILE *file = fopen(filename, "wb");
+    if (file == NULL || fwrite(buffer, 1, size, file) != size)
+    {
+        printf("\nocp_nlp_snapshot_save: failed to write %s.\n", filename);
+        status = ACADOS_UNKNOWN;
+    }
+    if (file != NULL)
+        fclose(file);
+
+    free(buffer);
+    return status;
+}
+
+
+
+int ocp_nlp_snapshot_load(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_out *out,
+                          ocp_nlp_memory *mem, const char *filename)
+{
+    FILE *file = fopen(filename, "rb");
+    if (file == NULL)
+    {
+        printf("\nocp_nlp_snapshot_load: failed to open %s.\n", filename);
+        return ACADOS_UNKNOWN;
+    }
+
+    acados_size_t size = ocp_nlp_snapshot_calculate_size(config, dims, out, mem);
+    void *buffer = acados_malloc(size, 1);
+    if (buffer == NULL)
+    {
+        printf("\nocp_nlp_snapshot_load: failed to allocate the buffer.\n");
+        fclose(file);
+        return ACADOS_UNKNOWN;
+    }
+    acados_size_t size_read = fread(buffer, 1, size, file);
+    fclose(file);
+
+    int status = ocp_nlp_snapshot_read(config, dims, out, mem, buffer, size_read);
+
+    free(buffer);
+    return status;
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) The acados authors.
+ *
+ * This file is part of acados.
+ *
+ * The 2-Clause BSD License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.;
+ */
+
+
+#ifndef ACADOS_OCP_NLP_OCP_NLP_SNAPSHOT_H_
+#define ACADOS_OCP_NLP_OCP_NLP_SNAPSHOT_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include <stdint.h>
+
+#include "acados/ocp_nlp/ocp_nlp_common.h"
+#include "acados/utils/types.h"
+
+
+#define OCP_NLP_SNAPSHOT_MAGIC "ACDSNAP"
+#define OCP_NLP_SNAPSHOT_VERSION 2
+#define OCP_NLP_SNAPSHOT_ENDIANNESS 0x01020304
+
+// Binary layout: this 64 byte header, followed by the payload as native doubles.
+// The payload can be read in place from a mapped file.
+typedef struct
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t endianness;
+    uint64_t size;  // total number of bytes, including the header
+    uint64_t dims_hash;  // hash over all NLP and QP dimensions
+    int32_t N;
+    int32_t globalization_size;  // bytes of the globalization memory
+    int32_t regularize_size;  // doubles of the regularization memory
+    uint32_t reserved[5];
+} ocp_nlp_snapshot_header;
+
+//
+acados_size_t ocp_nlp_snapshot_calculate_size(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_out *out,
+                                              ocp_nlp_memory *mem);
+// returns the number of bytes written, 0 if buffer_size is too small
+acados_size_t ocp_nlp_snapshot_write(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_out *out,
+                                     ocp_nlp_memory *mem, void *buffer, acados_size_t buffer_size);
+// returns ACADOS_SUCCESS, or ACADOS_UNKNOWN if the snapshot does not match the solver
+int ocp_nlp_snapshot_read(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_out *out,
+                          ocp_nlp_memory *mem, const void *buffer, acados_size_t buffer_size);
+//
+int ocp_nlp_snapshot_save(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_out *out,
+                          ocp_nlp_memory *mem, const char *filename);
+//
+int ocp_nlp_snapshot_load(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_out *out,
+                          ocp_nlp_memory *mem, const char *filename);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif  // ACADOS_OCP_NLP_OCP_NLP_SNAPSHOT_H_
@@ -474,17 +474,20 @@ static void print_iteration(int iter, ocp_nlp_config *config, ocp_nlp_res *nlp_r
 int ocp_nlp_sqp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
                 void *opts_, void *mem_, void *work_)
 {
-    acados_timer timer0, timer1;
-    acados_tic(&timer0);
+    ocp_nlp_sqp_memory *mem = mem_;
+    ocp_nlp_memory *nlp_mem = mem->nlp_mem;
+
+    acados_profiler *prof = nlp_mem->profiler;
+    acados_profiler_span span_tot, span_iter, span;
+    if (prof) prof->solve++;
+    acados_profiler_span_start(prof, &span_tot);
 
     ocp_nlp_dims *dims = dims_;
     ocp_nlp_config *config = config_;
     ocp_nlp_sqp_opts *opts = opts_;
     ocp_nlp_opts *nlp_opts = opts->nlp_opts;
-    ocp_nlp_sqp_memory *mem = mem_;
     ocp_nlp_in *nlp_in = nlp_in_;
     ocp_nlp_out *nlp_out = nlp_out_;
-    ocp_nlp_memory *nlp_mem = mem->nlp_mem;
     ocp_qp_xcond_solver_config *qp_solver = config->qp_solver;
     ocp_nlp_res *nlp_res = nlp_mem->nlp_res;
     ocp_nlp_timings *nlp_timings = nlp_mem->nlp_timings;
@@ -527,6 +530,7 @@ int ocp_nlp_sqp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
 #endif
 
     ocp_nlp_initialize_submodules(config, dims, nlp_in, nlp_out, nlp_opts, nlp_mem, nlp_work);
+    nlp_mem->fun_at_iterate_valid = false;
 
     /************************************************
      * main sqp loop
@@ -540,6 +544,7 @@ int ocp_nlp_sqp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
 
     for (; nlp_mem->iter <= opts->nlp_opts->max_iter; nlp_mem->iter++) // <= needed such that after last iteration KKT residuals are checked before max_iter is thrown.
     {
+        if (prof) acados_profiler_span_start(prof, &span_iter);
         // We always evaluate the residuals until the last iteration
         // If the option "eval_residual_at_max_iter" is set, we also
         // evaluate the residuals after the last iteration.
@@ -552,7 +557,7 @@ int ocp_nlp_sqp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
             }
             /* Prepare the QP data */
             // linearize NLP and update QP matrices
-            acados_tic(&timer1);
+            acados_profiler_span_start(prof, &span);
             ocp_nlp_approximate_qp_matrices(config, dims, nlp_in, nlp_out, nlp_opts, nlp_mem, nlp_work);
             // update QP rhs for SQP (step prim var, abs dual var)
             ocp_nlp_approximate_qp_vectors_sqp(config, dims, nlp_in, nlp_out, nlp_opts, nlp_mem, nlp_work);
@@ -560,9 +565,12 @@ int ocp_nlp_sqp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
             if (nlp_opts->with_adaptive_levenberg_marquardt || config->globalization->needs_objective_value() == 1)
             {
                 ocp_nlp_get_cost_value_from_submodules(config, dims, nlp_in, nlp_out, nlp_opts, nlp_mem, nlp_work);
+                // the globalization can reuse the values at the current iterate
+                nlp_mem->fun_at_iterate_valid = true;
             }
             ocp_nlp_add_levenberg_marquardt_term(config, dims, nlp_in, nlp_out, nlp_opts, nlp_mem, nlp_work, mem->alpha, nlp_mem->iter, qp_in);
-            nlp_timings->time_lin += acados_toc(&timer1);
+            config->globalization->update_qp_bounds(config, dims, nlp_mem, nlp_opts);
+            nlp_timings->time_lin += acados_profiler_span_end(prof, &span, ACADOS_PROFILER_LIN, -1, nlp_mem->iter);
 
             // compute nlp residuals
             ocp_nlp_res_compute(dims, nlp_opts, nlp_in, nlp_out, nlp_res, nlp_mem, nlp_work);
@@ -592,21 +600,21 @@ int ocp_nlp_sqp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
         prev_levenberg_marquardt = nlp_opts->levenberg_marquardt;
 
         // QP scaling
-        acados_tic(&timer1);
+        acados_profiler_span_start(prof, &span);
         ocp_nlp_qpscaling_scale_qp(dims->qpscaling, nlp_opts->qpscaling, nlp_mem->qpscaling, qp_in);
-        nlp_timings->time_qpscaling += acados_toc(&timer1);
+        nlp_timings->time_qpscaling += acados_profiler_span_end(prof, &span, ACADOS_PROFILER_QPSCALING, -1, nlp_mem->iter);
 
         // regularize Hessian
         // NOTE: this is done before termination, such that we can get the QP at the stationary point that is actually solved, if we exit with success.
-        acados_tic(&timer1);
+        acados_profiler_span_start(prof, &span);
         config->regularize->regularize(config->regularize, dims->regularize,
                                                nlp_opts->regularize, nlp_mem->regularize_mem);
-        nlp_timings->time_reg += acados_toc(&timer1);
+        nlp_timings->time_reg += acados_profiler_span_end(prof, &span, ACADOS_PROFILER_REG, -1, nlp_mem->iter);
 
         // update timeout memory based on chosen heuristic
         if (opts->timeout_max_time > 0.)
         {
-            nlp_timings->time_tot = acados_toc(&timer0);
+            nlp_timings->time_tot = acados_profiler_span_elapsed(&span_tot);
 
             if (nlp_mem->iter > 0)
             {
@@ -650,7 +658,7 @@ int ocp_nlp_sqp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
             // restore number of threads
             omp_set_num_threads(num_threads_bkp);
 #endif
-            nlp_timings->time_tot = acados_toc(&timer0);
+            nlp_timings->time_tot = acados_profiler_span_end(prof, &span_tot, ACADOS_PROFILER_SOLVE, -1, nlp_mem->iter);
             return nlp_mem->status;
         }
 
@@ -745,7 +753,7 @@ int ocp_nlp_sqp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
             }
 
             nlp_mem->status = ACADOS_QP_FAILURE;
-            nlp_timings->time_tot = acados_toc(&timer0);
+            nlp_timings->time_tot = acados_profiler_span_end(prof, &span_tot, ACADOS_PROFILER_SOLVE, -1, nlp_mem->iter);
 
             return nlp_mem->status;
         }
@@ -774,9 +782,10 @@ int ocp_nlp_sqp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
         /* globalization */
         // NOTE on timings: currently all within globalization is accounted for within time_glob.
         //   QP solver times could be also attributed there alternatively. Cleanest would be to save them seperately.
-        acados_tic(&timer1);
+        acados_profiler_span_start(prof, &span);
         globalization_status = config->globalization->find_acceptable_iterate(config, dims, nlp_in, nlp_out, nlp_mem, mem, nlp_work, nlp_opts, &mem->alpha);
-        nlp_timings->time_glob += acados_toc(&timer1);
+        nlp_mem->fun_at_iterate_valid = false;
+        nlp_timings->time_glob += acados_profiler_span_end(prof, &span, ACADOS_PROFILER_GLOB, -1, nlp_mem->iter);
 
         if (globalization_status != ACADOS_SUCCESS)
         {
@@ -785,7 +794,7 @@ int ocp_nlp_sqp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
                 printf("\nFailure in globalization, got status %d (%s)!\n", globalization_status, status_to_string(globalization_status));
             }
             nlp_mem->status = globalization_status;
-            nlp_timings->time_tot = acados_toc(&timer0);
+            nlp_timings->time_tot = acados_profiler_span_end(prof, &span_tot, ACADOS_PROFILER_SOLVE, -1, nlp_mem->iter);
 #if defined(ACADOS_WITH_OPENMP)
             // restore number of threads
             omp_set_num_threads(num_threads_bkp);
@@ -795,6 +804,7 @@ int ocp_nlp_sqp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
         if (nlp_mem->iter+1 < mem->stat_m)
             mem->stat[mem->stat_n*(nlp_mem->iter+1)+6] = mem->alpha;
 
+        if (prof) acados_profiler_span_end(prof, &span_iter, ACADOS_PROFILER_ITER, -1, nlp_mem->iter);
     }  // end SQP loop
 
     if (nlp_opts->print_level > 0)
@@ -884,9 +894,6 @@ int ocp_nlp_sqp_precompute(void *config_, void *dims_, void *nlp_in_, void *nlp_
 void ocp_nlp_sqp_eval_param_sens(void *config_, void *dims_, void *opts_, void *mem_, void *work_,
                                  char *field, int stage, int index, void *sens_nlp_out_)
 {
-    acados_timer timer0;
-    acados_tic(&timer0);
-
     ocp_nlp_dims *dims = dims_;
     ocp_nlp_config *config = config_;
     ocp_nlp_sqp_opts *opts = opts_;
@@ -894,13 +901,16 @@ void ocp_nlp_sqp_eval_param_sens(void *config_, void *dims_, void *opts_, void *
     ocp_nlp_memory *nlp_mem = mem->nlp_mem;
     ocp_nlp_out *sens_nlp_out = sens_nlp_out_;
 
+    acados_profiler_span span;
+    acados_profiler_span_start(nlp_mem->profiler, &span);
+
     ocp_nlp_sqp_workspace *work = work_;
     ocp_nlp_workspace *nlp_work = work->nlp_work;
 
     ocp_nlp_common_eval_param_sens(config, dims, opts->nlp_opts, nlp_mem, nlp_work,
                                  field, stage, index, sens_nlp_out);
 
-    nlp_mem->nlp_timings->time_solution_sensitivities = acados_toc(&timer0);
+    nlp_mem->nlp_timings->time_solution_sensitivities = acados_profiler_span_end(nlp_mem->profiler, &span, ACADOS_PROFILER_SENS, -1, nlp_mem->iter);
 
     return;
 }
@@ -461,13 +461,14 @@ static void prepare_full_residual_computation(ocp_nlp_config *config,
 static void ocp_nlp_sqp_rti_preparation_step(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_in *nlp_in,
     ocp_nlp_out *nlp_out, ocp_nlp_sqp_rti_opts *opts, ocp_nlp_sqp_rti_memory *mem, ocp_nlp_sqp_rti_workspace *work)
 {
-    acados_timer timer1;
+    acados_profiler_span span;
     ocp_nlp_memory *nlp_mem = mem->nlp_mem;
     ocp_nlp_opts *nlp_opts = opts->nlp_opts;
     ocp_qp_xcond_solver_config *qp_solver = config->qp_solver;
 
     ocp_nlp_workspace *nlp_work = work->nlp_work;
     ocp_nlp_timings *timings = nlp_mem->nlp_timings;
+    acados_profiler *prof = nlp_mem->profiler;
 
     reset_stats_and_sub_timers(mem);
 
@@ -490,26 +491,25 @@ static void ocp_nlp_sqp_rti_preparation_step(ocp_nlp_config *config, ocp_nlp_dim
     ocp_nlp_initialize_submodules(config, dims, nlp_in, nlp_out, nlp_opts, nlp_mem, nlp_work);
 
     // linearize NLP and update QP matrices
-    acados_tic(&timer1);
+    acados_profiler_span_start(prof, &span);
     ocp_nlp_approximate_qp_matrices(config, dims, nlp_in,
         nlp_out, nlp_opts, nlp_mem, nlp_work);
     ocp_nlp_add_levenberg_marquardt_term(config, dims, nlp_in, nlp_out, nlp_opts, nlp_mem, nlp_work, 1.0, 0, nlp_mem->qp_in);
 
-    timings->time_lin += acados_toc(&timer1);
+    timings->time_lin += acados_profiler_span_end(prof, &span, ACADOS_PROFILER_LIN, -1, nlp_mem->iter);
 
     if (opts->rti_phase == PREPARATION)
     {
         // regularize Hessian
-        acados_tic(&timer1);
+        acados_profiler_span_start(prof, &span);
         config->regularize->regularize_lhs(config->regularize,
             dims->regularize, opts->nlp_opts->regularize, nlp_mem->regularize_mem);
-        timings->time_reg += acados_toc(&timer1);
+        timings->time_reg += acados_profiler_span_lap(prof, &span, ACADOS_PROFILER_REG, -1, nlp_mem->iter);
         // condense lhs
-        acados_tic(&timer1);
         qp_solver->condense_lhs(qp_solver, dims->qp_solver,
             nlp_mem->qp_in, nlp_mem->qp_out, opts->nlp_opts->qp_solver_opts,
             nlp_mem->qp_solver_mem, nlp_work->qp_work);
-        timings->time_qp_sol += acados_toc(&timer1);
+        timings->time_qp_sol += acados_profiler_span_end(prof, &span, ACADOS_PROFILER_QP, -1, nlp_mem->iter);
     }
 #if defined(ACADOS_WITH_OPENMP)
     // restore number of threads
@@ -523,22 +523,23 @@ static void ocp_nlp_sqp_rti_preparation_step(ocp_nlp_config *config, ocp_nlp_dim
 static void ocp_nlp_sqp_rti_feedback_step(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_in *nlp_in,
     ocp_nlp_out *nlp_out, ocp_nlp_sqp_rti_opts *opts, ocp_nlp_sqp_rti_memory *mem, ocp_nlp_sqp_rti_workspace *work)
 {
-    acados_timer timer1;
+    acados_profiler_span span;
 
     ocp_nlp_workspace *nlp_work = work->nlp_work;
     ocp_nlp_memory *nlp_mem = mem->nlp_mem;
     ocp_nlp_opts *nlp_opts = opts->nlp_opts;
     // ocp_qp_xcond_solver_config *qp_solver = config->qp_solver;
     ocp_nlp_timings *timings = nlp_mem->nlp_timings;
+    acados_profiler *prof = nlp_mem->profiler;
 
     int qp_iter = 0;
     int qp_status, globalization_status;
 
     // update QP rhs for SQP (step prim var, abs dual var)
-    acados_tic(&timer1);
+    acados_profiler_span_start(prof, &span);
     ocp_nlp_approximate_qp_vectors_sqp(config, dims, nlp_in,
         nlp_out, nlp_opts, nlp_mem, nlp_work);
-    timings->time_lin += acados_toc(&timer1);
+    timings->time_lin += acados_profiler_span_end(prof, &span, ACADOS_PROFILER_LIN, -1, nlp_mem->iter);
 
     if (opts->rti_log_residuals)
     {
@@ -548,7 +549,7 @@ static void ocp_nlp_sqp_rti_feedback_step(ocp_nlp_config *config, ocp_nlp_dims *
     nlp_mem->iter += 1;
 
     // regularization
-    acados_tic(&timer1);
+    acados_profiler_span_start(prof, &span);
     if (opts->rti_phase == FEEDBACK)
     {
         // finish regularization
@@ -565,7 +566,7 @@ static void ocp_nlp_sqp_rti_feedback_step(ocp_nlp_config *config, ocp_nlp_dims *
     {
         printf("ocp_nlp_sqp_rti_feedback_step: rti_phase must be FEEDBACK or PREPARATION_AND_FEEDBACK\n");
     }
-    timings->time_reg += acados_toc(&timer1);
+    timings->time_reg += acados_profiler_span_end(prof, &span, ACADOS_PROFILER_REG, -1, nlp_mem->iter);
 
     if (nlp_opts->print_level > 3) {
         printf("\n------- qp_in --------\n");
@@ -638,9 +639,9 @@ static void ocp_nlp_sqp_rti_feedback_step(ocp_nlp_config *config, ocp_nlp_dims *
 
     // Update variables
     double step_size;
-    acados_tic(&timer1);
+    acados_profiler_span_start(prof, &span);
     globalization_status = config->globalization->find_acceptable_iterate(config, dims, nlp_in, nlp_out, nlp_mem, mem, nlp_work, nlp_opts, &step_size);
-    timings->time_glob += acados_toc(&timer1);
+    timings->time_glob += acados_profiler_span_end(prof, &span, ACADOS_PROFILER_GLOB, -1, nlp_mem->iter);
 
     if (globalization_status != ACADOS_SUCCESS)
     {
@@ -797,9 +798,10 @@ static void level_c_prepare_residual_computation(ocp_nlp_config *config,
 static void ocp_nlp_sqp_rti_preparation_advanced_step(ocp_nlp_config *config, ocp_nlp_dims *dims, ocp_nlp_in *nlp_in,
     ocp_nlp_out *nlp_out, ocp_nlp_sqp_rti_opts *opts, ocp_nlp_sqp_rti_memory *mem, ocp_nlp_sqp_rti_workspace *work)
 {
-    acados_timer timer1;
+    acados_profiler_span span;
     ocp_nlp_memory *nlp_mem = mem->nlp_mem;
     ocp_nlp_timings *timings = nlp_mem->nlp_timings;
+    acados_profiler *prof = nlp_mem->profiler;
     ocp_nlp_opts *nlp_opts = opts->nlp_opts;
     ocp_qp_xcond_solver_config *qp_solver = config->qp_solver;
 
@@ -852,10 +854,10 @@ static void ocp_nlp_sqp_rti_preparation_advanced_step(ocp_nlp_config *config, oc
         }
 
         // update QP rhs for SQP (step prim var, abs dual var)
-        acados_tic(&timer1);
+        acados_profiler_span_start(prof, &span);
         ocp_nlp_approximate_qp_vectors_sqp(config, dims, nlp_in,
             nlp_out, nlp_opts, nlp_mem, nlp_work);
-        timings->time_lin += acados_toc(&timer1);
+        timings->time_lin += acados_profiler_span_end(prof, &span, ACADOS_PROFILER_LIN, -1, nlp_mem->iter);
 
         if (opts->rti_log_residuals)
         {
@@ -865,9 +867,10 @@ static void ocp_nlp_sqp_rti_preparation_advanced_step(ocp_nlp_config *config, oc
         nlp_mem->iter += 1;
 
         // regularization rhs
-        acados_tic(&timer1);
+        acados_profiler_span_start(prof, &span);
         config->regularize->regularize_rhs(config->regularize,
             dims->regularize, opts->nlp_opts->regularize, nlp_mem->regularize_mem);
+        timings->time_reg += acados_profiler_span_end(prof, &span, ACADOS_PROFILER_REG, -1, nlp_mem->iter);
 
         // solve QP
         qp_status = ocp_nlp_solve_qp_and_correct_dual(config, dims, nlp_opts, nlp_mem, nlp_work, true, NULL, NULL, NULL, NULL, NULL);
@@ -903,10 +906,10 @@ static void ocp_nlp_sqp_rti_preparation_advanced_step(ocp_nlp_config *config, oc
         // perform zero-order iterations
         for (; nlp_mem->iter < opts->as_rti_iter; nlp_mem->iter++)
         {
-            acados_tic(&timer1);
+            acados_profiler_span_start(prof, &span);
             // zero order QP update
             ocp_nlp_zero_order_qp_update(config, dims, nlp_in, nlp_out, nlp_opts, nlp_mem, nlp_work);
-            timings->time_lin += acados_toc(&timer1);
+            timings->time_lin += acados_profiler_span_end(prof, &span, ACADOS_PROFILER_LIN, -1, nlp_mem->iter);
 
             if (opts->rti_log_residuals && !opts->rti_log_only_available_residuals)
             {
@@ -917,10 +920,10 @@ static void ocp_nlp_sqp_rti_preparation_advanced_step(ocp_nlp_config *config, oc
             }
 
             // rhs regularization
-            acados_tic(&timer1);
+            acados_profiler_span_start(prof, &span);
             config->regularize->regularize_rhs(config->regularize,
                 dims->regularize, nlp_opts->regularize, nlp_mem->regularize_mem);
-            timings->time_reg += acados_toc(&timer1);
+            timings->time_reg += acados_profiler_span_end(prof, &span, ACADOS_PROFILER_REG, -1, nlp_mem->iter);
 
             // QP solve
             qp_status = ocp_nlp_solve_qp_and_correct_dual(config, dims, nlp_opts, nlp_mem, nlp_work, true, NULL, NULL, NULL, NULL, NULL);
@@ -933,10 +936,10 @@ static void ocp_nlp_sqp_rti_preparation_advanced_step(ocp_nlp_config *config, oc
             mem->stat[mem->stat_n * nlp_mem->iter+1] = qp_iter;
 
             // compute correct dual solution in case of Hessian regularization
-            acados_tic(&timer1);
+            acados_profiler_span_start(prof, &span);
             config->regularize->correct_dual_sol(config->regularize,
                 dims->regularize, nlp_opts->regularize, nlp_mem->regularize_mem);
-            timings->time_reg += acados_toc(&timer1);
+            timings->time_reg += acados_profiler_span_end(prof, &span, ACADOS_PROFILER_REG, -1, nlp_mem->iter);
             if ((qp_status!=ACADOS_SUCCESS) & (qp_status!=ACADOS_MAXITER))
             {
 #ifndef ACADOS_SILENT
@@ -973,10 +976,10 @@ static void ocp_nlp_sqp_rti_preparation_advanced_step(ocp_nlp_config *config, oc
         for (; nlp_mem->iter < opts->as_rti_iter; nlp_mem->iter++)
         {
             // double norm, tmp_norm = 0.0;
-            acados_tic(&timer1);
+            acados_profiler_span_start(prof, &span);
             // QP update
             ocp_nlp_level_c_update(config, dims, nlp_in, nlp_out, nlp_opts, nlp_mem, nlp_work);
-            timings->time_lin += acados_toc(&timer1);
+            timings->time_lin += acados_profiler_span_end(prof, &span, ACADOS_PROFILER_LIN, -1, nlp_mem->iter);
 
             if (opts->rti_log_residuals && !opts->rti_log_only_available_residuals)
             {
@@ -987,10 +990,10 @@ static void ocp_nlp_sqp_rti_preparation_advanced_step(ocp_nlp_config *config, oc
             }
 
             // rhs regularization
-            acados_tic(&timer1);
+            acados_profiler_span_start(prof, &span);
             config->regularize->regularize_rhs(config->regularize,
                 dims->regularize, nlp_opts->regularize, nlp_mem->regularize_mem);
-            timings->time_reg += acados_toc(&timer1);
+            timings->time_reg += acados_profiler_span_end(prof, &span, ACADOS_PROFILER_REG, -1, nlp_mem->iter);
 
             // QP solve
             qp_status = ocp_nlp_solve_qp_and_correct_dual(config, dims, nlp_opts, nlp_mem, nlp_work, true, NULL, NULL, NULL, NULL, NULL);
@@ -1043,14 +1046,14 @@ static void ocp_nlp_sqp_rti_preparation_advanced_step(ocp_nlp_config *config, oc
         // perform k full SQP iterations
         for (; nlp_mem->iter < opts->as_rti_iter; nlp_mem->iter++)
         {
-            acados_tic(&timer1);
+            acados_profiler_span_start(prof, &span);
             // linearize NLP
             ocp_nlp_approximate_qp_matrices(config, dims, nlp_in,
                 nlp_out, nlp_opts, nlp_mem, nlp_work);
             ocp_nlp_add_levenberg_marquardt_term(config, dims, nlp_in, nlp_out, nlp_opts, nlp_mem, nlp_work, 1.0, 0, nlp_mem->qp_in);
             ocp_nlp_approximate_qp_vectors_sqp(config, dims, nlp_in,
                 nlp_out, nlp_opts, nlp_mem, nlp_work);
-            timings->time_lin += acados_toc(&timer1);
+            timings->time_lin += acados_profiler_span_end(prof, &span, ACADOS_PROFILER_LIN, -1, nlp_mem->iter);
 
             if (opts->rti_log_residuals)
             {
@@ -1059,10 +1062,10 @@ static void ocp_nlp_sqp_rti_preparation_advanced_step(ocp_nlp_config *config, oc
             }
 
             // full regularization
-            acados_tic(&timer1);
+            acados_profiler_span_start(prof, &span);
             config->regularize->regularize(config->regularize,
                 dims->regularize, nlp_opts->regularize, nlp_mem->regularize_mem);
-            timings->time_reg += acados_toc(&timer1);
+            timings->time_reg += acados_profiler_span_end(prof, &span, ACADOS_PROFILER_REG, -1, nlp_mem->iter);
 
             // QP solve
             qp_status = ocp_nlp_solve_qp_and_correct_dual(config, dims, nlp_opts, nlp_mem, nlp_work, false, NULL, NULL, NULL, NULL, NULL);
@@ -1100,17 +1103,17 @@ static void ocp_nlp_sqp_rti_preparation_advanced_step(ocp_nlp_config *config, oc
 
     /* NORMAL RTI PREPARATION */
     // linearize NLP and update QP matrices
-    acados_tic(&timer1);
+    acados_profiler_span_start(prof, &span);
     ocp_nlp_approximate_qp_matrices(config, dims, nlp_in,
         nlp_out, nlp_opts, nlp_mem, nlp_work);
     ocp_nlp_add_levenberg_marquardt_term(config, dims, nlp_in, nlp_out, nlp_opts, nlp_mem, nlp_work, 1.0, 0, nlp_mem->qp_in);
-    timings->time_lin += acados_toc(&timer1);
+    timings->time_lin += acados_profiler_span_end(prof, &span, ACADOS_PROFILER_LIN, -1, nlp_mem->iter);
 
     // regularize Hessian
-    acados_tic(&timer1);
+    acados_profiler_span_start(prof, &span);
     config->regularize->regularize_lhs(config->regularize,
         dims->regularize, opts->nlp_opts->regularize, nlp_mem->regularize_mem);
-    timings->time_reg += acados_toc(&timer1);
+    timings->time_reg += acados_profiler_span_end(prof, &span, ACADOS_PROFILER_REG, -1, nlp_mem->iter);
     // condense lhs
     qp_solver->condense_lhs(qp_solver, dims->qp_solver,
         nlp_mem->qp_in, nlp_mem->qp_out, opts->nlp_opts->qp_solver_opts,
@@ -1146,10 +1149,12 @@ int ocp_nlp_sqp_rti_setup_qp_matrices_and_factorize(void *config_, void *dims_,
 int ocp_nlp_sqp_rti(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
     void *opts_, void *mem_, void *work_)
 {
-    acados_timer timer;
-    acados_tic(&timer);
-
     ocp_nlp_sqp_rti_memory *mem = mem_;
+    acados_profiler *prof = mem->nlp_mem->profiler;
+    acados_profiler_span span_tot, span;
+    if (prof) prof->solve++;
+    acados_profiler_span_start(prof, &span_tot);
+
     ocp_nlp_dims *dims = dims_;
     ocp_nlp_config *config = config_;
     ocp_nlp_sqp_rti_opts *opts = opts_;
@@ -1163,17 +1168,17 @@ int ocp_nlp_sqp_rti(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
     if (rti_phase == FEEDBACK)
     {
         ocp_nlp_sqp_rti_feedback_step(config, dims, nlp_in, nlp_out, opts, mem, work);
-        timings->time_feedback = acados_toc(&timer);
+        timings->time_feedback = acados_profiler_span_elapsed(&span_tot);
     }
     else if (rti_phase == PREPARATION && opts->as_rti_level == STANDARD_RTI)
     {
         ocp_nlp_sqp_rti_preparation_step(config, dims, nlp_in, nlp_out, opts, mem, work);
-        timings->time_preparation = acados_toc(&timer);
+        timings->time_preparation = acados_profiler_span_elapsed(&span_tot);
     }
     else if (rti_phase == PREPARATION)
     {
         ocp_nlp_sqp_rti_preparation_advanced_step(config, dims, nlp_in, nlp_out, opts, mem, work);
-        timings->time_preparation = acados_toc(&timer);
+        timings->time_preparation = acados_profiler_span_elapsed(&span_tot);
     }
     else if (rti_phase == PREPARATION_AND_FEEDBACK && opts->as_rti_level != STANDARD_RTI)
     {
@@ -1183,15 +1188,29 @@ int ocp_nlp_sqp_rti(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
     else if (rti_phase == PREPARATION_AND_FEEDBACK)
     {
         // rti_phase == PREPARATION_AND_FEEDBACK
+        acados_profiler_span_start(prof, &span);
         ocp_nlp_sqp_rti_preparation_step(config, dims, nlp_in, nlp_out, opts, mem, work);
-        timings->time_preparation = acados_toc(&timer);
+        timings->time_preparation = acados_profiler_span_lap(prof, &span, ACADOS_PROFILER_PREPARATION, -1, mem->nlp_mem->iter);
 
-        acados_timer timer_feedback;
-        acados_tic(&timer_feedback);
         ocp_nlp_sqp_rti_feedback_step(config, dims, nlp_in, nlp_out, opts, mem, work);
-        timings->time_feedback = acados_toc(&timer_feedback);
+        timings->time_feedback = acados_profiler_span_end(prof, &span, ACADOS_PROFILER_FEEDBACK, -1, mem->nlp_mem->iter);
+    }
+    timings->time_tot = acados_profiler_span_end(prof, &span_tot,
+        rti_phase == FEEDBACK ? ACADOS_PROFILER_FEEDBACK : rti_phase == PREPARATION ? ACADOS_PROFILER_PREPARATION : ACADOS_PROFILER_SOLVE,
+        -1, mem->nlp_mem->iter);
+
+    ocp_nlp_opts *nlp_opts = opts->nlp_opts;
+    ocp_nlp_memory *nlp_mem = mem->nlp_mem;
+    ocp_nlp_latency_record(nlp_opts, nlp_mem, LATENCY_TIME_TOT, timings->time_tot);
+    if (rti_phase == PREPARATION || rti_phase == PREPARATION_AND_FEEDBACK)
+    {
+        ocp_nlp_latency_record(nlp_opts, nlp_mem, LATENCY_TIME_PREPARATION, timings->time_preparation);
+    }
+    if (rti_phase == FEEDBACK || rti_phase == PREPARATION_AND_FEEDBACK)
+    {
+        ocp_nlp_latency_record(nlp_opts, nlp_mem, LATENCY_TIME_FEEDBACK, timings->time_feedback);
+        ocp_nlp_latency_record(nlp_opts, nlp_mem, LATENCY_TIME_QP_SOLVER_CALL, timings->time_qp_solver_call);
     }
-    timings->time_tot = acados_toc(&timer);
 
     return mem->nlp_mem->status;
 
@@ -1265,9 +1284,6 @@ void ocp_nlp_sqp_rti_eval_param_sens(void *config_, void *dims_, void *opts_,
     void *mem_, void *work_, char *field, int stage, int index,
     void *sens_nlp_out_)
 {
-    acados_timer timer0;
-    acados_tic(&timer0);
-
     ocp_nlp_dims *dims = dims_;
     ocp_nlp_config *config = config_;
     ocp_nlp_sqp_rti_opts *opts = opts_;
@@ -1275,13 +1291,16 @@ void ocp_nlp_sqp_rti_eval_param_sens(void *config_, void *dims_, void *opts_,
     ocp_nlp_memory *nlp_mem = mem->nlp_mem;
     ocp_nlp_out *sens_nlp_out = sens_nlp_out_;
 
+    acados_profiler_span span;
+    acados_profiler_span_start(nlp_mem->profiler, &span);
+
     ocp_nlp_sqp_rti_workspace *work = work_;
     ocp_nlp_workspace *nlp_work = work->nlp_work;
 
     ocp_nlp_common_eval_param_sens(config, dims, opts->nlp_opts, nlp_mem, nlp_work,
                                  field, stage, index, sens_nlp_out);
 
-    mem->nlp_mem->nlp_timings->time_solution_sensitivities = acados_toc(&timer0);
+    nlp_mem->nlp_timings->time_solution_sensitivities = acados_profiler_span_end(nlp_mem->profiler, &span, ACADOS_PROFILER_SENS, -1, nlp_mem->iter);
 
     return;
 }
@@ -1373,6 +1392,11 @@ void ocp_nlp_sqp_rti_get(void *config_, void *dims_, void *mem_,
         void **value = return_value_;
         *value = dims->qp_solver->xcond_dims;
     }
+    else if (!strcmp("is_first_call", field))
+    {
+        bool **value = return_value_;
+        *value = &mem->is_first_call;
+    }
     else
     {
         ocp_nlp_memory_get(config, mem->nlp_mem, field, return_value_);
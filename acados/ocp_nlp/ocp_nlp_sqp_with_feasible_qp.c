@@ -119,6 +119,7 @@ void ocp_nlp_sqp_wfqp_opts_initialize_default(void *config_, void *dims_, void *
     opts->allow_direction_mode_switch_to_nominal = true;
     opts->byrd_omojokon_slack_relaxation_factor = 1.00001;
     opts->feasibility_qp_hessian_scalar = 1e-4;
+    opts->warm_start_nominal_qp_from_feasibility_qp = false;
     opts->log_pi_norm_inf = true;
     opts->log_lam_norm_inf = true;
 
@@ -189,6 +190,11 @@ void ocp_nlp_sqp_wfqp_opts_set(void *config_, void *opts_, const char *field, vo
             bool* allow_direction_mode_switch_to_nominal = (bool *) value;
             opts->allow_direction_mode_switch_to_nominal = *allow_direction_mode_switch_to_nominal;
         }
+        else if (!strcmp(field, "warm_start_nominal_qp_from_feasibility_qp"))
+        {
+            bool* warm_start_nominal_qp_from_feasibility_qp = (bool *) value;
+            opts->warm_start_nominal_qp_from_feasibility_qp = *warm_start_nominal_qp_from_feasibility_qp;
+        }
         else
         {
             ocp_nlp_opts_set(config, nlp_opts, field, value);
@@ -295,15 +301,21 @@ acados_size_t ocp_nlp_sqp_wfqp_memory_calculate_size(void *config_, void *dims_,
         // Z_cost_module
         size += blasfeo_memsize_dvec(2*dims->ns[stage]);
 
-        // RSQ_cost, RSQ_constr
-        size += 2*blasfeo_memsize_dmat(dims->nx[stage]+dims->nu[stage], dims->nx[stage]+dims->nu[stage]);
+        // RSQ_cost
+        size += blasfeo_memsize_dmat(dims->nx[stage]+dims->nu[stage], dims->nx[stage]+dims->nu[stage]);
+        // RSQ_constr
+        if (!nlp_opts->minimal_memory)
+            size += blasfeo_memsize_dmat(dims->nx[stage]+dims->nu[stage], dims->nx[stage]+dims->nu[stage]);
     }
     // nns
     size += (N+1) * sizeof(int);
     // Z_cost_module
     size += (N + 1) * sizeof(struct blasfeo_dvec);
-    // RSQ_cost, RSQ_constr
-    size += 2*(N + 1) * sizeof(struct blasfeo_dmat);
+    // RSQ_cost
+    size += (N + 1) * sizeof(struct blasfeo_dmat);
+    // RSQ_constr
+    if (!nlp_opts->minimal_memory)
+        size += (N + 1) * sizeof(struct blasfeo_dmat);
 
     // search_direction_type
     size += MAX_STR_LEN * sizeof(char);
@@ -367,6 +379,7 @@ void *ocp_nlp_sqp_wfqp_memory_assign(void *config_, void *dims_, void *opts_, vo
     mem->relaxed_qp_solver.work = mem->relaxed_qp_solver_work;
 
     set_relaxed_qp_in_matrix_pointers(mem);
+    mem->nominal_qp_initialized_from_feasibility_qp = false;
 
     // Z_cost_module
     assign_and_advance_blasfeo_dvec_structs(N + 1, &mem->Z_cost_module, &c_ptr);
@@ -374,7 +387,8 @@ void *ocp_nlp_sqp_wfqp_memory_assign(void *config_, void *dims_, void *opts_, vo
     // RSQ_cost
     assign_and_advance_blasfeo_dmat_structs(N + 1, &mem->RSQ_cost, &c_ptr);
     // RSQ_constr
-    assign_and_advance_blasfeo_dmat_structs(N + 1, &mem->RSQ_constr, &c_ptr);
+    if (!nlp_opts->minimal_memory)
+        assign_and_advance_blasfeo_dmat_structs(N + 1, &mem->RSQ_constr, &c_ptr);
 
     // stat
     mem->stat_m = opts->nlp_opts->max_iter+1;
@@ -425,8 +439,13 @@ void *ocp_nlp_sqp_wfqp_memory_assign(void *config_, void *dims_, void *opts_, vo
     for (int i = 0; i <= N; ++i)
     {
         assign_and_advance_blasfeo_dmat_mem(dims->nx[i]+dims->nu[i], dims->nx[i]+dims->nu[i], mem->RSQ_cost + i, &c_ptr);
-        assign_and_advance_blasfeo_dmat_mem(dims->nx[i]+dims->nu[i], dims->nx[i]+dims->nu[i], mem->RSQ_constr + i, &c_ptr);
+        if (!nlp_opts->minimal_memory)
+            assign_and_advance_blasfeo_dmat_mem(dims->nx[i]+dims->nu[i], dims->nx[i]+dims->nu[i], mem->RSQ_constr + i, &c_ptr);
     }
+    // minimal memory: the constraint Hessian is evaluated into the nominal QP,
+    // the cost Hessian is added after the relaxed QP Hessian was copied from it
+    if (nlp_opts->minimal_memory)
+        mem->RSQ_constr = mem->nlp_mem->qp_in->RSQrq;
     // Z_cost_module
     for (int i = 0; i <= N; ++i)
     {
@@ -910,7 +929,8 @@ static void setup_hessian_matrices_for_qps(ocp_nlp_config *config,
             blasfeo_dgecp(nxu, nxu, mem->RSQ_constr+i, 0, 0, relaxed_qp_in->RSQrq+i, 0, 0);
         }
 
-        blasfeo_dgecp(nxu, nxu, mem->RSQ_constr+i, 0, 0, nominal_qp_in->RSQrq+i, 0, 0);
+        if (mem->RSQ_constr != nominal_qp_in->RSQrq)
+            blasfeo_dgecp(nxu, nxu, mem->RSQ_constr+i, 0, 0, nominal_qp_in->RSQrq+i, 0, 0);
         blasfeo_dgead(nxu, nxu, 1.0, mem->RSQ_cost+i, 0, 0, nominal_qp_in->RSQrq+i, 0, 0);
 
         // Z -- slack matrix --> needs to be at correct position!
@@ -926,10 +946,9 @@ Solves the QP. Either solves feasibility QP or nominal QP
 static int prepare_and_solve_QP(ocp_nlp_config* config, ocp_nlp_sqp_wfqp_opts* opts,
                     ocp_qp_in* scaled_qp_in, ocp_qp_in* qp_in, ocp_qp_out* scaled_qp_out, ocp_qp_out* qp_out,
                     ocp_nlp_dims *dims, ocp_nlp_sqp_wfqp_memory* mem, ocp_nlp_in* nlp_in, ocp_nlp_out* nlp_out,
-                    ocp_nlp_memory* nlp_mem, ocp_nlp_workspace* nlp_work, bool solve_feasibility_qp,
-                    acados_timer timer_tot)
+                    ocp_nlp_memory* nlp_mem, ocp_nlp_workspace* nlp_work, bool solve_feasibility_qp)
 {
-    acados_timer timer;
+    acados_profiler_span span;
     ocp_nlp_opts* nlp_opts = opts->nlp_opts;
     ocp_qp_xcond_solver_config *qp_solver = config->qp_solver;
     ocp_nlp_timings *nlp_timings = nlp_mem->nlp_timings;
@@ -960,6 +979,14 @@ static int prepare_and_solve_QP(ocp_nlp_config* config, ocp_nlp_sqp_wfqp_opts* o
             ocp_nlp_initialize_qp_from_nlp(config, dims, qp_in, nlp_out, qp_out);
         }
     }
+    if (!solve_feasibility_qp && mem->nominal_qp_initialized_from_feasibility_qp)
+    {
+        // keep primal guess from feasibility QP, cold start the multipliers
+        tmp_int = 1;
+        qp_solver->opts_set(qp_solver, nlp_opts->qp_solver_opts, "warm_start", &tmp_int);
+        bool tmp_bool = true;
+        qp_solver->opts_set(qp_solver, nlp_opts->qp_solver_opts, "initialize_next_xcond_qp_from_qp_out", &tmp_bool);
+    }
 
     if (mem->qps_solved_in_iter < 2 && (!solve_feasibility_qp || opts->use_constraint_hessian_in_feas_qp))
     {
@@ -969,10 +996,10 @@ static int prepare_and_solve_QP(ocp_nlp_config* config, ocp_nlp_sqp_wfqp_opts* o
             ocp_nlp_add_levenberg_marquardt_term(config, dims, nlp_in, nlp_out, opts->nlp_opts, nlp_mem, nlp_work, mem->alpha, nlp_mem->iter, qp_in);
         }
 
-        acados_tic(&timer);
+        acados_profiler_span_start(nlp_mem->profiler, &span);
         // regularize Hessian
         config->regularize->regularize(config->regularize, dims->regularize, nlp_opts->regularize, nlp_mem->regularize_mem);
-        nlp_timings->time_reg += acados_toc(&timer);
+        nlp_timings->time_reg += acados_profiler_span_end(nlp_mem->profiler, &span, ACADOS_PROFILER_REG, -1, nlp_mem->iter);
     }
 
     // Show input to QP
@@ -999,9 +1026,9 @@ static int prepare_and_solve_QP(ocp_nlp_config* config, ocp_nlp_sqp_wfqp_opts* o
             // dont regularize Hessian for feasibility QP
             qp_status = ocp_nlp_solve_qp(config, dims, nlp_opts,
                 nlp_mem, nlp_work, scaled_qp_in, scaled_qp_out, &mem->relaxed_qp_solver);
-            acados_tic(&timer);
+            acados_profiler_span_start(nlp_mem->profiler, &span);
             ocp_nlp_qpscaling_rescale_solution(dims->relaxed_qpscaling, nlp_opts->qpscaling, mem->relaxed_qpscaling_mem, qp_in, qp_out);
-            nlp_timings->time_qpscaling += acados_toc(&timer);
+            nlp_timings->time_qpscaling += acados_profiler_span_end(nlp_mem->profiler, &span, ACADOS_PROFILER_QPSCALING, -1, nlp_mem->iter);
         }
     }
     else
@@ -1013,10 +1040,14 @@ static int prepare_and_solve_QP(ocp_nlp_config* config, ocp_nlp_sqp_wfqp_opts* o
     mem->qps_solved_in_iter += 1;
 
     // restore default warm start
-    if (nlp_mem->iter==0)
+    if (nlp_mem->iter==0 || (!solve_feasibility_qp && mem->nominal_qp_initialized_from_feasibility_qp))
     {
         qp_solver->opts_set(qp_solver, nlp_opts->qp_solver_opts, "warm_start", &nlp_opts->qp_warm_start);
     }
+    if (!solve_feasibility_qp)
+    {
+        mem->nominal_qp_initialized_from_feasibility_qp = false;
+    }
 
     if (nlp_opts->print_level > 3)
     {
@@ -1040,7 +1071,6 @@ static int prepare_and_solve_QP(ocp_nlp_config* config, ocp_nlp_sqp_wfqp_opts* o
         }
 
         mem->nlp_mem->status = ACADOS_QP_FAILURE;
-        nlp_timings->time_tot = acados_toc(&timer_tot);
 
         return mem->nlp_mem->status;
     }
@@ -1137,6 +1167,32 @@ static void setup_byrd_omojokun_bounds(ocp_nlp_dims *dims, ocp_nlp_memory *nlp_m
     }
 }
 
+/*
+Initializes the primal variables of the nominal QP with the feasibility QP solution.
+After setup_byrd_omojokun_bounds, this point is feasible for the nominal QP.
+Both QPs share dynamics and constraint matrices, the nominal QP has no QP slacks.
+*/
+static void initialize_nominal_qp_from_feasibility_qp(ocp_nlp_dims *dims, ocp_nlp_memory *nlp_mem, ocp_nlp_sqp_wfqp_memory *mem)
+{
+    int N = dims->N;
+    int *nx = dims->nx;
+    int *nu = dims->nu;
+    int *ns = dims->ns;
+    int *nns = mem->nns;
+
+    ocp_qp_out *nominal_qp_out = nlp_mem->scaled_qp_out;
+    ocp_qp_out *relaxed_qp_out = mem->relaxed_scaled_qp_out;
+
+    for (int i = 0; i <= N; i++)
+    {
+        // u, x, sl_NLP
+        blasfeo_dveccp(nu[i]+nx[i]+ns[i], relaxed_qp_out->ux+i, 0, nominal_qp_out->ux+i, 0);
+        // su_NLP
+        blasfeo_dveccp(ns[i], relaxed_qp_out->ux+i, nu[i]+nx[i]+ns[i]+nns[i], nominal_qp_out->ux+i, nu[i]+nx[i]+ns[i]);
+    }
+    mem->nominal_qp_initialized_from_feasibility_qp = true;
+}
+
 /*
 First: solve feasibility QP. Second: solve nominal QP with adjusted bounds.
 
@@ -1149,8 +1205,7 @@ static int byrd_omojokun_direction_computation(ocp_nlp_dims *dims,
                                             ocp_nlp_in *nlp_in,
                                             ocp_nlp_out *nlp_out,
                                             ocp_nlp_sqp_wfqp_memory *mem,
-                                            ocp_nlp_sqp_wfqp_workspace *work,
-                                            acados_timer timer_tot)
+                                            ocp_nlp_sqp_wfqp_workspace *work)
 {
     ocp_nlp_memory* nlp_mem = mem->nlp_mem;
     ocp_nlp_workspace* nlp_work = work->nlp_work;
@@ -1164,7 +1219,6 @@ static int byrd_omojokun_direction_computation(ocp_nlp_dims *dims,
     ocp_qp_in *relaxed_scaled_qp_in = mem->relaxed_scaled_qp_in;
     ocp_qp_out *relaxed_qp_out = mem->relaxed_qp_out;
 
-    ocp_nlp_timings *nlp_timings = nlp_mem->nlp_timings;
     qp_info* qp_info_;
 
     int qp_status;
@@ -1173,7 +1227,7 @@ static int byrd_omojokun_direction_computation(ocp_nlp_dims *dims,
     /* Solve Feasibility QP: Objective: Only constraint Hessian/Identity AND only gradient of slack variables */
     print_debug_output("Solve Feasibility QP!\n", nlp_opts->print_level, 2);
     qp_status = prepare_and_solve_QP(config, opts, relaxed_scaled_qp_in, relaxed_qp_in, mem->relaxed_scaled_qp_out, relaxed_qp_out, dims, mem, nlp_in, nlp_out,
-                nlp_mem, nlp_work, true, timer_tot);
+                nlp_mem, nlp_work, true);
     ocp_qp_out_get(relaxed_qp_out, 0, "qp_info", &qp_info_);
     qp_iter = qp_info_->num_iter;
     log_qp_stats(mem, true, qp_status, qp_iter);
@@ -1184,7 +1238,6 @@ static int byrd_omojokun_direction_computation(ocp_nlp_dims *dims,
             printf("\nError in feasibility QP in iteration %d, got qp_status %d (%s)!\n", qp_iter, qp_status, status_to_string(qp_status));
         }
         nlp_mem->status = ACADOS_QP_FAILURE;
-        nlp_timings->time_tot = acados_toc(&timer_tot);
         return nlp_mem->status;
     }
 
@@ -1193,10 +1246,14 @@ static int byrd_omojokun_direction_computation(ocp_nlp_dims *dims,
     /* Solve the nominal QP with updated bounds*/
     print_debug_output("Solve Nominal QP!\n", nlp_opts->print_level, 2);
     setup_byrd_omojokun_bounds(dims, nlp_mem, mem, work, opts);
+    if (opts->warm_start_nominal_qp_from_feasibility_qp)
+    {
+        initialize_nominal_qp_from_feasibility_qp(dims, nlp_mem, mem);
+    }
     // solve_feasibility_qp --> false in prepare_and_solve_QP
 
     qp_status = prepare_and_solve_QP(config, opts, nominal_scaled_qp_in, nominal_qp_in, nominal_scaled_qp_out, nominal_qp_out, dims, mem, nlp_in, nlp_out,
-                                     nlp_mem, nlp_work, false, timer_tot);
+                                     nlp_mem, nlp_work, false);
     ocp_qp_out_get(nominal_qp_out, 0, "qp_info", &qp_info_);
     qp_iter = qp_info_->num_iter;
     log_qp_stats(mem, false, qp_status, qp_iter);
@@ -1208,7 +1265,6 @@ static int byrd_omojokun_direction_computation(ocp_nlp_dims *dims,
             printf("\nError in nominal QP in iteration %d, got qp_status %d (%s)!\n", qp_iter, qp_status, status_to_string(qp_status));
         }
         nlp_mem->status = ACADOS_QP_FAILURE;
-        nlp_timings->time_tot = acados_toc(&timer_tot);
         return nlp_mem->status;
     }
     return qp_status;
@@ -1433,8 +1489,7 @@ static int calculate_search_direction(ocp_nlp_dims *dims,
     ocp_nlp_in *nlp_in,
     ocp_nlp_out *nlp_out,
     ocp_nlp_sqp_wfqp_memory *mem,
-    ocp_nlp_sqp_wfqp_workspace *work,
-    acados_timer timer_tot)
+    ocp_nlp_sqp_wfqp_workspace *work)
 {
     ocp_nlp_memory *nlp_mem = mem->nlp_mem;
     qp_info* qp_info_;
@@ -1448,7 +1503,7 @@ static int calculate_search_direction(ocp_nlp_dims *dims,
         // otherwise, we change the mode to Byrd-Omojokun and we continue.
         search_direction_status = prepare_and_solve_QP(config, opts, nlp_mem->scaled_qp_in,
             nlp_mem->qp_in, nlp_mem->scaled_qp_out, nlp_mem->qp_out,
-            dims, mem, nlp_in, nlp_out, nlp_mem, work->nlp_work, false, timer_tot);
+            dims, mem, nlp_in, nlp_out, nlp_mem, work->nlp_work, false);
         ocp_qp_out_get(nlp_mem->qp_out, 0, "qp_info", &qp_info_);
         qp_iter = qp_info_->num_iter;
         log_qp_stats(mem, false, search_direction_status, qp_iter);
@@ -1487,7 +1542,7 @@ static int calculate_search_direction(ocp_nlp_dims *dims,
         {
             mem->search_direction_type = "FN";
         }
-        search_direction_status = byrd_omojokun_direction_computation(dims, config, opts, nlp_opts, nlp_in, nlp_out, mem, work, timer_tot);
+        search_direction_status = byrd_omojokun_direction_computation(dims, config, opts, nlp_opts, nlp_in, nlp_out, mem, work);
 
         double l1_inf_QP_feasibility = calculate_qp_l1_infeasibility(dims, mem, work, opts, mem->relaxed_qp_in, mem->relaxed_qp_out);
         if (config->globalization->needs_objective_value() == 1)
@@ -1530,9 +1585,6 @@ static int calculate_search_direction(ocp_nlp_dims *dims,
 int ocp_nlp_sqp_wfqp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
                 void *opts_, void *mem_, void *work_)
 {
-    acados_timer timer_tot, timer1;
-    acados_tic(&timer_tot);
-
     ocp_nlp_dims *dims = dims_;
     ocp_nlp_config *config = config_;
     ocp_nlp_sqp_wfqp_opts *opts = opts_;
@@ -1544,6 +1596,11 @@ int ocp_nlp_sqp_wfqp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
     ocp_nlp_res *nlp_res = nlp_mem->nlp_res;
     ocp_nlp_timings *nlp_timings = nlp_mem->nlp_timings;
 
+    acados_profiler *prof = nlp_mem->profiler;
+    acados_profiler_span span_tot, span_iter, span;
+    if (prof) prof->solve++;
+    acados_profiler_span_start(prof, &span_tot);
+
     ocp_nlp_sqp_wfqp_workspace *work = work_;
     ocp_nlp_workspace *nlp_work = work->nlp_work;
 
@@ -1593,6 +1650,7 @@ int ocp_nlp_sqp_wfqp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
 
     for (; nlp_mem->iter <= opts->nlp_opts->max_iter; nlp_mem->iter++) // <= needed such that after last iteration KKT residuals are checked before max_iter is thrown.
     {
+        if (prof) acados_profiler_span_start(prof, &span_iter);
         // We always evaluate the residuals until the last iteration
         // If the option "eval_residual_at_max_iter" is set, we also
         // evaluate the residuals after the last iteration.
@@ -1605,7 +1663,7 @@ int ocp_nlp_sqp_wfqp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
             }
             /* Prepare the QP data */
             // linearize NLP and update QP matrices
-            acados_tic(&timer1);
+            acados_profiler_span_start(prof, &span);
             set_pointers_for_hessian_evaluation(config, dims, nlp_in, nlp_out, nlp_opts, mem, nlp_work);
             // nominal QP solver
             ocp_nlp_approximate_qp_matrices(config, dims, nlp_in, nlp_out, nlp_opts, nlp_mem, nlp_work);
@@ -1621,7 +1679,7 @@ int ocp_nlp_sqp_wfqp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
             ocp_nlp_sqp_wfqp_approximate_feasibility_qp_constraint_vectors(config, dims, nlp_in, nlp_out, nlp_opts, mem, nlp_work, false);
             setup_hessian_matrices_for_qps(config, dims, nlp_in, nlp_out, opts, mem, nlp_work);
             //
-            nlp_timings->time_lin += acados_toc(&timer1);
+            nlp_timings->time_lin += acados_profiler_span_end(prof, &span, ACADOS_PROFILER_LIN, -1, nlp_mem->iter);
 
             // compute nlp residuals
             ocp_nlp_res_compute(dims, nlp_opts, nlp_in, nlp_out, nlp_res, nlp_mem, nlp_work);
@@ -1659,7 +1717,7 @@ int ocp_nlp_sqp_wfqp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
             // restore number of threads
             omp_set_num_threads(num_threads_bkp);
 #endif
-            nlp_timings->time_tot = acados_toc(&timer_tot);
+            nlp_timings->time_tot = acados_profiler_span_end(prof, &span_tot, ACADOS_PROFILER_SOLVE, -1, nlp_mem->iter);
             return mem->nlp_mem->status;
         }
 
@@ -1670,23 +1728,24 @@ int ocp_nlp_sqp_wfqp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
 
         /* Scale the QP */
         // scale the qp: includes constraints and objective
-        acados_tic(&timer1);
+        acados_profiler_span_start(prof, &span);
         ocp_nlp_qpscaling_scale_qp(dims->qpscaling, nlp_opts->qpscaling, nlp_mem->qpscaling, nominal_qp_in);
-        nlp_timings->time_qpscaling += acados_toc(&timer1);
+        nlp_timings->time_qpscaling += acados_profiler_span_end(prof, &span, ACADOS_PROFILER_QPSCALING, -1, nlp_mem->iter);
         ocp_nlp_sqp_wfqp_approximate_feasibility_qp_constraint_vectors(config, dims, nlp_in, nlp_out, nlp_opts, mem, nlp_work, true);
 
-        acados_tic(&timer1);
+        acados_profiler_span_start(prof, &span);
         ocp_nlp_qpscaling_scale_qp(dims->relaxed_qpscaling, nlp_opts->qpscaling, mem->relaxed_qpscaling_mem, mem->relaxed_qp_in); // ensures feasibility constraint Hessian is scaled
-        nlp_timings->time_qpscaling += acados_toc(&timer1);
+        nlp_timings->time_qpscaling += acados_profiler_span_end(prof, &span, ACADOS_PROFILER_QPSCALING, -1, nlp_mem->iter);
 
         /* Search Direction Computation */
-        search_direction_status = calculate_search_direction(dims, config, opts, nlp_opts, nlp_in, nlp_out, mem, work, timer_tot);
+        search_direction_status = calculate_search_direction(dims, config, opts, nlp_opts, nlp_in, nlp_out, mem, work);
         if (search_direction_status != ACADOS_SUCCESS)
         {
 #if defined(ACADOS_WITH_OPENMP)
             // restore number of threads
             omp_set_num_threads(num_threads_bkp);
 #endif
+            nlp_timings->time_tot = acados_profiler_span_end(prof, &span_tot, ACADOS_PROFILER_SOLVE, -1, nlp_mem->iter);
             return nlp_mem->status;
         }
 
@@ -1712,7 +1771,7 @@ int ocp_nlp_sqp_wfqp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
         }
         // NOTE on timings: currently all within globalization is accounted for within time_glob.
         //   QP solver times could be also attributed there alternatively. Cleanest would be to save them seperately.
-        acados_tic(&timer1);
+        acados_profiler_span_start(prof, &span);
 
         int globalization_status;
         globalization_status = config->globalization->find_acceptable_iterate(config, dims, nlp_in,
@@ -1725,7 +1784,7 @@ int ocp_nlp_sqp_wfqp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
                 printf("\nFailure in globalization, got status %d (%s)!\n", globalization_status, status_to_string(globalization_status));
             }
             nlp_mem->status = globalization_status;
-            nlp_timings->time_tot = acados_toc(&timer_tot);
+            nlp_timings->time_tot = acados_profiler_span_end(prof, &span_tot, ACADOS_PROFILER_SOLVE, -1, nlp_mem->iter);
 #if defined(ACADOS_WITH_OPENMP)
             // restore number of threads
             omp_set_num_threads(num_threads_bkp);
@@ -1734,7 +1793,8 @@ int ocp_nlp_sqp_wfqp(void *config_, void *dims_, void *nlp_in_, void *nlp_out_,
         }
 
         mem->stat[mem->stat_n*(nlp_mem->iter+1)+10] = mem->alpha;
-        nlp_timings->time_glob += acados_toc(&timer1);
+        nlp_timings->time_glob += acados_profiler_span_end(prof, &span, ACADOS_PROFILER_GLOB, -1, nlp_mem->iter);
+        if (prof) acados_profiler_span_end(prof, &span_iter, ACADOS_PROFILER_ITER, -1, nlp_mem->iter);
 
     }  // end SQP loop
 
@@ -1892,6 +1952,10 @@ int ocp_nlp_sqp_wfqp_precompute(void *config_, void *dims_, void *nlp_in_, void
     ocp_nlp_qpscaling_memory_get(dims->relaxed_qpscaling, mem->relaxed_qpscaling_mem, "scaled_qp_out", 0, &mem->relaxed_scaled_qp_out);
 
     set_relaxed_scaled_qp_in_matrix_pointers(mem);
+    // both scalings write rows of the shared scaled DCt with their own factors
+    bool DCt_shared = true;
+    ocp_nlp_qpscaling_memory_set(dims->qpscaling, nlp_mem->qpscaling, "DCt_shared", 0, &DCt_shared);
+    ocp_nlp_qpscaling_memory_set(dims->relaxed_qpscaling, mem->relaxed_qpscaling_mem, "DCt_shared", 0, &DCt_shared);
 
     // overwrite output pointers normally set in ocp_nlp_alias_memory_to_submodules
     for (int stage = 0; stage <= dims->N; stage++)
@@ -1907,9 +1971,6 @@ int ocp_nlp_sqp_wfqp_precompute(void *config_, void *dims_, void *nlp_in_, void
 void ocp_nlp_sqp_wfqp_eval_param_sens(void *config_, void *dims_, void *opts_, void *mem_, void *work_,
                                  char *field, int stage, int index, void *sens_nlp_out_)
 {
-    acados_timer timer_tot;
-    acados_tic(&timer_tot);
-
     ocp_nlp_dims *dims = dims_;
     ocp_nlp_config *config = config_;
     ocp_nlp_sqp_wfqp_opts *opts = opts_;
@@ -1917,13 +1978,16 @@ void ocp_nlp_sqp_wfqp_eval_param_sens(void *config_, void *dims_, void *opts_, v
     ocp_nlp_memory *nlp_mem = mem->nlp_mem;
     ocp_nlp_out *sens_nlp_out = sens_nlp_out_;
 
+    acados_profiler_span span;
+    acados_profiler_span_start(nlp_mem->profiler, &span);
+
     ocp_nlp_sqp_wfqp_workspace *work = work_;
     ocp_nlp_workspace *nlp_work = work->nlp_work;
 
     ocp_nlp_common_eval_param_sens(config, dims, opts->nlp_opts, nlp_mem, nlp_work,
                                  field, stage, index, sens_nlp_out);
 
-    nlp_mem->nlp_timings->time_solution_sensitivities = acados_toc(&timer_tot);
+    nlp_mem->nlp_timings->time_solution_sensitivities = acados_profiler_span_end(nlp_mem->profiler, &span, ACADOS_PROFILER_SENS, -1, nlp_mem->iter);
 
     return;
 }
@@ -63,6 +63,7 @@ typedef struct
     bool allow_direction_mode_switch_to_nominal; // if true, mode can switch from Byrd-Omojokun to nominal mode
     double feasibility_qp_hessian_scalar; // multiplication factor of feasibility QP Hessian
     double byrd_omojokon_slack_relaxation_factor; // multiplication factor of slack variables in Byrd-Omojokun bound factor
+    bool warm_start_nominal_qp_from_feasibility_qp; // initialize the primal variables of the Byrd-Omojokun nominal QP with the feasibility QP solution
 } ocp_nlp_sqp_wfqp_opts;
 
 
@@ -116,6 +117,7 @@ typedef struct
     int absolute_nns; // sum of all nns[i]
 
     int qps_solved_in_iter;
+    bool nominal_qp_initialized_from_feasibility_qp;
 
     // QP solver with always feasible QPs
     ocp_qp_xcond_solver relaxed_qp_solver;
@@ -30,6 +30,7 @@
 
 
 #include <assert.h>
+#include <string.h>
 
 // blasfeo
 #include "blasfeo_d_blasfeo_api.h"
@@ -374,8 +375,10 @@ static void update_hessian_structure(const ocp_qp_in *in, ocp_qp_osqp_memory *me
 
             for (ii = 0; ii <= jj; ii++)
             {
-                // we write only the upper triangular part
+                // we write only the upper triangular part,
+                // i.e. the lower triangular part of RSQ[kk] in row-major order
                 mem->P_i[nn] = offset + ii;
+                mem->P_x_src[nn] = &BLASFEO_DMATEL(in->RSQrq+kk, jj, ii);
                 nn++;
             }
         }
@@ -389,6 +392,7 @@ static void update_hessian_structure(const ocp_qp_in *in, ocp_qp_osqp_memory *me
 
             // diagonal
             mem->P_i[nn] = offset + jj;
+            mem->P_x_src[nn] = &BLASFEO_DVECEL(in->Z+kk, jj);
             nn++;
         }
 
@@ -402,33 +406,29 @@ static void update_hessian_structure(const ocp_qp_in *in, ocp_qp_osqp_memory *me
 
 static void update_hessian_data(const ocp_qp_in *in, ocp_qp_osqp_memory *mem)
 {
-    ocp_qp_dims *dims = in->dim;
+    // gather the upper triangular part of P through the map built in update_hessian_structure
+    c_int nnz = mem->P_p[mem->osqp_data->n];
+    c_float **src = mem->P_x_src;
+    c_float *P_x = mem->P_x;
 
-    int N = dims->N;
-    int *nx = dims->nx;
-    int *nu = dims->nu;
-    int *ns = dims->ns;
+    for (c_int nn = 0; nn < nnz; nn++)
+        P_x[nn] = *src[nn];
+}
 
-    int ii, kk;
 
-    // Traversing the matrix in column-major order
-    c_int nn = 0;
-    for (kk = 0; kk <= N; kk++)
-    {
-        // writing RSQ[kk]
-        // we write the lower triangular part in row-major order
-        // that's the same as writing the upper triangular part in
-        // column-major order
-        for (ii = 0; ii < nx[kk] + nu[kk]; ii++)
-        {
-            blasfeo_unpack_dmat(1, ii+1, in->RSQrq+kk, ii, 0, mem->P_x+nn, 1);
-            nn += ii+1;
-        }
 
-        // write Z[kk]
-        blasfeo_unpack_dvec(2*ns[kk], in->Z+kk, 0, mem->P_x+nn, 1);
-        nn += 2*ns[kk];
-    }
+static void set_constraints_matrix_const(ocp_qp_osqp_memory *mem, c_int nn, c_float val)
+{
+    mem->A_x[nn] = val;
+}
+
+
+
+static void set_constraints_matrix_src(ocp_qp_osqp_memory *mem, c_int nn, c_float *src)
+{
+    mem->A_x_idx[mem->A_nvar] = nn;
+    mem->A_x_src[mem->A_nvar] = src;
+    mem->A_nvar++;
 }
 
 
@@ -460,7 +460,9 @@ static void update_constraints_matrix_structure(const ocp_qp_in *in, ocp_qp_osqp
 
     slk_start += con_start;
 
-    // CSC format: A_i are row indices and A_p are column pointers
+    // CSC format: A_i are row indices and A_p are column pointers;
+    // constant entries of A_x are written here, the others are recorded in the gather map
+    mem->A_nvar = 0;
     c_int nn = 0, col = 0;
     for (kk = 0; kk <= N; kk++)
     {
@@ -487,6 +489,7 @@ static void update_constraints_matrix_structure(const ocp_qp_in *in, ocp_qp_osqp
                 for (ii = 0; ii < nx[kk + 1]; ii++)
                 {
                     mem->A_i[nn] = row_offset_dyn + ii;
+                    set_constraints_matrix_src(mem, nn, &BLASFEO_DMATEL(in->BAbt+kk, jj, ii));
                     nn++;
                 }
             }
@@ -497,6 +500,7 @@ static void update_constraints_matrix_structure(const ocp_qp_in *in, ocp_qp_osqp
                 if (in->idxb[kk][ii] == jj)
                 {
                     mem->A_i[nn] = con_start + row_offset_con + ii;
+                    set_constraints_matrix_const(mem, nn, 1.0);
                     nn++;
                     break;
                 }
@@ -507,6 +511,7 @@ static void update_constraints_matrix_structure(const ocp_qp_in *in, ocp_qp_osqp
             for (ii = 0; ii < ng[kk]; ii++)
             {
                 mem->A_i[nn] = con_start + row_offset_con + nb[kk] + ii;
+                set_constraints_matrix_src(mem, nn, &BLASFEO_DMATEL(in->DCt+kk, jj, ii));
                 nn++;
             }
 
@@ -525,6 +530,7 @@ static void update_constraints_matrix_structure(const ocp_qp_in *in, ocp_qp_osqp
                         }
                     }
                     mem->A_i[nn] = con_start + row_offset_con + nb[kk] + ng[kk] + itmp;
+                    set_constraints_matrix_const(mem, nn, 1.0);
                     nn++;
                 }
             }
@@ -537,6 +543,7 @@ static void update_constraints_matrix_structure(const ocp_qp_in *in, ocp_qp_osqp
                     if (in->idxs_rev[kk][nb[kk]+ii]>=0) // softed
                     {
                         mem->A_i[nn] = con_start + row_offset_con + nb[kk] + ng[kk] + nsb + itmp;
+                        set_constraints_matrix_src(mem, nn, &BLASFEO_DMATEL(in->DCt+kk, jj, ii));
                         nn++;
                         itmp++;
                     }
@@ -555,6 +562,7 @@ static void update_constraints_matrix_structure(const ocp_qp_in *in, ocp_qp_osqp
             {
                 // write column from -I
                 mem->A_i[nn] = row_offset_dyn - nx[kk] + jj;
+                set_constraints_matrix_const(mem, nn, -1.0);
                 nn++;
             }
 
@@ -564,6 +572,7 @@ static void update_constraints_matrix_structure(const ocp_qp_in *in, ocp_qp_osqp
                 for (ii = 0; ii < nx[kk + 1]; ii++)
                 {
                     mem->A_i[nn] = row_offset_dyn + ii;
+                    set_constraints_matrix_src(mem, nn, &BLASFEO_DMATEL(in->BAbt+kk, nu[kk]+jj, ii));
                     nn++;
                 }
             }
@@ -574,6 +583,7 @@ static void update_constraints_matrix_structure(const ocp_qp_in *in, ocp_qp_osqp
                 if (in->idxb[kk][ii] == nu[kk] + jj)
                 {
                     mem->A_i[nn] = con_start + row_offset_con + ii;
+                    set_constraints_matrix_const(mem, nn, 1.0);
                     nn++;
                     break;
                 }
@@ -584,6 +594,7 @@ static void update_constraints_matrix_structure(const ocp_qp_in *in, ocp_qp_osqp
             for (ii = 0; ii < ng[kk]; ii++)
             {
                 mem->A_i[nn] = con_start + row_offset_con + nb[kk] + ii;
+                set_constraints_matrix_src(mem, nn, &BLASFEO_DMATEL(in->DCt+kk, nu[kk]+jj, ii));
                 nn++;
             }
 
@@ -602,6 +613,7 @@ static void update_constraints_matrix_structure(const ocp_qp_in *in, ocp_qp_osqp
                         }
                     }
                     mem->A_i[nn] = con_start + row_offset_con + nb[kk] + ng[kk] + itmp;
+                    set_constraints_matrix_const(mem, nn, 1.0);
                     nn++;
                 }
             }
@@ -614,6 +626,7 @@ static void update_constraints_matrix_structure(const ocp_qp_in *in, ocp_qp_osqp
                     if (in->idxs_rev[kk][nb[kk]+ii]>=0) // softed
                     {
                         mem->A_i[nn] = con_start + row_offset_con + nb[kk] + ng[kk] + nsb + itmp;
+                        set_constraints_matrix_src(mem, nn, &BLASFEO_DMATEL(in->DCt+kk, nu[kk]+jj, ii));
                         nn++;
                         itmp++;
                     }
@@ -634,6 +647,7 @@ static void update_constraints_matrix_structure(const ocp_qp_in *in, ocp_qp_osqp
                 if (in->idxs_rev[kk][ii]==jj)
                 {
                     mem->A_i[nn] = con_start + row_offset_con + ii;
+                    set_constraints_matrix_const(mem, nn, 1.0);
                     nn++;
                     // no break, there could possibly be multiple
                 }
@@ -641,6 +655,7 @@ static void update_constraints_matrix_structure(const ocp_qp_in *in, ocp_qp_osqp
 
             // nonnegativity constraint
             mem->A_i[nn] = slk_start + row_offset_slk + jj;
+            set_constraints_matrix_const(mem, nn, 1.0);
             nn++;
         }
 
@@ -657,6 +672,7 @@ static void update_constraints_matrix_structure(const ocp_qp_in *in, ocp_qp_osqp
                 if (in->idxs_rev[kk][ii]==jj)
                 {
                     mem->A_i[nn] = con_start + row_offset_con + nb[kk] + ng[kk] + itmp;
+                    set_constraints_matrix_const(mem, nn, -1.0);
                     nn++;
                     // no break, there could possibly be multiple
                 }
@@ -668,6 +684,7 @@ static void update_constraints_matrix_structure(const ocp_qp_in *in, ocp_qp_osqp
 
             // nonnegativity constraint
             mem->A_i[nn] = slk_start + row_offset_slk + ns[kk] + jj;
+            set_constraints_matrix_const(mem, nn, 1.0);
             nn++;
         }
 
@@ -682,171 +699,17 @@ static void update_constraints_matrix_structure(const ocp_qp_in *in, ocp_qp_osqp
 
 
 
-// TODO move constant stuff like I to structure routine
 static void update_constraints_matrix_data(const ocp_qp_in *in, ocp_qp_osqp_memory *mem)
 {
-    ocp_qp_dims *dims = in->dim;
-
-    int N = dims->N;
-    int *nx = dims->nx;
-    int *nu = dims->nu;
-    int *nb = dims->nb;
-    int *ng = dims->ng;
-    int *ns = dims->ns;
-
-    int ii, jj, kk;
-
-
-    // Traverse matrix in column-major order
-    c_int nn = 0;
-    for (kk = 0; kk <= N; kk++)
-    {
-
-        // control variables
-        for (jj = 0; jj < nu[kk]; jj++)
-        {
-            if (kk < dims->N)
-            {
-                // write column from B
-                blasfeo_unpack_dmat(1, nx[kk+1], in->BAbt+kk, jj, 0, mem->A_x+nn, 1);
-                nn += nx[kk+1];
-            }
-
-            // write bound on u
-            for (ii = 0; ii < dims->nb[kk]; ii++)
-            {
-                if (in->idxb[kk][ii] == jj)
-                {
-                    mem->A_x[nn] = 1.0;
-                    nn++;
-                    break;
-                }
-            }
-            int idxbu = ii;
-
-            // write column from D
-            blasfeo_unpack_dmat(1, ng[kk], in->DCt+kk, jj, 0, mem->A_x+nn, 1);
-            nn += ng[kk];
-
-            // replicated softed bound on u
-            if (idxbu<nb[kk]) // bounded input
-            {
-                if (in->idxs_rev[kk][idxbu]>=0) // softed bounded input
-                {
-                    mem->A_x[nn] = 1.0;
-                    nn++;
-                }
-            }
-
-            // replicated softed D
-            for (ii = 0; ii < ng[kk]; ii++)
-            {
-                if (in->idxs_rev[kk][nb[kk]+ii]>=0) // softed
-                {
-                    mem->A_x[nn] = BLASFEO_DMATEL(in->DCt+kk, jj, ii);
-                    nn++;
-                }
-            }
-
-        }
-
-        // state variables
-        for (jj = 0; jj < nx[kk]; jj++)
-        {
-            if (kk > 0)
-            {
-                // write column from -I
-                mem->A_x[nn] = -1.0;
-                nn++;
-            }
-
-            if (kk < N)
-            {
-                // write column from A
-                blasfeo_unpack_dmat(1, nx[kk+1], in->BAbt+kk, nu[kk]+jj, 0, mem->A_x+nn, 1);
-                nn += nx[kk+1];
-            }
-
-            // write bound on x
-            for (ii = 0; ii < dims->nb[kk]; ii++)
-            {
-                if (in->idxb[kk][ii] == dims->nu[kk] + jj)
-                {
-                    mem->A_x[nn] = 1.0;
-                    nn++;
-                    break;
-                }
-            }
-            int idxbx = ii;
-
-            // write column from C
-            blasfeo_unpack_dmat(1, ng[kk], in->DCt+kk, nu[kk]+jj, 0, mem->A_x+nn, 1);
-            nn += ng[kk];
-
-            // replicated softed bound on x
-            if (idxbx<nb[kk]) // bounded input
-            {
-                if (in->idxs_rev[kk][idxbx]>=0) // softed bounded input
-                {
-                    mem->A_x[nn] = 1.0;
-                    nn++;
-                }
-            }
-
-            // replicated softed C
-            for (ii = 0; ii < ng[kk]; ii++)
-            {
-                if (in->idxs_rev[kk][nb[kk]+ii]>=0) // softed
-                {
-                    mem->A_x[nn] = BLASFEO_DMATEL(in->DCt+kk, nu[kk]+jj, ii);
-                    nn++;
-                }
-            }
-
-        }
-
-        // slack variables on lower inequalities (original)
-        for (jj = 0; jj < ns[kk]; jj++)
-        {
-
-            // soft constraint
-            for (ii=0; ii<nb[kk]+ng[kk]; ii++)
-            {
-                if (in->idxs_rev[kk][ii]==jj)
-                {
-                    mem->A_x[nn] = 1.0;
-                    nn++;
-                    // no break, there could possibly be multiple
-                }
-            }
-
-            // nonnegativity constraint
-            mem->A_x[nn] = 1.0;
-            nn++;
-        }
-
-        // slack variables on upper inequalities (replicated)
-        for (jj = 0; jj < ns[kk]; jj++)
-        {
-
-            // soft constraint
-            for (ii=0; ii<nb[kk]+ng[kk]; ii++)
-            {
-                if (in->idxs_rev[kk][ii]==jj)
-                {
-                    mem->A_x[nn] = -1.0;
-                    nn++;
-                    // no break, there could possibly be multiple
-                }
-            }
-
-            // nonnegativity constraint
-            mem->A_x[nn] = 1.0;
-            nn++;
-        }
-
-    }
-
+    // constant entries are set in update_constraints_matrix_structure,
+    // only gather the ones coming from BAbt and DCt
+    c_int nvar = mem->A_nvar;
+    c_int *idx = mem->A_x_idx;
+    c_float **src = mem->A_x_src;
+    c_float *A_x = mem->A_x;
+
+    for (c_int nn = 0; nn < nvar; nn++)
+        A_x[idx[nn]] = *src[nn];
 }
 
 
@@ -933,10 +796,13 @@ static void update_bounds(const ocp_qp_in *in, ocp_qp_osqp_memory *mem)
 static void ocp_qp_osqp_update_memory(const ocp_qp_in *in, const ocp_qp_osqp_opts *opts,
                                       ocp_qp_osqp_memory *mem)
 {
-    if (mem->first_run)
+    // the sparsity pattern does not change between calls, the gather map
+    // only needs to be rebuilt if the QP data is read from a different qp_in
+    if (mem->first_run || mem->gather_qp_in != in)
     {
         update_hessian_structure(in, mem);
         update_constraints_matrix_structure(in, mem);
+        mem->gather_qp_in = in;
     }
 
     update_bounds(in, mem);
@@ -996,6 +862,8 @@ void ocp_qp_osqp_opts_initialize_default(void *config_, void *dims_, void *opts_
     opts->osqp_opts->check_termination = 5;
     opts->osqp_opts->warm_start = 1;
 
+    opts->reuse_factorization = 0;
+
     return;
 }
 
@@ -1069,6 +937,11 @@ void ocp_qp_osqp_opts_set(void *config_, void *opts_, const char *field, void *v
         opts->osqp_opts->warm_start = *tmp_ptr;
         // printf("\nwarm start %d\n", opts->osqp_opts->warm_start);
     }
+    else if (!strcmp(field, "reuse_factorization"))
+    {
+        bool *tmp_ptr = value;
+        opts->reuse_factorization = *tmp_ptr;
+    }
     else
     {
         printf("\nerror: ocp_qp_osqp_opts_set: wrong field: %s\n", field);
@@ -1189,6 +1062,13 @@ acados_size_t ocp_qp_osqp_memory_calculate_size(void *config_, void *dims_, void
     size += A_nnzmax * sizeof(c_int);    // A_i
     size += (n + 1) * sizeof(c_int);     // A_p
 
+    size += P_nnzmax * sizeof(c_float);  // P_x_fact
+    size += A_nnzmax * sizeof(c_float);  // A_x_fact
+
+    size += P_nnzmax * sizeof(c_float *);  // P_x_src
+    size += A_nnzmax * sizeof(c_float *);  // A_x_src
+    size += A_nnzmax * sizeof(c_int);      // A_x_idx
+
     size += sizeof(OSQPData);
     size += 2 * sizeof(csc);  // matrices P and A
     size += osqp_workspace_calculate_size(n, m, P_nnzmax, A_nnzmax);
@@ -1504,6 +1384,9 @@ void *ocp_qp_osqp_memory_assign(void *config_, void *dims_, void *opts_, void *r
     mem->P_nnzmax = P_nnzmax;
     mem->A_nnzmax = A_nnzmax;
     mem->first_run = 1;
+    mem->gather_qp_in = NULL;
+    mem->A_nvar = 0;
+    mem->num_refactorizations = 0;
 
     align_char_to(8, &c_ptr);
 
@@ -1523,6 +1406,19 @@ void *ocp_qp_osqp_memory_assign(void *config_, void *dims_, void *opts_, void *r
     mem->A_x = (c_float *) c_ptr;
     c_ptr += (mem->A_nnzmax) * sizeof(c_float);
 
+    mem->P_x_fact = (c_float *) c_ptr;
+    c_ptr += (mem->P_nnzmax) * sizeof(c_float);
+
+    mem->A_x_fact = (c_float *) c_ptr;
+    c_ptr += (mem->A_nnzmax) * sizeof(c_float);
+
+    // pointers
+    mem->P_x_src = (c_float **) c_ptr;
+    c_ptr += (mem->P_nnzmax) * sizeof(c_float *);
+
+    mem->A_x_src = (c_float **) c_ptr;
+    c_ptr += (mem->A_nnzmax) * sizeof(c_float *);
+
     // ints
     mem->P_i = (c_int *) c_ptr;
     c_ptr += (mem->P_nnzmax) * sizeof(c_int);
@@ -1536,6 +1432,9 @@ void *ocp_qp_osqp_memory_assign(void *config_, void *dims_, void *opts_, void *r
     mem->A_p = (c_int *) c_ptr;
     c_ptr += (n + 1) * sizeof(c_int);
 
+    mem->A_x_idx = (c_int *) c_ptr;
+    c_ptr += (mem->A_nnzmax) * sizeof(c_int);
+
     mem->osqp_data = (OSQPData *) c_ptr;
     c_ptr += sizeof(OSQPData);
 
@@ -1589,6 +1488,11 @@ void ocp_qp_osqp_memory_get(void *config_, void *mem_, const char *field, void*
         int *tmp_ptr = value;
         *tmp_ptr = mem->status;
     }
+    else if (!strcmp(field, "num_refactorizations"))
+    {
+        int *tmp_ptr = value;
+        *tmp_ptr = mem->num_refactorizations;
+    }
     else
     {
         printf("\nerror: ocp_qp_osqp_memory_get: field %s not available\n", field);
@@ -1625,6 +1529,32 @@ acados_size_t ocp_qp_osqp_workspace_calculate_size(void *config_, void *dims_, v
  * functions
  ************************************************/
 
+// checks if P and A differ from the values in the current KKT factorization and stores them
+static int osqp_P_A_changed(ocp_qp_osqp_memory *mem, c_int P_nnz, c_int A_nnz)
+{
+    int changed = 0;
+    for (c_int ii = 0; ii < P_nnz; ii++)
+    {
+        if (mem->P_x[ii] != mem->P_x_fact[ii])
+        {
+            changed = 1;
+            break;
+        }
+    }
+    for (c_int ii = 0; !changed && ii < A_nnz; ii++)
+    {
+        if (mem->A_x[ii] != mem->A_x_fact[ii])
+            changed = 1;
+    }
+    if (changed)
+    {
+        memcpy(mem->P_x_fact, mem->P_x, P_nnz * sizeof(c_float));
+        memcpy(mem->A_x_fact, mem->A_x, A_nnz * sizeof(c_float));
+    }
+    return changed;
+}
+
+
 static void fill_in_qp_out(const ocp_qp_in *in, ocp_qp_out *out, ocp_qp_osqp_memory *mem)
 {
     ocp_qp_dims *dims = in->dim;
@@ -1739,12 +1669,20 @@ int ocp_qp_osqp(void *config_, void *qp_in_, void *qp_out_, void *opts_, void *m
 
     acados_tic(&qp_timer);
 
+    c_int n = mem->osqp_data->n;
+    c_int P_nnz = mem->P_p[n];
+    c_int A_nnz = mem->A_p[n];
+
     // update osqp workspace with new data
     if (!mem->first_run)
     {
         osqp_update_lin_cost(mem->osqp_work, mem->q);
-        osqp_update_P_A(mem->osqp_work, mem->P_x, NULL, mem->P_nnzmax, mem->A_x, NULL,
-                        mem->A_nnzmax);
+        // with unchanged P and A, the KKT factorization and the data scaling stay valid
+        if (!opts->reuse_factorization || osqp_P_A_changed(mem, P_nnz, A_nnz))
+        {
+            osqp_update_P_A(mem->osqp_work, mem->P_x, NULL, P_nnz, mem->A_x, NULL, A_nnz);
+            mem->num_refactorizations++;
+        }
         osqp_update_bounds(mem->osqp_work, mem->l, mem->u);
         cpy_osqp_settings(opts->osqp_opts, mem->osqp_work->settings);
     }
@@ -1752,6 +1690,9 @@ int ocp_qp_osqp(void *config_, void *qp_in_, void *qp_out_, void *opts_, void *m
     {
         // mem->osqp_work = osqp_setup(mem->osqp_data, opts->osqp_opts);
         osqp_init_data(mem->osqp_data, opts->osqp_opts, mem->osqp_work);
+        memcpy(mem->P_x_fact, mem->P_x, P_nnz * sizeof(c_float));
+        memcpy(mem->A_x_fact, mem->A_x, A_nnz * sizeof(c_float));
+        mem->num_refactorizations++;
         mem->first_run = 0;
     }
 
@@ -1763,9 +1704,12 @@ int ocp_qp_osqp(void *config_, void *qp_in_, void *qp_out_, void *opts_, void *m
 
     // solve OSQP
     acados_tic(&solver_call_timer);
+    mem->osqp_work->info->rho_updates = 0;
     osqp_solve(mem->osqp_work);
-    mem->time_qp_solver_call = acados_toc(&solver_call_timer);
     mem->iter = mem->osqp_work->info->iter;
+    // each adaptive rho update refactorizes the KKT matrix
+    mem->num_refactorizations += mem->osqp_work->info->rho_updates;
+    mem->time_qp_solver_call = acados_toc(&solver_call_timer);
 
     // fill qp_out
     fill_in_qp_out(qp_in, qp_out, mem);
@@ -1774,7 +1718,7 @@ int ocp_qp_osqp(void *config_, void *qp_in_, void *qp_out_, void *opts_, void *m
     // info
     info->solve_QP_time = acados_toc(&qp_timer);
     info->total_time = acados_toc(&tot_timer);
-    info->num_iter = mem->osqp_work->info->iter;
+    info->num_iter = mem->iter;
     info->t_computed = 1;
 
     c_int osqp_status = mem->osqp_work->info->status_val;
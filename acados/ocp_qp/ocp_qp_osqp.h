@@ -47,6 +47,7 @@ typedef struct ocp_qp_osqp_opts_
 {
     OSQPSettings *osqp_opts;
     int print_level;
+    int reuse_factorization;  // skip the KKT factorization if P and A are unchanged since the last one
 } ocp_qp_osqp_opts;
 
 
@@ -68,12 +69,24 @@ typedef struct ocp_qp_osqp_memory_
     c_int *A_p;
     c_float *A_x;
 
+    // values of P and A in the current KKT factorization
+    c_float *P_x_fact;
+    c_float *A_x_fact;
+
+    // gather map from ocp_qp_in to the CSC values, built together with the structure
+    const void *gather_qp_in;  // qp_in the gather map was built for
+    c_float **P_x_src;         // source of each P_x entry
+    c_int A_nvar;              // number of non-constant A_x entries
+    c_int *A_x_idx;            // their position in A_x
+    c_float **A_x_src;         // their source
+
     OSQPData *osqp_data;
     OSQPWorkspace *osqp_work;
 
     double time_qp_solver_call;
     int iter;
     int status;
+    int num_refactorizations;  // KKT factorizations incl. adaptive rho updates, accumulated over calls
 
 } ocp_qp_osqp_memory;
 
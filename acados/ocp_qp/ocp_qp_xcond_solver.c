@@ -439,7 +439,8 @@ void ocp_qp_xcond_solver_memory_get(void *config_, void *mem_, const char *field
     // TODO extract module name as for opts_set
 
     if (!strcmp(field, "time_qp_solver_call") || !strcmp(field, "tau_iter") ||
-        !strcmp(field, "iter") || !strcmp(field, "status"))
+        !strcmp(field, "iter") || !strcmp(field, "status") ||
+        !strcmp(field, "num_refactorizations"))
     {
         qp_solver->memory_get(qp_solver, mem->solver_memory, field, value);
     }
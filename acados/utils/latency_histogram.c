@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) The acados authors.
+ *
+ * This file is part of acados.
+ *
+ * The 2-Clause BSD License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.;
+ */
+
+
+#include "acados/utils/latency_histogram.h"
+
+#include <math.h>
+
+
+
+static int bucket_index(double value)
+{
+    double ns = value * 1e9;
+    if (!(ns >= 1.0))
+        return 0;
+
+    int exponent;
+    double mantissa = frexp(ns, &exponent);  // ns = mantissa * 2^exponent, mantissa in [0.5, 1)
+    exponent -= 1;
+    if (exponent >= ACADOS_LATENCY_HIST_NUM_EXPONENTS)
+        return ACADOS_LATENCY_HIST_NUM_BUCKETS - 1;
+
+    int sub_bucket = (int) ((2.0 * mantissa - 1.0) * ACADOS_LATENCY_HIST_SUB_BUCKETS);
+    return exponent * ACADOS_LATENCY_HIST_SUB_BUCKETS + sub_bucket;
+}
+
+
+
+// midpoint of the bucket in seconds
+static double bucket_value(int index)
+{
+    int exponent = index / ACADOS_LATENCY_HIST_SUB_BUCKETS;
+    int sub_bucket = index % ACADOS_LATENCY_HIST_SUB_BUCKETS;
+    return ldexp(1.0 + (sub_bucket + 0.5) / ACADOS_LATENCY_HIST_SUB_BUCKETS, exponent) * 1e-9;
+}
+
+
+
+void acados_latency_histogram_reset(acados_latency_histogram *hist)
+{
+    for (int i = 0; i < ACADOS_LATENCY_HIST_NUM_BUCKETS; i++)
+        hist->counts[i] = 0;
+    hist->count = 0;
+    hist->num_deadline_misses = 0;
+    hist->sum = 0.0;
+    hist->max = 0.0;
+}
+
+
+
+void acados_latency_histogram_record(acados_latency_histogram *hist, double value, double deadline)
+{
+    hist->counts[bucket_index(value)]++;
+    hist->count++;
+    hist->sum += value;
+    if (value > hist->max)
+        hist->max = value;
+    if (deadline > 0.0 && value > deadline)
+        hist->num_deadline_misses++;
+}
+
+
+
+double acados_latency_histogram_quantile(acados_latency_histogram *hist, double q)
+{
+    if (hist->count == 0)
+        return 0.0;
+
+    long rank = (long) ceil(q * hist->count);
+    if (rank < 1)
+        rank = 1;
+
+    long cumulative = 0;
+    for (int i = 0; i < ACADOS_LATENCY_HIST_NUM_BUCKETS; i++)
+    {
+        cumulative += hist->counts[i];
+        if (cumulative >= rank)
+        {
+            // the last bucket also holds all values beyond the range
+            if (i == ACADOS_LATENCY_HIST_NUM_BUCKETS - 1)
+                return hist->max;
+            double value = bucket_value(i);
+            return value < hist->max ? value : hist->max;
+        }
+    }
+    return hist->max;
+}
+
+
+
+void acados_latency_histogram_summary(acados_latency_histogram *hist, double *out)
+{
+    out[0] = (double) hist->count;
+    out[1] = hist->count > 0 ? hist->sum / hist->count : 0.0;
+    out[2] = acados_latency_histogram_quantile(hist, 0.5);
+    out[3] = acados_latency_histogram_quantile(hist, 0.99);
+    out[4] = acados_latency_histogram_quantile(hist, 0.999);
+    out[5] = hist->max;
+    out[6] = (double) hist->num_deadline_misses;
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) The acados authors.
+ *
+ * This file is part of acados.
+ *
+ * The 2-Clause BSD License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.;
+ */
+
+
+#ifndef ACADOS_UTILS_LATENCY_HISTOGRAM_H_
+#define ACADOS_UTILS_LATENCY_HISTOGRAM_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "acados/utils/types.h"
+
+
+
+// log-linear buckets: each power of two nanoseconds is split into SUB_BUCKETS linear buckets,
+// such that the relative error of a reported quantile is below 1/(2*SUB_BUCKETS)
+#define ACADOS_LATENCY_HIST_SUB_BUCKETS 16
+#define ACADOS_LATENCY_HIST_NUM_EXPONENTS 40  // covers 1 ns to ~18 min
+#define ACADOS_LATENCY_HIST_NUM_BUCKETS (ACADOS_LATENCY_HIST_SUB_BUCKETS * ACADOS_LATENCY_HIST_NUM_EXPONENTS)
+
+
+
+/** Fixed size histogram of durations, which does not allocate memory when recording. */
+typedef struct
+{
+    long counts[ACADOS_LATENCY_HIST_NUM_BUCKETS];
+    long count;
+    long num_deadline_misses;
+    double sum;  // [s]
+    double max;  // [s]
+} acados_latency_histogram;
+
+
+
+//
+void acados_latency_histogram_reset(acados_latency_histogram *hist);
+/** Records a duration in seconds, counts a deadline miss if deadline > 0 and value > deadline. */
+void acados_latency_histogram_record(acados_latency_histogram *hist, double value, double deadline);
+/** Returns the q-quantile in seconds, 0 <= q <= 1, at most the maximum recorded value; 0 if nothing was recorded. */
+double acados_latency_histogram_quantile(acados_latency_histogram *hist, double q);
+/** Writes count, mean, p50, p99, p99.9, max, num_deadline_misses into out[7]. */
+void acados_latency_histogram_summary(acados_latency_histogram *hist, double *out);
+
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif  // ACADOS_UTILS_LATENCY_HISTOGRAM_H_
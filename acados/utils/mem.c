@@ -29,10 +29,20 @@
  */
 
 
+// mmap flags MAP_ANONYMOUS, MAP_HUGETLB and madvise are not declared in strict C99 mode
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE
+#endif
+
 // external
 #include <assert.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
 
 // blasfeo
 #include "blasfeo_d_aux.h"
@@ -97,6 +107,88 @@ void *acados_calloc(size_t nitems, acados_size_t size)
     return ptr;
 }
 
+// header in front of the region returned by acados_arena_alloc
+#define ARENA_HEADER_SIZE 64
+#define ARENA_HUGEPAGE_SIZE (2*1024*1024)
+
+typedef struct
+{
+    size_t size;   // size of the underlying allocation
+    void *base;    // start of the underlying allocation
+    int is_mmap;
+} arena_header;
+
+void *acados_arena_alloc(acados_size_t size, bool use_hugepages)
+{
+    size_t total = size + 2*ARENA_HEADER_SIZE;
+    void *base = NULL;
+    int is_mmap = 0;
+
+#if defined(__linux__)
+    if (use_hugepages)
+    {
+        total = (total + ARENA_HUGEPAGE_SIZE - 1) / ARENA_HUGEPAGE_SIZE * ARENA_HUGEPAGE_SIZE;
+#if defined(MAP_HUGETLB)
+        // explicit huge pages, only available if reserved via /proc/sys/vm/nr_hugepages
+        base = mmap(NULL, total, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (base == MAP_FAILED)
+            base = NULL;
+#endif
+        if (base == NULL)
+        {
+            // fall back to transparent huge pages
+            base = mmap(NULL, total, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (base == MAP_FAILED)
+                base = NULL;
+#if defined(MADV_HUGEPAGE)
+            if (base != NULL)
+                madvise(base, total, MADV_HUGEPAGE);
+#endif
+        }
+        if (base != NULL)
+            is_mmap = 1;
+    }
+#else
+    (void) use_hugepages;
+#endif
+
+    if (base == NULL)
+    {
+        base = malloc(total);
+        if (base == NULL)
+            return NULL;
+    }
+
+    // first touch: fault in all pages on the NUMA node of the calling thread
+    memset(base, 0, total);
+
+    char *c_ptr = (char *) base + sizeof(arena_header);
+    align_char_to(ARENA_HEADER_SIZE, &c_ptr);
+
+    arena_header *header = (arena_header *) (c_ptr - sizeof(arena_header));
+    header->size = total;
+    header->base = base;
+    header->is_mmap = is_mmap;
+
+    return c_ptr;
+}
+
+void acados_arena_free(void *ptr)
+{
+    if (ptr == NULL)
+        return;
+
+    arena_header *header = (arena_header *) ((char *) ptr - sizeof(arena_header));
+#if defined(__linux__)
+    if (header->is_mmap)
+    {
+        munmap(header->base, header->size);
+        return;
+    }
+#endif
+    free(header->base);
+}
+
 void assign_and_advance_double_ptrs(int n, double ***v, char **ptr)
 {
     assert((size_t) *ptr % acados_get_pointer_size() == 0 && "pointer not aligned properly!");
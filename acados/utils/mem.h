@@ -58,6 +58,13 @@ void *acados_malloc(size_t nitems, acados_size_t size);
 // uses always calloc
 void *acados_calloc(size_t nitems, acados_size_t size);
 
+// allocate one zero initialized, 64 byte aligned region, optionally backed by huge pages (Linux);
+// all pages are touched by the calling thread, such that they are placed on its NUMA node
+void *acados_arena_alloc(acados_size_t size, bool use_hugepages);
+
+// free memory allocated with acados_arena_alloc
+void acados_arena_free(void *ptr);
+
 // allocate vector of pointers to vectors of doubles and advance pointer
 void assign_and_advance_double_ptrs(int n, double ***v, char **ptr);
 
@@ -0,0 +1,299 @@
+/*
+ * Copyright (c) The acados authors.
+ *
+ * This file is part of acados.
+ *
+ * The 2-Clause BSD License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.;
+ */
+
+
+#include "acados/utils/profiler.h"
+
+#include <assert.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "acados/utils/mem.h"
+
+
+
+acados_size_t acados_profiler_calculate_size(int capacity)
+{
+    acados_size_t size = 0;
+
+    size += sizeof(acados_profiler);
+    size += capacity * sizeof(acados_profiler_event);
+
+    size += 8; // align
+
+    make_int_multiple_of(8, &size);
+
+    return size;
+}
+
+
+
+acados_profiler *acados_profiler_assign(int capacity, void *raw_memory)
+{
+    char *c_ptr = (char *) raw_memory;
+
+    acados_profiler *prof = (acados_profiler *) c_ptr;
+    c_ptr += sizeof(acados_profiler);
+
+    align_char_to(8, &c_ptr);
+
+    prof->events = (acados_profiler_event *) c_ptr;
+    c_ptr += capacity * sizeof(acados_profiler_event);
+
+    prof->capacity = capacity;
+
+    acados_profiler_reset(prof);
+
+    assert((char *) raw_memory + acados_profiler_calculate_size(capacity) >= c_ptr);
+
+    return prof;
+}
+
+
+
+void acados_profiler_reset(acados_profiler *prof)
+{
+    prof->num_recorded = 0;
+    prof->solve = 0;
+    acados_tic(&prof->timer);
+}
+
+
+
+double acados_profiler_time(acados_profiler *prof)
+{
+    // acados_toc writes to the timer, use a copy to be thread safe
+    acados_timer timer = prof->timer;
+    return acados_toc(&timer);
+}
+
+
+
+void acados_profiler_record(acados_profiler *prof, int category, int stage, int iter, double t_start, double t_end)
+{
+    long idx;
+
+    if (prof->capacity <= 0)
+        return;
+
+#if defined(ACADOS_WITH_OPENMP)
+    #pragma omp atomic capture
+#endif
+    idx = prof->num_recorded++;
+
+    acados_profiler_event *event = prof->events + idx % prof->capacity;
+    event->t_start = t_start;
+    event->t_end = t_end;
+    event->category = category;
+    event->stage = stage;
+    event->iter = iter;
+    event->solve = prof->solve;
+}
+
+
+
+int acados_profiler_num_events(acados_profiler *prof)
+{
+    return prof->num_recorded < prof->capacity ? (int) prof->num_recorded : prof->capacity;
+}
+
+
+
+void acados_profiler_get_event(acados_profiler *prof, int i, acados_profiler_event *event)
+{
+    long first = prof->num_recorded - acados_profiler_num_events(prof);
+    *event = prof->events[(first + i) % prof->capacity];
+}
+
+
+
+void acados_profiler_span_start(acados_profiler *prof, acados_profiler_span *span)
+{
+    acados_tic(&span->timer);
+    span->t_start = prof ? acados_profiler_time(prof) : 0.0;
+}
+
+
+
+double acados_profiler_span_elapsed(acados_profiler_span *span)
+{
+    acados_timer timer = span->timer;
+    return acados_toc(&timer);
+}
+
+
+
+double acados_profiler_span_end(acados_profiler *prof, acados_profiler_span *span, int category, int stage, int iter)
+{
+    double duration = acados_toc(&span->timer);
+    if (prof)
+        acados_profiler_record(prof, category, stage, iter, span->t_start, span->t_start + duration);
+    return duration;
+}
+
+
+
+double acados_profiler_span_lap(acados_profiler *prof, acados_profiler_span *span, int category, int stage, int iter)
+{
+    double duration = acados_lap(&span->timer);
+    if (prof)
+        acados_profiler_record(prof, category, stage, iter, span->t_start, span->t_start + duration);
+    span->t_start += duration;
+    return duration;
+}
+
+
+
+const char *acados_profiler_category_name(int category)
+{
+    switch (category)
+    {
+        case ACADOS_PROFILER_SOLVE:
+            return "solve";
+        case ACADOS_PROFILER_ITER:
+            return "iteration";
+        case ACADOS_PROFILER_DYNAMICS:
+            return "dynamics";
+        case ACADOS_PROFILER_COST:
+            return "cost";
+        case ACADOS_PROFILER_CONSTRAINTS:
+            return "constraints";
+        case ACADOS_PROFILER_REG:
+            return "regularization";
+        case ACADOS_PROFILER_QP:
+            return "qp";
+        case ACADOS_PROFILER_GLOB:
+            return "globalization";
+        case ACADOS_PROFILER_LIN:
+            return "linearization";
+        case ACADOS_PROFILER_PREPARATION:
+            return "preparation";
+        case ACADOS_PROFILER_FEEDBACK:
+            return "feedback";
+        case ACADOS_PROFILER_QPSCALING:
+            return "qp_scaling";
+        case ACADOS_PROFILER_SENS:
+            return "solution_sensitivities";
+        case ACADOS_PROFILER_EXT_FUN:
+            return "ext_function";
+        default:
+            return "unknown";
+    }
+}
+
+
+
+int acados_profiler_write_chrome_trace(acados_profiler *prof, const char *filename)
+{
+    FILE *file = fopen(filename, "w");
+    if (file == NULL)
+    {
+        printf("\nacados_profiler_write_chrome_trace: could not open file %s\n", filename);
+        return ACADOS_UNKNOWN;
+    }
+
+    acados_profiler_event event;
+    int num_events = acados_profiler_num_events(prof);
+
+    fprintf(file, "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n");
+    for (int i = 0; i < num_events; i++)
+    {
+        acados_profiler_get_event(prof, i, &event);
+        // stage-wise events get a track per stage
+        fprintf(file, "{\"name\": \"%s\", \"cat\": \"acados\", \"ph\": \"X\", \"pid\": 0, \"tid\": %d, "
+                "\"ts\": %.3f, \"dur\": %.3f, \"args\": {\"stage\": %d, \"iter\": %d, \"solve\": %d}}%s\n",
+                acados_profiler_category_name(event.category), event.stage + 1,
+                1e6 * event.t_start, 1e6 * (event.t_end - event.t_start),
+                event.stage, event.iter, event.solve, i < num_events - 1 ? "," : "");
+    }
+    fprintf(file, "]}\n");
+
+    fclose(file);
+
+    return ACADOS_SUCCESS;
+}
+
+
+
+static void write_int32_le(FILE *file, int32_t value)
+{
+    uint32_t u = (uint32_t) value;
+    unsigned char bytes[4];
+    for (int i = 0; i < 4; i++)
+        bytes[i] = (unsigned char) (u >> (8*i));
+    fwrite(bytes, 1, 4, file);
+}
+
+
+
+static void write_float64_le(FILE *file, double value)
+{
+    uint64_t u;
+    unsigned char bytes[8];
+    memcpy(&u, &value, 8);
+    for (int i = 0; i < 8; i++)
+        bytes[i] = (unsigned char) (u >> (8*i));
+    fwrite(bytes, 1, 8, file);
+}
+
+
+
+int acados_profiler_write_binary(acados_profiler *prof, const char *filename)
+{
+    FILE *file = fopen(filename, "wb");
+    if (file == NULL)
+    {
+        printf("\nacados_profiler_write_binary: could not open file %s\n", filename);
+        return ACADOS_UNKNOWN;
+    }
+
+    acados_profiler_event event;
+    int num_events = acados_profiler_num_events(prof);
+
+    // fields are written one by one, such that the file does not depend on struct padding or endianness
+    fwrite("ACPROF", 1, 6, file);
+    write_int32_le(file, 2);  // version
+    write_int32_le(file, num_events);
+    for (int i = 0; i < num_events; i++)
+    {
+        acados_profiler_get_event(prof, i, &event);
+        write_float64_le(file, event.t_start);
+        write_float64_le(file, event.t_end);
+        write_int32_le(file, event.category);
+        write_int32_le(file, event.stage);
+        write_int32_le(file, event.iter);
+        write_int32_le(file, event.solve);
+    }
+
+    fclose(file);
+
+    return ACADOS_SUCCESS;
+}
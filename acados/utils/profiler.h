@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) The acados authors.
+ *
+ * This file is part of acados.
+ *
+ * The 2-Clause BSD License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.;
+ */
+
+
+#ifndef ACADOS_UTILS_PROFILER_H_
+#define ACADOS_UTILS_PROFILER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#include "acados/utils/timing.h"
+#include "acados/utils/types.h"
+
+
+
+typedef enum
+{
+    ACADOS_PROFILER_SOLVE,
+    ACADOS_PROFILER_ITER,
+    ACADOS_PROFILER_DYNAMICS,
+    ACADOS_PROFILER_COST,
+    ACADOS_PROFILER_CONSTRAINTS,
+    ACADOS_PROFILER_REG,
+    ACADOS_PROFILER_QP,
+    ACADOS_PROFILER_GLOB,
+    ACADOS_PROFILER_LIN,
+    ACADOS_PROFILER_PREPARATION,
+    ACADOS_PROFILER_FEEDBACK,
+    ACADOS_PROFILER_QPSCALING,
+    ACADOS_PROFILER_SENS,
+    ACADOS_PROFILER_EXT_FUN,  // external function evaluations within an integrator, aggregated per dynamics event
+    ACADOS_PROFILER_NUM_CATEGORIES,
+} acados_profiler_category;
+
+
+
+typedef struct
+{
+    double t_start;  // [s] since creation of the profiler
+    double t_end;    // [s] since creation of the profiler
+    int category;    // acados_profiler_category
+    int stage;       // -1 if not stage-wise
+    int iter;
+    int solve;
+} acados_profiler_event;
+
+
+
+/** Ring buffer of timed events, which is kept across solver calls. */
+typedef struct
+{
+    acados_profiler_event *events;
+    acados_timer timer;  // reference time
+    long num_recorded;   // number of events recorded since the last reset, the last capacity ones are kept
+    int capacity;
+    int solve;           // solver call counter
+} acados_profiler;
+
+
+
+/** Timed phase of a solver, its duration feeds the aggregate timings and, if profiling is enabled, the ring buffer. */
+typedef struct
+{
+    acados_timer timer;
+    double t_start;      // [s] since creation of the profiler, only set if profiling is enabled
+} acados_profiler_span;
+
+
+
+//
+acados_size_t acados_profiler_calculate_size(int capacity);
+//
+acados_profiler *acados_profiler_assign(int capacity, void *raw_memory);
+//
+void acados_profiler_reset(acados_profiler *prof);
+/** Returns the time in seconds since creation of the profiler. */
+double acados_profiler_time(acados_profiler *prof);
+/** Stores an event in the ring buffer, overwriting the oldest one if full; thread safe with OpenMP. */
+void acados_profiler_record(acados_profiler *prof, int category, int stage, int iter, double t_start, double t_end);
+/** Number of events currently kept in the ring buffer. */
+int acados_profiler_num_events(acados_profiler *prof);
+/** Copies the i-th oldest event kept in the ring buffer. */
+void acados_profiler_get_event(acados_profiler *prof, int i, acados_profiler_event *event);
+/** Starts a span; prof may be NULL, then only the duration is measured. */
+void acados_profiler_span_start(acados_profiler *prof, acados_profiler_span *span);
+/** Returns the time in seconds since the start of the span without ending it. */
+double acados_profiler_span_elapsed(acados_profiler_span *span);
+/** Ends a span, records it as an event if prof is not NULL and returns its duration in seconds. */
+double acados_profiler_span_end(acados_profiler *prof, acados_profiler_span *span, int category, int stage, int iter);
+/** Ends a span like acados_profiler_span_end and restarts it at the same time stamp. */
+double acados_profiler_span_lap(acados_profiler *prof, acados_profiler_span *span, int category, int stage, int iter);
+//
+const char *acados_profiler_category_name(int category);
+/** Writes the events in the Chrome trace event format, which can be opened in Perfetto. */
+int acados_profiler_write_chrome_trace(acados_profiler *prof, const char *filename);
+/** Writes the events as "ACPROF", int32 version, int32 number of events, followed by the events as
+ *  float64 t_start, float64 t_end, int32 category, int32 stage, int32 iter, int32 solve;
+ *  all numbers are little endian, independent of the platform. */
+int acados_profiler_write_binary(acados_profiler *prof, const char *filename);
+
+
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif  // ACADOS_UTILS_PROFILER_H_
@@ -29,8 +29,21 @@
  */
 
 
+// clock_gettime and nanosleep are not declared in strict C99 mode
+#if !(defined _WIN32 || defined _WIN64 || defined __APPLE__) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 199309L
+#endif
+
 #include "acados/utils/timing.h"
 
+#if !(defined _WIN32 || defined _WIN64 || defined __APPLE__ || defined __MABX2__ || defined _DS1104)
+#include <time.h>
+#if defined(ACADOS_TIMER_TSC) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define ACADOS_TIMER_USE_TSC
+#endif
+#endif
+
 
 #if (defined _WIN32 || defined _WIN64)
 
@@ -46,6 +59,13 @@ real_t acados_toc(acados_timer* t)
     return ((t->toc.QuadPart - t->tic.QuadPart) / (real_t) t->freq.QuadPart);
 }
 
+real_t acados_lap(acados_timer* t)
+{
+    real_t elapsed = acados_toc(t);
+    t->tic = t->toc;
+    return elapsed;
+}
+
 #elif defined(__APPLE__)
 void acados_tic(acados_timer* t)
 {
@@ -67,6 +87,13 @@ real_t acados_toc(acados_timer* t)
 
     return (real_t) duration / 1e9;
 }
+
+real_t acados_lap(acados_timer* t)
+{
+    real_t elapsed = acados_toc(t);
+    t->tic = t->toc;
+    return elapsed;
+}
 #elif defined(_DS1104)
 
 void acados_tic(acados_timer* t)
@@ -77,6 +104,14 @@ void acados_tic(acados_timer* t)
 
 real_t acados_toc(acados_timer* t) { return ds1104_tic_read() - t->time; }
 
+real_t acados_lap(acados_timer* t)
+{
+    double now = ds1104_tic_read();
+    real_t elapsed = now - t->time;
+    t->time = now;
+    return elapsed;
+}
+
 #elif defined(__MABX2__)
 
 void acados_tic(acados_timer* t)
@@ -87,58 +122,108 @@ void acados_tic(acados_timer* t)
 
 real_t acados_toc(acados_timer* t) { return ds1401_tic_read() - t->time; }
 
+real_t acados_lap(acados_timer* t)
+{
+    double now = ds1401_tic_read();
+    real_t elapsed = now - t->time;
+    t->time = now;
+    return elapsed;
+}
+
 #else
 
-#if (__STDC_VERSION__ >= 199901L) && !(defined __MINGW32__ || defined __MINGW64__) // C99 Mode
+#if defined(ACADOS_TIMER_USE_TSC)
 
-/* read current time */
-void acados_tic(acados_timer* t) { gettimeofday(&t->tic, 0); }
-/* return time passed since last call to tic on this timer */
-real_t acados_toc(acados_timer* t)
+static double acados_tsc_ticks_per_sec = 0.0;
+// 0: not calibrated, 1: calibration in progress, 2: acados_tsc_ticks_per_sec is valid
+static int acados_tsc_state = 0;
+
+/* estimate the TSC frequency against the monotonic clock over 10 ms */
+static double acados_tsc_calibrate(void)
 {
-    struct timeval temp;
+    struct timespec ts0, ts1, sleep_time = {0, 10000000};
+    clock_gettime(CLOCK_MONOTONIC, &ts0);
+    uint64_t tsc0 = __rdtsc();
+    nanosleep(&sleep_time, NULL);
+    clock_gettime(CLOCK_MONOTONIC, &ts1);
+    uint64_t tsc1 = __rdtsc();
+
+    double elapsed = (double) (ts1.tv_sec - ts0.tv_sec) + (double) (ts1.tv_nsec - ts0.tv_nsec) / 1e9;
+    return (double) (tsc1 - tsc0) / elapsed;
+}
 
-    gettimeofday(&t->toc, 0);
+void acados_timer_calibrate(void)
+{
+    if (__atomic_load_n(&acados_tsc_state, __ATOMIC_ACQUIRE) == 2)
+        return;
 
-    if ((t->toc.tv_usec - t->tic.tv_usec) < 0)
+    int expected = 0;
+    if (__atomic_compare_exchange_n(&acados_tsc_state, &expected, 1, false,
+                                    __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE))
     {
-        temp.tv_sec = t->toc.tv_sec - t->tic.tv_sec - 1;
-        temp.tv_usec = 1000000 + t->toc.tv_usec - t->tic.tv_usec;
+        acados_tsc_ticks_per_sec = acados_tsc_calibrate();
+        __atomic_store_n(&acados_tsc_state, 2, __ATOMIC_RELEASE);
     }
     else
     {
-        temp.tv_sec = t->toc.tv_sec - t->tic.tv_sec;
-        temp.tv_usec = t->toc.tv_usec - t->tic.tv_usec;
+        // another thread is calibrating
+        while (__atomic_load_n(&acados_tsc_state, __ATOMIC_ACQUIRE) != 2)
+            _mm_pause();
     }
+}
 
-    return (real_t) temp.tv_sec + (real_t) temp.tv_usec / 1e6;
+static inline uint64_t acados_timer_now(void) { return __rdtsc(); }
+
+static inline real_t acados_timer_elapsed(uint64_t tic, uint64_t toc)
+{
+    // no-op after the calibration at solver creation, only timers used without a solver calibrate here
+    acados_timer_calibrate();
+    return (real_t) (toc - tic) / acados_tsc_ticks_per_sec;
 }
 
-#else  // ANSI C Mode
+#else
 
-/* read current time */
-void acados_tic(acados_timer* t) { clock_gettime(CLOCK_MONOTONIC, &t->tic); }
-/* return time passed since last call to tic on this timer */
-real_t acados_toc(acados_timer* t)
+static inline uint64_t acados_timer_now(void)
 {
-    struct timespec temp;
+    struct timespec ts;
+#if defined(CLOCK_MONOTONIC_RAW)
+    clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+#else
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+#endif
+    return (uint64_t) ts.tv_sec * 1000000000ull + (uint64_t) ts.tv_nsec;
+}
 
-    clock_gettime(CLOCK_MONOTONIC, &t->toc);
+static inline real_t acados_timer_elapsed(uint64_t tic, uint64_t toc)
+{
+    return (real_t) (toc - tic) / 1e9;
+}
 
-    if ((t->toc.tv_nsec - t->tic.tv_nsec) < 0)
-    {
-        temp.tv_sec = t->toc.tv_sec - t->tic.tv_sec - 1;
-        temp.tv_nsec = 1000000000 + t->toc.tv_nsec - t->tic.tv_nsec;
-    }
-    else
-    {
-        temp.tv_sec = t->toc.tv_sec - t->tic.tv_sec;
-        temp.tv_nsec = t->toc.tv_nsec - t->tic.tv_nsec;
-    }
+#endif  // ACADOS_TIMER_TSC
 
-    return (real_t) temp.tv_sec + (real_t) temp.tv_nsec / 1e9;
+/* read current time */
+void acados_tic(acados_timer* t)
+{
+    t->tic = acados_timer_now();
 }
 
-#endif  // __STDC_VERSION__ >= 199901L
+/* return time passed since last call to tic on this timer */
+real_t acados_toc(acados_timer* t)
+{
+    t->toc = acados_timer_now();
+    return acados_timer_elapsed(t->tic, t->toc);
+}
+
+real_t acados_lap(acados_timer* t)
+{
+    t->toc = acados_timer_now();
+    real_t elapsed = acados_timer_elapsed(t->tic, t->toc);
+    t->tic = t->toc;
+    return elapsed;
+}
 
 #endif  // (defined _WIN32 || _WIN64)
+
+#if !defined(ACADOS_TIMER_USE_TSC)
+void acados_timer_calibrate(void) {}
+#endif
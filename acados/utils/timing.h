@@ -83,39 +83,33 @@ typedef struct acados_timer_
 
 #else
 
-/* Use POSIX clock_gettime() for timing on non-Windows machines. */
-#include <time.h>
-
-#if (__STDC_VERSION__ >= 199901L) && !(defined __MINGW32__ || defined __MINGW64__)  // C99 Mode
-
-#include <sys/stat.h>
-#include <sys/time.h>
+/* Use POSIX clock_gettime(CLOCK_MONOTONIC_RAW) for timing on non-Windows machines,
+ * or the time stamp counter on x86 if ACADOS_TIMER_TSC is defined. */
+#include <stdint.h>
 
+/** A structure for keeping internal timer data, in nanoseconds or TSC ticks. */
 typedef struct acados_timer_
 {
-    struct timeval tic;
-    struct timeval toc;
-} acados_timer;
-
-#else  // ANSI C Mode
-
-/** A structure for keeping internal timer data. */
-typedef struct acados_timer_
-{
-    struct timespec tic;
-    struct timespec toc;
+    uint64_t tic;
+    uint64_t toc;
 } acados_timer;
 
-#endif  // __STDC_VERSION__ >= 199901L
-
 #endif  // (defined _WIN32 || defined _WIN64)
 
+/** Calibrates the time stamp counter if ACADOS_TIMER_TSC is defined, otherwise a no-op.
+ *  Called once at solver creation, so that the first acados_tic does not pay for it; thread-safe. */
+void acados_timer_calibrate(void);
+
 /** A function for measurement of the current time. */
 void acados_tic(acados_timer* t);
 
 /** A function which returns the elapsed time. */
 real_t acados_toc(acados_timer* t);
 
+/** Returns the time elapsed since the last call to acados_tic or acados_lap
+ *  and restarts the timer at the same time stamp, i.e. with a single clock read. */
+real_t acados_lap(acados_timer* t);
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
@@ -125,6 +125,13 @@ enum search_direction_mode
     FEASIBILITY_QP = 2,
 };
 
+// Policies of closing the defects between the shooting segments of the DDP forward rollout
+enum ddp_defect_closing
+{
+    DDP_DEFECT_CLOSING_GRADUAL = 0,  // segments are kept, defects are closed at the rate of the step length
+    DDP_DEFECT_CLOSING_MERGE = 1,  // segments are merged to a single shooting rollout once the iterate is feasible
+};
+
 
 /// QP scaling types
 typedef enum
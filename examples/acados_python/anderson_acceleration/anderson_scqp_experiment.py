@@ -45,11 +45,12 @@ class ExperimentAcadosSettings:
     with_anderson_acceleration: bool
     globalization: str = "FIXED_STEP"
     max_iter: int = 200
+    anderson_depth: int = 1
 
     def get_label(self):
         label = self.method
         if self.with_anderson_acceleration:
-            label = 'AA(1)-' + label
+            label = f'AA({self.anderson_depth})-' + label
         if self.globalization != "FIXED_STEP":
             label = label + '-' + self.globalization
         return label
@@ -66,6 +67,7 @@ def solve_with_acados(settings: ExperimentAcadosSettings,
                                 with_anderson_acceleration=settings.with_anderson_acceleration,
                                 globalization=settings.globalization,
                                 max_iter=settings.max_iter,
+                                anderson_depth=settings.anderson_depth,
                                 )
     acados_solver = AcadosOcpSolver(ocp, verbose=False)
     if initial_guess is not None:
@@ -165,6 +167,7 @@ def main(plot_sol=False):
         ExperimentAcadosSettings(method='GN', with_anderson_acceleration=False, max_iter=60),
         ExperimentAcadosSettings(method='SCQP', with_anderson_acceleration=False, max_iter=60),
         ExperimentAcadosSettings(method='SCQP', with_anderson_acceleration=True),
+        ExperimentAcadosSettings(method='SCQP', with_anderson_acceleration=True, anderson_depth=3),
         # ExperimentAcadosSettings(method='GN', with_anderson_acceleration=True),
     ]
     # Evaluation
@@ -176,9 +179,10 @@ def main(plot_sol=False):
     plot_convergence([r.kkt_norms for r in results], labels)
 
     # asserts to check behavior
-    res_anderson = results[-1]
+    res_anderson_depth = results[-1]
+    res_anderson = results[-2]
     res_exact = results[0]
-    res_scqp = results[-2]
+    res_scqp = results[-3]
 
     def assert_convergence_iterations(res, min_iter: int, max_iter: int, method: str):
         n_iter = len(res.kkt_norms)
@@ -203,6 +207,8 @@ def main(plot_sol=False):
     assert_convergence_iterations(res_anderson, 8, 12, "Anderson")
     assert_convergence_iterations(res_exact, 4, 6, "Exact")
     assert_convergence_iterations(res_scqp, 25, 40, "SCQP")
+    # more history should not slow down convergence
+    assert_convergence_iterations(res_anderson_depth, 1, len(res_anderson.kkt_norms), "Anderson with depth 3")
 
 if __name__ == "__main__":
     main()
@@ -73,7 +73,7 @@ def pendulum_final_position_constraint(p, theta):
     pendulum_final_position = pendulum_position(p, theta)
     return ca.sumsqr(pendulum_final_position - ca.vertcat(LENGTH_PENDULUM, LENGTH_PENDULUM)) - GOAL_POSITION_RADIUS
 
-def build_acados_test_problem(mode='GN', with_anderson_acceleration=False, globalization="FIXED_STEP", max_iter=400) -> AcadosOcp:
+def build_acados_test_problem(mode='GN', with_anderson_acceleration=False, globalization="FIXED_STEP", max_iter=400, anderson_depth=1) -> AcadosOcp:
     print(f"Building acados test problem with mode {mode} and with_anderson_acceleration {with_anderson_acceleration}, {globalization}")
 
     # create ocp object to formulate the OCP
@@ -134,6 +134,7 @@ def build_acados_test_problem(mode='GN', with_anderson_acceleration=False, globa
     ocp.solver_options.qp_tol = 1e-1 * ocp.solver_options.tol
     # ocp.solver_options.cost_scaling = np.ones((N_horizon+1, ))
     ocp.solver_options.with_anderson_acceleration = with_anderson_acceleration
+    ocp.solver_options.anderson_depth = anderson_depth
     ocp.solver_options.globalization = globalization
     ocp.solver_options.qp_solver_ric_alg = 0
     ocp.solver_options.qp_solver_cond_ric_alg = 0
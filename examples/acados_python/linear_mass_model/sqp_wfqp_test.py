@@ -101,7 +101,9 @@ def feasible_qp_index_test(soften_obstacle, soften_terminal, soften_controls, N,
             # We slack the obstacle constraint and the terminal constraints
             assert np.allclose(idxs, np.arange(dims.nh_e + dims.nbx_e)), f"i=N+1: Everything should be slacked"
 
-def create_solver_opts(N=4, Tf=2, nlp_solver_type = 'SQP_WITH_FEASIBLE_QP', allow_switching_modes=True):
+def create_solver_opts(N=4, Tf=2, nlp_solver_type = 'SQP_WITH_FEASIBLE_QP', allow_switching_modes=True,
+                       minimal_memory=False, use_constraint_hessian_in_feas_qp=False,
+                       warm_start_nominal_qp=False):
 
     solver_options = AcadosOcpOptions()
 
@@ -121,7 +123,9 @@ def create_solver_opts(N=4, Tf=2, nlp_solver_type = 'SQP_WITH_FEASIBLE_QP', allo
     solver_options.globalization_full_step_dual = True
     solver_options.print_level = 1
     solver_options.nlp_solver_max_iter = 20
-    solver_options.use_constraint_hessian_in_feas_qp = False
+    solver_options.use_constraint_hessian_in_feas_qp = use_constraint_hessian_in_feas_qp
+    solver_options.minimal_memory = minimal_memory
+    solver_options.warm_start_nominal_qp_from_feasibility_qp = warm_start_nominal_qp
 
     if not allow_switching_modes:
         solver_options.search_direction_mode = 'BYRD_OMOJOKUN'
@@ -134,7 +138,8 @@ def create_solver_opts(N=4, Tf=2, nlp_solver_type = 'SQP_WITH_FEASIBLE_QP', allo
 
 def create_solver(solver_name: str, soften_obstacle: bool, soften_terminal: bool,
                   soften_controls: bool, nlp_solver_type: str = 'SQP_WITH_FEASIBLE_QP',
-                  allow_switching_modes: bool = True):
+                  allow_switching_modes: bool = True, minimal_memory: bool = False,
+                  use_constraint_hessian_in_feas_qp: bool = False, warm_start_nominal_qp: bool = False):
 
     # create ocp object to formulate the OCP
     ocp = AcadosOcp()
@@ -235,7 +240,8 @@ def create_solver(solver_name: str, soften_obstacle: bool, soften_terminal: bool
         ocp.cost.Zu_e = np.concatenate((ocp.cost.Zu_e, Zh))
 
     # load options
-    ocp.solver_options = create_solver_opts(N, Tf, nlp_solver_type, allow_switching_modes)
+    ocp.solver_options = create_solver_opts(N, Tf, nlp_solver_type, allow_switching_modes,
+                                            minimal_memory, use_constraint_hessian_in_feas_qp, warm_start_nominal_qp)
 
     # create ocp solver
     ocp_solver = AcadosOcpSolver(ocp, json_file=f'{model.name}_{solver_name}_ocp.json', verbose=False)
@@ -336,6 +342,56 @@ def sqp_wfqp_test_same_matrices():
     print(f"\n\n----------------------\n")
 
 
+def test_minimal_memory():
+    soften_controls = True
+    soften_obstacle = False
+    soften_terminal = True
+
+    for use_constraint_hessian_in_feas_qp in [False, True]:
+        _, ocp_solver1 = create_solver("full_mem", soften_obstacle, soften_terminal, soften_controls,
+                                       use_constraint_hessian_in_feas_qp=use_constraint_hessian_in_feas_qp)
+        status1 = ocp_solver1.solve()
+
+        _, ocp_solver2 = create_solver("min_mem", soften_obstacle, soften_terminal, soften_controls, minimal_memory=True,
+                                       use_constraint_hessian_in_feas_qp=use_constraint_hessian_in_feas_qp)
+        status2 = ocp_solver2.solve()
+
+        assert status1 == status2, "minimal_memory should not change the solver status"
+        assert ocp_solver1.get_stats('sqp_iter') == ocp_solver2.get_stats('sqp_iter'), "minimal_memory should not change the iterations"
+        if not ocp_solver1.get_flat_iterate().allclose(ocp_solver2.get_flat_iterate()):
+            raise ValueError("Solutions with and without minimal_memory differ!")
+
+        footprint1 = ocp_solver1.get_memory_footprint()['total']
+        footprint2 = ocp_solver2.get_memory_footprint()['total']
+        print(f"memory footprint: {footprint1} bytes, with minimal_memory: {footprint2} bytes")
+        assert footprint2 < footprint1, "minimal_memory should reduce the memory footprint"
+
+    print(f"\n\n----------------------\n")
+
+
+def test_warm_start_nominal_qp():
+    settings = [(True, False, True), (False, False, False)]
+    for k, (soften_controls, soften_obstacle, soften_terminal) in enumerate(settings):
+        nominal_qp_iter = []
+        solutions = []
+        statuses = []
+        for warm_start in [False, True]:
+            _, ocp_solver = create_solver(f"ws_{k}_{int(warm_start)}", soften_obstacle, soften_terminal, soften_controls,
+                                          allow_switching_modes=False, warm_start_nominal_qp=warm_start)
+            statuses.append(ocp_solver.solve())
+            # row 10 of the statistics: QP iterations of the nominal QP in Byrd-Omojokun mode
+            nominal_qp_iter.append(int(np.sum(ocp_solver.get_stats('statistics')[10, :])))
+            solutions.append(ocp_solver.get_flat_iterate())
+
+        print(f"nominal QP iterations without warm start: {nominal_qp_iter[0]}, with warm start: {nominal_qp_iter[1]}")
+        assert statuses[0] == statuses[1], "warm starting the nominal QP should not change the solver status"
+        if not solutions[0].allclose(solutions[1]):
+            raise ValueError("Solutions with and without warm starting the nominal QP differ!")
+        assert nominal_qp_iter[1] <= nominal_qp_iter[0], "warm starting the nominal QP should not increase its QP iterations"
+
+    print(f"\n\n----------------------\n")
+
+
 def main_test():
     # SETTINGS:
     soften_controls = True
@@ -357,3 +413,5 @@ if __name__ == '__main__':
     main_test()
     test_same_behavior_sqp_and_sqp_wfqp()
     sqp_wfqp_test_same_matrices()
+    test_minimal_memory()
+    test_warm_start_nominal_qp()
@@ -0,0 +1,174 @@
+#
+# Copyright (c) The acados authors.
+#
+# This file is part of acados.
+#
+# The 2-Clause BSD License
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice,
+# this list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright notice,
+# this list of conditions and the following disclaimer in the documentation
+# and/or other materials provided with the distribution.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.;
+#
+
+# Linear general constraints (C, D) have constant QP rows within a solve, so QP scaling caches
+# their row norms and keeps scaled rows whose factor did not change.
+# The same constraint formulated as nonlinear constraint h is never cached.
+# Both formulations result in identical scaled QPs and therefore identical iterates.
+
+from acados_template import AcadosOcp, AcadosOcpSolver, ACADOS_INFTY
+import numpy as np
+import scipy.linalg
+from casadi import vertcat
+from linear_mass_model import export_linear_mass_model
+from test_qpscaling_slacked import create_solver_opts, check_iteration_residual, check_solutions
+
+# linear constraint lg <= C x + D u <= ug
+C_LIN = np.array([[3.0, 0.0, 1.0, 0.0]])
+D_LIN = np.array([[2.0, 0.0]])
+LG_LIN = np.array([-10.0])
+UG_LIN = np.array([4.0])
+
+
+def create_solver(solver_name: str, linear_as_h: bool, nlp_solver_type: str, globalization: str):
+    ocp = AcadosOcp()
+
+    model = export_linear_mass_model()
+    ocp.model = model
+    ocp.model.name += solver_name
+
+    nx = model.x.rows()
+    nu = model.u.rows()
+    N = 4
+    Tf = 2
+
+    # cost
+    ocp.cost.cost_type = 'LINEAR_LS'
+    ocp.cost.cost_type_e = 'LINEAR_LS'
+    ocp.cost.W = 2*np.diag([1e1, 1e1])
+    ocp.cost.W_e = np.zeros((0, 0))
+    ocp.cost.Vx = np.zeros((nu, nx))
+    ocp.cost.Vu = np.eye(nu)
+    ocp.cost.yref = np.zeros((nu, ))
+
+    # bounds
+    Fmax = 2
+    ocp.constraints.lbu = -Fmax * np.ones((nu,))
+    ocp.constraints.ubu = +Fmax * np.ones((nu,))
+    ocp.constraints.idxbu = np.array(range(nu))
+    ocp.constraints.idxsbu = np.array(range(nu))
+
+    x0 = np.array([1e-1, 1.1, 0, 0])
+    ocp.constraints.x0 = x0
+
+    x_goal = np.array([0, -1.1, 0, 0])
+    ocp.constraints.idxbx_e = np.array(range(nx))
+    ocp.constraints.lbx_e = x_goal
+    ocp.constraints.ubx_e = x_goal
+    ocp.constraints.idxsbx_e = np.array(range(nx))
+
+    # obstacle
+    obs_rad = 1.0
+    obstacle = -(model.x[0] ** 2 + model.x[1] ** 2)
+    linear = C_LIN @ model.x + D_LIN @ model.u
+
+    if linear_as_h:
+        ocp.model.con_h_expr_0 = linear
+        ocp.constraints.lh_0 = LG_LIN
+        ocp.constraints.uh_0 = UG_LIN
+        ocp.model.con_h_expr = vertcat(linear, obstacle)
+        ocp.constraints.lh = np.concatenate((LG_LIN, -np.array([ACADOS_INFTY])))
+        ocp.constraints.uh = np.concatenate((UG_LIN, -np.array([obs_rad**2])))
+        ocp.constraints.idxsh = np.array([1])
+    else:
+        ocp.constraints.C = C_LIN
+        ocp.constraints.D = D_LIN
+        ocp.constraints.lg = LG_LIN
+        ocp.constraints.ug = UG_LIN
+        ocp.model.con_h_expr = obstacle
+        ocp.constraints.lh = -np.array([ACADOS_INFTY])
+        ocp.constraints.uh = -np.array([obs_rad**2])
+        ocp.constraints.idxsh = np.array([0])
+
+    ocp.model.con_h_expr_e = obstacle
+    ocp.constraints.lh_e = -np.array([ACADOS_INFTY])
+    ocp.constraints.uh_e = -np.array([obs_rad**2])
+    ocp.constraints.idxsh_e = np.array([0])
+
+    # slack penalties
+    ocp.cost.zl_0 = 1e1 * np.ones(nu)
+    ocp.cost.zu_0 = 1e1 * np.ones(nu)
+    ocp.cost.Zl_0 = 1e1 * np.ones(nu)
+    ocp.cost.Zu_0 = 1e1 * np.ones(nu)
+    ocp.cost.zl = np.concatenate((1e1 * np.ones(nu), 1e4 * np.ones(1)))
+    ocp.cost.zu = np.concatenate((1e1 * np.ones(nu), 1e4 * np.ones(1)))
+    ocp.cost.Zl = np.concatenate((1e1 * np.ones(nu), 1e6 * np.ones(1)))
+    ocp.cost.Zu = np.concatenate((1e1 * np.ones(nu), 1e6 * np.ones(1)))
+    ocp.cost.zl_e = np.concatenate((42e3 * np.ones(nx), 1e4 * np.ones(1)))
+    ocp.cost.zu_e = np.concatenate((42e3 * np.ones(nx), 1e4 * np.ones(1)))
+    ocp.cost.Zl_e = np.concatenate((np.zeros(nx), 1e6 * np.ones(1)))
+    ocp.cost.Zu_e = np.concatenate((np.zeros(nx), 1e6 * np.ones(1)))
+
+    ocp.solver_options = create_solver_opts(N, Tf, nlp_solver_type, False, globalization)
+    ocp.solver_options.qpscaling_scale_constraints = "INF_NORM"
+    ocp.solver_options.qpscaling_scale_objective = "OBJECTIVE_GERSHGORIN"
+
+    ocp_solver = AcadosOcpSolver(ocp, json_file=f'{model.name}_ocp.json', verbose=False)
+
+    return ocp_solver, x0, x_goal
+
+
+def solve(ocp_solver: AcadosOcpSolver, x0, x_goal, shift: float):
+    N = ocp_solver.N
+    for i in range(N+1):
+        ocp_solver.set(i, "x", (N+1-i)/(N+1) * x0 + i/(N+1) * x_goal + shift)
+        ocp_solver.set(i, "lam", np.zeros(ocp_solver.get(i, "lam").shape))
+    status = ocp_solver.solve()
+    if status != 0:
+        raise RuntimeError(f"acados returned status {status}.")
+    stats = ocp_solver.get_stats("statistics")
+    scaling = [ocp_solver.get_qp_scaling_constraints(i) for i in range(N+1)]
+    return ocp_solver.get_flat_iterate(), stats, scaling
+
+
+def test_qpscaling_constr_cache(nlp_solver_type: str, globalization: str):
+    print(f"\n\nTesting cached QP constraint scaling with solver={nlp_solver_type}, globalization={globalization}")
+    solver_g, x0, x_goal = create_solver("_cached", False, nlp_solver_type, globalization)
+    solver_h, _, _ = create_solver("_uncached", True, nlp_solver_type, globalization)
+
+    # second solve from a different initial guess checks that the cache is invalidated between solves
+    for shift in [0.0, 0.3]:
+        sol_g, stats_g, scaling_g = solve(solver_g, x0, x_goal, shift)
+        sol_h, stats_h, scaling_h = solve(solver_h, x0, x_goal, shift)
+
+        check_iteration_residual([stats_h, stats_g])
+        check_solutions([sol_h, sol_g])
+
+        for i, (s_g, s_h) in enumerate(zip(scaling_g, scaling_h)):
+            if not np.allclose(s_g, s_h, rtol=1e-12, atol=0.0):
+                raise ValueError(f"QP constraint scaling differs at stage {i}: {s_g} vs {s_h}")
+
+    print("Cached and uncached QP constraint scaling coincide.")
+
+
+if __name__ == '__main__':
+    test_qpscaling_constr_cache('SQP', 'MERIT_BACKTRACKING')
+    test_qpscaling_constr_cache('SQP_WITH_FEASIBLE_QP', 'FUNNEL_L1PEN_LINESEARCH')
+    test_qpscaling_constr_cache('SQP_WITH_FEASIBLE_QP', 'MERIT_BACKTRACKING')
@@ -75,8 +75,59 @@ def main(regularize_method):
             break
     ocp_solver = None
 
+def convexify_split_regression():
+    # CONVEXIFY modifies the Hessian in regularize_lhs and the gradient in regularize_rhs.
+    # SQP_RTI calls them in the preparation and feedback phase, SQP calls both within one iteration.
+    # Both have to produce the same iterates, and the iterates have to converge to the
+    # solution obtained with PROJECT, which regularizes the Hessian only.
+    N = 10
+    dt = 0.05
+    Tf = N * dt
+    n_iter = 8
+
+    ocp = formulate_ocp(Tf=Tf, N=N, regularize_method='CONVEXIFY')
+    ocp_solver = AcadosOcpSolver(ocp, verbose=False)
+    rti_iterates = []
+    for i in range(n_iter):
+        ocp_solver.options_set('rti_phase', 1)
+        ocp_solver.solve()
+        ocp_solver.options_set('rti_phase', 2)
+        ocp_solver.solve()
+        rti_iterates.append(np.concatenate([ocp_solver.get_flat('x'), ocp_solver.get_flat('u')]))
+    ocp_solver = None
+
+    ocp = formulate_ocp(Tf=Tf, N=N, regularize_method='CONVEXIFY')
+    ocp.solver_options.nlp_solver_type = 'SQP'
+    ocp.solver_options.nlp_solver_max_iter = n_iter
+    ocp.solver_options.tol = 1e-14
+    ocp.solver_options.store_iterates = True
+    ocp_solver = AcadosOcpSolver(ocp, verbose=False)
+    ocp_solver.solve()
+    n_sqp = ocp_solver.get_stats('nlp_iter')
+    for i in range(1, n_sqp+1):
+        iterate = ocp_solver.get_iterate(i)
+        sqp_iterate = np.concatenate(iterate.x + iterate.u)
+        diff = np.max(np.abs(sqp_iterate - rti_iterates[i-1]))
+        print(f"iteration {i}: max difference RTI split vs. SQP {diff:.2e}")
+        assert diff < 1e-10, f"CONVEXIFY iterates differ between RTI split and SQP in iteration {i}: {diff}"
+    ocp_solver = None
+
+    solutions = {}
+    for regularize_method in ['CONVEXIFY', 'PROJECT']:
+        ocp = formulate_ocp(Tf=Tf, N=N, regularize_method=regularize_method)
+        ocp.solver_options.nlp_solver_type = 'SQP'
+        ocp.solver_options.nlp_solver_max_iter = 100
+        ocp_solver = AcadosOcpSolver(ocp, verbose=False)
+        status = ocp_solver.solve()
+        assert status == 0, f"SQP with {regularize_method} returned status {status}"
+        solutions[regularize_method] = np.concatenate([ocp_solver.get_flat('x'), ocp_solver.get_flat('u')])
+        ocp_solver = None
+    diff = np.max(np.abs(solutions['CONVEXIFY'] - solutions['PROJECT']))
+    assert diff < 1e-5, f"CONVEXIFY and PROJECT converged to different solutions: {diff}"
+
 if __name__ == "__main__":
     main(regularize_method='NO_REGULARIZE')
     main(regularize_method='PROJECT')
     main(regularize_method='MIRROR')
-    main(regularize_method='CONVEXIFY')
\ No newline at end of file
+    main(regularize_method='CONVEXIFY')
+    convexify_split_regression()
\ No newline at end of file
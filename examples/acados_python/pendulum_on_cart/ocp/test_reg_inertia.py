@@ -0,0 +1,115 @@
+#
+# Copyright (c) The acados authors.
+#
+# This file is part of acados.
+#
+# The 2-Clause BSD License
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice,
+# this list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright notice,
+# this list of conditions and the following disclaimer in the documentation
+# and/or other materials provided with the distribution.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.;
+#
+
+import sys
+sys.path.insert(0, '../common')
+import casadi as ca
+import numpy as np
+from acados_template import AcadosOcp, AcadosOcpSolver
+from pendulum_model import export_pendulum_ode_model
+
+
+def formulate_ocp(fixed_x0: bool) -> AcadosOcp:
+    ocp = AcadosOcp()
+
+    model = export_pendulum_ode_model()
+    ocp.model = model
+    x = model.x
+    u = model.u
+
+    # the last term introduces negative curvature in u close to the upright position
+    Q_mat = np.diag([1e2, 1e2, 1e-2, 1e-2])
+    ocp.cost.cost_type = 'EXTERNAL'
+    ocp.model.cost_expr_ext_cost = 0.5 * x.T @ Q_mat @ x + 1e-2 * u**2 - 1e-1 * u**2 * ca.cos(x[1])
+    ocp.cost.cost_type_e = 'EXTERNAL'
+    ocp.model.cost_expr_ext_cost_e = 0.5 * x.T @ Q_mat @ x
+
+    Fmax = 80
+    ocp.constraints.lbu = np.array([-Fmax])
+    ocp.constraints.ubu = np.array([+Fmax])
+    ocp.constraints.idxbu = np.array([0])
+    if fixed_x0:
+        ocp.constraints.x0 = np.array([0.0, 0.2, 0.0, 0.0])
+        ocp.constraints.remove_x0_elimination()
+
+    ocp.solver_options.tf = 0.5
+    ocp.solver_options.N_horizon = 10
+    ocp.solver_options.qp_solver = 'PARTIAL_CONDENSING_HPIPM'
+    ocp.solver_options.hessian_approx = 'EXACT'
+    ocp.solver_options.regularize_method = 'INERTIA_CORRECTION'
+    ocp.solver_options.reg_epsilon = 1e-4
+    ocp.solver_options.integrator_type = 'ERK'
+    ocp.solver_options.nlp_solver_type = 'SQP_RTI'
+    return ocp
+
+
+def check_reduced_hessian(ocp_solver: AcadosOcpSolver, fixed_x0: bool):
+    # backward Riccati recursion on the regularized QP in Python
+    N = ocp_solver.N
+    P = ocp_solver.get_from_qp_in(N, 'Q')
+    for i in range(N-1, -1, -1):
+        A = ocp_solver.get_from_qp_in(i, 'A')
+        B = ocp_solver.get_from_qp_in(i, 'B')
+        Q = ocp_solver.get_from_qp_in(i, 'Q')
+        R = ocp_solver.get_from_qp_in(i, 'R')
+        S = ocp_solver.get_from_qp_in(i, 'S')
+        R_bar = R + B.T @ P @ B
+        S_bar = S + B.T @ P @ A
+        assert np.min(np.linalg.eigvalsh(R_bar)) > 0, f"reduced Hessian at stage {i} is not positive definite"
+        P = Q + A.T @ P @ A - S_bar.T @ np.linalg.solve(R_bar, S_bar)
+        P = 0.5 * (P + P.T)
+    min_eig_P0 = np.min(np.linalg.eigvalsh(P))
+    if not fixed_x0:
+        assert min_eig_P0 > 0, "P_0 is not positive definite with free initial state"
+    return min_eig_P0
+
+
+def main(fixed_x0: bool):
+    ocp = formulate_ocp(fixed_x0)
+    ocp_solver = AcadosOcpSolver(ocp, verbose=False)
+
+    # initialize close to the upright position, where the input Hessian is indefinite
+    for i in range(ocp_solver.N + 1):
+        ocp_solver.set(i, 'x', np.array([0.0, 0.2, 0.0, 0.0]))
+    for i in range(ocp_solver.N):
+        ocp_solver.set(i, 'u', np.array([50.0]))
+
+    for _ in range(10):
+        status = ocp_solver.solve()
+        assert status in [0, 2], f"solver returned status {status}"
+        check_reduced_hessian(ocp_solver, fixed_x0)
+
+    ocp_solver = None
+    print(f"inertia correction test with fixed_x0 = {fixed_x0} passed.")
+
+
+if __name__ == "__main__":
+    main(fixed_x0=True)
+    main(fixed_x0=False)
@@ -146,11 +146,72 @@ def main(regularize_method: str):
     ocp_solver = None
 
 
+def create_stage_varying_solver(regularize_method: str) -> AcadosOcpSolver:
+    # Q = [[1, .5], [.5, p]] is positive definite for p = 2 and indefinite for p = -1
+    ocp = AcadosOcp()
+    model = AcadosModel()
+    model.x = ca.SX.sym('x', 2)
+    model.u = ca.SX.sym('u', 2)
+    model.p = ca.SX.sym('p')
+    model.name = f'stage_varying_{regularize_method.lower()}'
+    model.disc_dyn_expr = model.x + model.u
+    Q = ca.vertcat(ca.horzcat(1.0, .5), ca.horzcat(.5, model.p))
+    model.cost_expr_ext_cost = .5*model.x.T @ Q @ model.x + .5*model.u.T @ model.u
+    model.cost_expr_ext_cost_e = .5*model.x.T @ model.x
+    ocp.model = model
+
+    ocp.solver_options.N_horizon = 4
+    ocp.solver_options.tf = 1.0
+    ocp.cost.cost_type = 'EXTERNAL'
+    ocp.cost.cost_type_e = 'EXTERNAL'
+    ocp.constraints.x0 = np.ones((2,))
+    ocp.parameter_values = np.array([2.0])
+
+    ocp.solver_options.qp_solver = 'PARTIAL_CONDENSING_HPIPM'
+    ocp.solver_options.hessian_approx = 'GAUSS_NEWTON'
+    ocp.solver_options.regularize_method = regularize_method
+    ocp.solver_options.integrator_type = 'DISCRETE'
+    ocp.solver_options.nlp_solver_type = 'SQP'
+    ocp.solver_options.nlp_solver_max_iter = 1
+
+    return AcadosOcpSolver(ocp, json_file=f'{model.name}.json', verbose=False)
+
+
+def hessian_blocks(regularize_method: str, p_values):
+    ocp_solver = create_stage_varying_solver(regularize_method)
+    for i, p in enumerate(p_values):
+        ocp_solver.set(i, 'p', np.array([p]))
+    # the unregularized QP may fail, only the Hessian blocks are compared
+    ocp_solver.solve()
+    return [ocp_solver.get_hessian_block(i) for i in range(ocp_solver.N+1)]
+
+
+def main_skip_pd_stages(regularize_method: str):
+    eps = 1e-4
+    p_values = [2.0, -1.0, 2.0, -1.0, 2.0]
+    hess_ref = hessian_blocks('NO_REGULARIZE', p_values)
+    hess_reg = hessian_blocks(regularize_method, p_values)
+
+    for i, (H_ref, H_reg) in enumerate(zip(hess_ref, hess_reg)):
+        d, V = np.linalg.eigh(H_ref)
+        if np.min(d) > eps:
+            # stages that are already positive definite are skipped and stay bitwise unchanged
+            assert np.array_equal(H_ref, H_reg), f"stage {i}: positive definite Hessian block was modified"
+        else:
+            if regularize_method == 'PROJECT':
+                d = np.maximum(d, eps)
+            else:
+                d = np.where(np.abs(d) <= eps, eps, np.abs(d))
+            assert np.allclose(V @ np.diag(d) @ V.T, H_reg, rtol=1e-10, atol=1e-10), \
+                f"stage {i}: indefinite Hessian block not regularized as expected, got {H_reg}"
+
 
 if __name__ == '__main__':
     main(regularize_method='NO_REGULARIZE')
     main(regularize_method='MIRROR')
     main(regularize_method='CONVEXIFY')
     main(regularize_method='PROJECT')
+    main_skip_pd_stages(regularize_method='PROJECT')
+    main_skip_pd_stages(regularize_method='MIRROR')
 
 
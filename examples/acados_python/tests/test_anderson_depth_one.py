@@ -0,0 +1,149 @@
+#
+# Copyright (c) The acados authors.
+#
+# This file is part of acados.
+#
+# The 2-Clause BSD License
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice,
+# this list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright notice,
+# this list of conditions and the following disclaimer in the documentation
+# and/or other materials provided with the distribution.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.;
+#
+
+import sys
+sys.path.insert(0, '../pendulum_on_cart/common')
+
+from acados_template import AcadosOcp, AcadosOcpSolver
+from pendulum_model import export_pendulum_ode_model
+import numpy as np
+import scipy.linalg
+
+N = 20
+ANDERSON_ACTIVATION_THRESHOLD = 1.0
+
+
+def create_solver(with_anderson_acceleration: bool, max_iter: int) -> AcadosOcpSolver:
+    ocp = AcadosOcp()
+    ocp.model = export_pendulum_ode_model()
+    name = 'anderson' if with_anderson_acceleration else 'plain'
+    ocp.model.name = f'pendulum_{name}'
+    nx = ocp.model.x.rows()
+    nu = ocp.model.u.rows()
+
+    ocp.solver_options.N_horizon = N
+    ocp.solver_options.tf = 1.0
+
+    ocp.cost.cost_type = 'LINEAR_LS'
+    ocp.cost.cost_type_e = 'LINEAR_LS'
+    ocp.cost.W = scipy.linalg.block_diag(2*np.diag([1e3, 1e3, 1e-2, 1e-2]), 2*np.diag([1e-2]))
+    ocp.cost.W_e = 2*np.diag([1e3, 1e3, 1e-2, 1e-2])
+    ocp.cost.Vx = np.zeros((nx+nu, nx))
+    ocp.cost.Vx[:nx, :nx] = np.eye(nx)
+    ocp.cost.Vu = np.zeros((nx+nu, nu))
+    ocp.cost.Vu[nx, 0] = 1.0
+    ocp.cost.Vx_e = np.eye(nx)
+    ocp.cost.yref = np.zeros((nx+nu, ))
+    ocp.cost.yref_e = np.zeros((nx, ))
+
+    Fmax = 80
+    ocp.constraints.lbu = np.array([-Fmax])
+    ocp.constraints.ubu = np.array([+Fmax])
+    ocp.constraints.idxbu = np.array([0])
+    ocp.constraints.x0 = np.array([0.0, 0.15 * np.pi, 0.0, 0.0])
+
+    ocp.solver_options.integrator_type = 'ERK'
+    ocp.solver_options.nlp_solver_type = 'SQP'
+    ocp.solver_options.globalization = 'FIXED_STEP'
+    ocp.solver_options.nlp_solver_max_iter = max_iter
+    ocp.solver_options.with_anderson_acceleration = with_anderson_acceleration
+    ocp.solver_options.anderson_activation_threshold = ANDERSON_ACTIVATION_THRESHOLD
+    ocp.solver_options.anderson_depth = 1
+    ocp.solver_options.store_iterates = True
+
+    ocp.code_export_directory = f'c_generated_code_{ocp.model.name}'
+    return AcadosOcpSolver(ocp, json_file=f'acados_ocp_{ocp.model.name}.json', verbose=False)
+
+
+def full_step(plain_solver: AcadosOcpSolver, iterate):
+    """QP step at iterate, as difference between one full SQP step and the iterate"""
+    for n in range(N+1):
+        plain_solver.set(n, 'x', iterate.x[n])
+        plain_solver.set(n, 'lam', iterate.lam[n])
+        if n < N:
+            plain_solver.set(n, 'u', iterate.u[n])
+            plain_solver.set(n, 'pi', iterate.pi[n])
+    plain_solver.solve()
+    step = plain_solver.get_iterate()
+    return {field: [new - old for new, old in zip(getattr(step, field), getattr(iterate, field))]
+            for field in ['x', 'u', 'pi', 'lam']}
+
+
+def axpy(alpha, x, y):
+    return {field: [alpha * a + b for a, b in zip(x[field], y[field])] for field in x}
+
+
+def ddot(x, y):
+    """inner product used by the Anderson acceleration: bound multipliers enter as lower minus upper"""
+    out = 0.0
+    for field in ['x', 'u', 'pi']:
+        out += sum(np.dot(a, b) for a, b in zip(x[field], y[field]))
+    for a, b in zip(x['lam'], y['lam']):
+        nb = a.shape[0] // 2
+        out += np.dot(a[:nb] - a[nb:], b[:nb] - b[nb:])
+    return out
+
+
+def main():
+    anderson_solver = create_solver(with_anderson_acceleration=True, max_iter=50)
+    plain_solver = create_solver(with_anderson_acceleration=False, max_iter=1)
+
+    status = anderson_solver.solve()
+    assert status == 0, f'Anderson acceleration returned status {status}.'
+    nlp_iter = anderson_solver.get_stats('nlp_iter')
+    inf_norm_res = np.max(anderson_solver.get_stats('res_all'), axis=1)
+
+    iterates = [anderson_solver.get_iterate(k) for k in range(nlp_iter+1)]
+    steps = [full_step(plain_solver, iterate) for iterate in iterates[:-1]]
+
+    # depth 1: step = d_k - gamma * (dx_{k-1} + d_k - d_{k-1}), gamma = <d_k, dd> / <dd, dd>
+    num_accelerated = 0
+    for k in range(1, nlp_iter):
+        w_k = {field: getattr(iterates[k], field) for field in ['x', 'u', 'pi', 'lam']}
+        expected = axpy(1.0, steps[k], w_k)
+        if inf_norm_res[k] <= ANDERSON_ACTIVATION_THRESHOLD:
+            w_prev = {field: getattr(iterates[k-1], field) for field in ['x', 'u', 'pi', 'lam']}
+            dx = axpy(-1.0, w_prev, w_k)
+            dd = axpy(-1.0, steps[k-1], steps[k])
+            gamma = ddot(steps[k], dd) / ddot(dd, dd)
+            expected = axpy(-gamma, axpy(1.0, dx, dd), expected)
+            num_accelerated += 1
+
+        for field in ['x', 'u', 'pi', 'lam']:
+            for n, (a, b) in enumerate(zip(getattr(iterates[k+1], field), expected[field])):
+                assert np.allclose(a, b, rtol=1e-8, atol=1e-8), \
+                    f'Anderson iterate {k+1} differs from the depth 1 update in {field} at stage {n}: {a} vs {b}.'
+
+    assert num_accelerated > 0, 'no Anderson steps were taken, increase ANDERSON_ACTIVATION_THRESHOLD.'
+    print(f'test_anderson_depth_one: {num_accelerated} Anderson steps match the depth 1 update')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,127 @@
+#
+# Copyright (c) The acados authors.
+#
+# This file is part of acados.
+#
+# The 2-Clause BSD License
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice,
+# this list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright notice,
+# this list of conditions and the following disclaimer in the documentation
+# and/or other materials provided with the distribution.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.;
+#
+
+import sys
+sys.path.insert(0, '../pendulum_on_cart/common')
+
+import json
+import struct
+from collections import defaultdict
+
+from acados_template import AcadosOcp, AcadosOcpSolver
+from pendulum_model import export_pendulum_ode_model
+import numpy as np
+import scipy.linalg
+
+N = 20
+
+def create_solver() -> AcadosOcpSolver:
+    ocp = AcadosOcp()
+    ocp.model = export_pendulum_ode_model()
+    nx = ocp.model.x.rows()
+    nu = ocp.model.u.rows()
+
+    Q_mat = 2*np.diag([1e3, 1e3, 1e-2, 1e-2])
+    R_mat = 2*np.diag([1e-2])
+    ocp.cost.cost_type = 'LINEAR_LS'
+    ocp.cost.cost_type_e = 'LINEAR_LS'
+    ocp.cost.W = scipy.linalg.block_diag(Q_mat, R_mat)
+    ocp.cost.W_e = Q_mat
+    ocp.cost.Vx = np.vstack((np.eye(nx), np.zeros((nu, nx))))
+    ocp.cost.Vu = np.vstack((np.zeros((nx, nu)), np.eye(nu)))
+    ocp.cost.Vx_e = np.eye(nx)
+    ocp.cost.yref = np.zeros((nx+nu,))
+    ocp.cost.yref_e = np.zeros((nx,))
+
+    Fmax = 80
+    ocp.constraints.lbu = np.array([-Fmax])
+    ocp.constraints.ubu = np.array([+Fmax])
+    ocp.constraints.idxbu = np.array([0])
+    ocp.constraints.x0 = np.array([0.0, np.pi, 0.0, 0.0])
+
+    ocp.solver_options.N_horizon = N
+    ocp.solver_options.tf = 1.0
+    ocp.solver_options.qp_solver = 'PARTIAL_CONDENSING_HPIPM'
+    ocp.solver_options.hessian_approx = 'GAUSS_NEWTON'
+    ocp.solver_options.integrator_type = 'ERK'
+    ocp.solver_options.nlp_solver_type = 'SQP'
+    ocp.solver_options.nlp_solver_max_iter = 100
+    ocp.solver_options.profiler_buffer_size = 100000
+
+    return AcadosOcpSolver(ocp, json_file='profiler_ocp.json', verbose=False)
+
+
+def main():
+    ocp_solver = create_solver()
+    status = ocp_solver.solve()
+    assert status == 0, f"acados returned status {status}"
+    sqp_iter = ocp_solver.get_stats('sqp_iter')
+
+    ocp_solver.dump_profile('profile.json', format='json')
+    ocp_solver.dump_profile('profile.bin', format='binary')
+
+    with open('profile.json', 'r') as f:
+        trace = json.load(f)
+    events = trace['traceEvents']
+    assert len(events) > 0, "profiler recorded no events"
+
+    # (name, iteration) -> stages with an event
+    stages = defaultdict(set)
+    for event in events:
+        assert event['ph'] == 'X' and event['dur'] >= 0.0
+        assert event['tid'] == event['args']['stage'] + 1
+        stages[(event['name'], event['args']['iter'])].add(event['args']['stage'])
+
+    qp_iterations = sorted(it for (name, it) in stages.keys() if name == 'qp')
+    assert qp_iterations == list(range(sqp_iter)), f"expected a QP event in each of the {sqp_iter} SQP iterations, got {qp_iterations}"
+
+    for it in qp_iterations:
+        for name, expected in [('dynamics', set(range(N))), ('cost', set(range(N+1))), ('constraints', set(range(N+1))), ('ext_function', set(range(N)))]:
+            missing = expected - stages[(name, it)]
+            assert not missing, f"iteration {it}: no {name} event for stages {sorted(missing)}"
+
+    # the binary dump contains the same events
+    with open('profile.bin', 'rb') as f:
+        data = f.read()
+    assert data[:6] == b'ACPROF'
+    version, num_events = struct.unpack_from('<ii', data, 6)
+    assert version == 2 and num_events == len(events)
+    event_format = '<ddiiii'
+    assert len(data) == 14 + num_events * struct.calcsize(event_format)
+    for i, event in enumerate(events):
+        t_start, t_end, _, stage, it, solve = struct.unpack_from(event_format, data, 14 + i * struct.calcsize(event_format))
+        assert (stage, it, solve) == (event['args']['stage'], event['args']['iter'], event['args']['solve'])
+        assert abs(1e6 * t_start - event['ts']) < 1e-2
+
+    print(f"test_profiler: {len(events)} events for {sqp_iter} SQP iterations checked.")
+
+
+if __name__ == "__main__":
+    main()
@@ -31,9 +31,10 @@
 import sys
 sys.path.insert(0, '../pendulum_on_cart/common')
 
-from acados_template import AcadosOcp, AcadosOcpSolver
+from acados_template import AcadosOcp, AcadosOcpSolver, AcadosModel
 from pendulum_model import export_pendulum_ode_model
 import numpy as np
+import casadi as ca
 import argparse
 import scipy.linalg
 
@@ -123,8 +124,76 @@ def main(qp_solver="PARTIAL_CONDENSING_OSQP"):
 
     # plot_pendulum(np.linspace(0, Tf, N+1), Fmax, simU, simX, latexify=False)
 
+
+def closed_loop_linear_osqp(qp_solver, osqp_reuse_factorization, n_sim=10):
+    # linear dynamics and a constant quadratic cost: P and A of all QPs are bitwise identical
+    ocp = AcadosOcp()
+    nx, nu = 2, 1
+    x = ca.SX.sym('x', nx)
+    u = ca.SX.sym('u', nu)
+    A = np.array([[1.0, 0.1], [0.0, 1.0]])
+    B = np.array([[0.005], [0.1]])
+
+    model = AcadosModel()
+    model.name = f'linear_osqp_reuse_{int(osqp_reuse_factorization)}'
+    model.x = x
+    model.u = u
+    model.disc_dyn_expr = A @ x + B @ u
+    ocp.model = model
+
+    N = 20
+    ocp.solver_options.N_horizon = N
+    ocp.solver_options.tf = 2.0
+
+    ocp.cost.cost_type = 'LINEAR_LS'
+    ocp.cost.cost_type_e = 'LINEAR_LS'
+    ocp.cost.W = np.diag([10.0, 1.0, 0.1])
+    ocp.cost.W_e = np.diag([10.0, 1.0])
+    ocp.cost.Vx = np.vstack((np.eye(nx), np.zeros((nu, nx))))
+    ocp.cost.Vu = np.vstack((np.zeros((nx, nu)), np.eye(nu)))
+    ocp.cost.Vx_e = np.eye(nx)
+    ocp.cost.yref = np.zeros((nx+nu,))
+    ocp.cost.yref_e = np.zeros((nx,))
+
+    ocp.constraints.lbu = np.array([-1.0])
+    ocp.constraints.ubu = np.array([+1.0])
+    ocp.constraints.idxbu = np.array([0])
+    x0 = np.array([2.0, 0.0])
+    ocp.constraints.x0 = x0
+
+    ocp.solver_options.qp_solver = qp_solver
+    ocp.solver_options.hessian_approx = 'GAUSS_NEWTON'
+    ocp.solver_options.integrator_type = 'DISCRETE'
+    ocp.solver_options.nlp_solver_type = 'SQP'
+    ocp.solver_options.qp_solver_iter_max = 2000
+    ocp.solver_options.osqp_reuse_factorization = osqp_reuse_factorization
+    ocp.code_export_directory = f'c_generated_code_{model.name}'
+
+    ocp_solver = AcadosOcpSolver(ocp, json_file=f'{model.name}.json')
+
+    simX = np.zeros((n_sim+1, nx))
+    simU = np.zeros((n_sim, nu))
+    simX[0, :] = x0
+    for k in range(n_sim):
+        simU[k, :] = ocp_solver.solve_for_x0(simX[k, :])
+        simX[k+1, :] = A @ simX[k, :] + B @ simU[k, :]
+
+    num_fact = ocp_solver.get_stats('qp_num_refactorizations')
+    print(f"OSQP KKT factorizations with osqp_reuse_factorization={osqp_reuse_factorization}: {num_fact}")
+    return simX, simU, num_fact
+
+
 if __name__ == "__main__":
     parser = argparse.ArgumentParser()
     parser.add_argument('--qp_solver', type=str, default='PARTIAL_CONDENSING_OSQP', help='QP solver to use')
     args = parser.parse_args()
     main(qp_solver=args.qp_solver)
+
+    if 'OSQP' in args.qp_solver:
+        # skipping the factorization for unchanged matrices must not change the solution
+        simX, simU, num_fact = closed_loop_linear_osqp(args.qp_solver, False)
+        simX_reuse, simU_reuse, num_fact_reuse = closed_loop_linear_osqp(args.qp_solver, True)
+        assert np.allclose(simX, simX_reuse, atol=1e-8) and np.allclose(simU, simU_reuse, atol=1e-8), \
+            'closed-loop trajectory with osqp_reuse_factorization differs.'
+        assert num_fact_reuse < num_fact, \
+            f'osqp_reuse_factorization should save factorizations for constant P and A, got {num_fact_reuse} >= {num_fact}.'
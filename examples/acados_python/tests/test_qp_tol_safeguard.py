@@ -0,0 +1,106 @@
+#
+# Copyright (c) The acados authors.
+#
+# This file is part of acados.
+#
+# The 2-Clause BSD License
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice,
+# this list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright notice,
+# this list of conditions and the following disclaimer in the documentation
+# and/or other materials provided with the distribution.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.;
+#
+
+from acados_template import AcadosOcp, AcadosOcpSolver, AcadosModel
+import numpy as np
+import casadi as ca
+
+# The iterate starts feasible, U_INIT above the active bound u >= 0.
+# With a loose QP tolerance the interior point solver stops on the central path,
+# i.e. with a slack of order mu / LINEAR_WEIGHT >> U_INIT, such that the QP step
+# moves away from the bound and is not a descent direction for the linear cost.
+U_INIT = 1e-10
+LINEAR_WEIGHT = 1e-3
+
+def create_solver(nlp_qp_tol_safeguard: bool) -> AcadosOcpSolver:
+    ocp = AcadosOcp()
+
+    model = AcadosModel()
+    model.name = f'qp_tol_safeguard_{int(nlp_qp_tol_safeguard)}'
+    model.x = ca.SX.sym('x')
+    model.u = ca.SX.sym('u')
+    model.disc_dyn_expr = model.x + model.u
+    model.cost_expr_ext_cost = LINEAR_WEIGHT * model.u + 0.5 * 1e-6 * (model.u**2 + model.x**2)
+    model.cost_expr_ext_cost_e = 0.5 * 1e-6 * model.x**2
+    ocp.model = model
+
+    ocp.solver_options.N_horizon = 1
+    ocp.solver_options.tf = 1.0
+    ocp.solver_options.integrator_type = 'DISCRETE'
+
+    ocp.cost.cost_type = 'EXTERNAL'
+    ocp.cost.cost_type_e = 'EXTERNAL'
+
+    ocp.constraints.x0 = np.array([0.0])
+    ocp.constraints.lbu = np.array([0.0])
+    ocp.constraints.ubu = np.array([1.0])
+    ocp.constraints.idxbu = np.array([0])
+
+    ocp.solver_options.nlp_solver_type = 'SQP'
+    ocp.solver_options.hessian_approx = 'EXACT'
+    ocp.solver_options.qp_solver = 'PARTIAL_CONDENSING_HPIPM'
+    ocp.solver_options.nlp_qp_tol_strategy = 'ADAPTIVE_CURRENT_RES_JOINT'
+    ocp.solver_options.nlp_qp_tol_reduction_factor = 1.0
+    ocp.solver_options.nlp_qp_tol_safeguard = nlp_qp_tol_safeguard
+    ocp.solver_options.nlp_solver_max_iter = 50
+    ocp.solver_options.tol = 1e-8
+
+    return AcadosOcpSolver(ocp, json_file=f'{model.name}.json', verbose=False)
+
+
+def solve(solver: AcadosOcpSolver):
+    solver.set(0, 'x', np.array([0.0]))
+    solver.set(0, 'u', np.array([U_INIT]))
+    solver.set(1, 'x', np.array([U_INIT]))
+    status = solver.solve()
+    solver.print_statistics()
+    return status, solver.get(0, 'u'), solver.get_stats('qp_num_resolves'), solver.get_stats('sqp_iter')
+
+
+def main():
+    solver = create_solver(nlp_qp_tol_safeguard=True)
+    status, u0, num_resolves, sqp_iter = solve(solver)
+    print(f"safeguard on: status {status}, u0 {u0}, QP re-solves {num_resolves}, SQP iterations {sqp_iter}")
+
+    if status != 0:
+        raise Exception(f"acados returned status {status} with nlp_qp_tol_safeguard.")
+    if num_resolves < 1:
+        raise Exception("Expected nlp_qp_tol_safeguard to re-solve the inexact QP at the feasible initial iterate.")
+    if not np.allclose(u0, 0.0, atol=1e-8):
+        raise Exception(f"Expected the lower bound on u to be active at the solution, got u0 = {u0}.")
+
+    solver = create_solver(nlp_qp_tol_safeguard=False)
+    _, _, num_resolves, _ = solve(solver)
+    if num_resolves != 0:
+        raise Exception(f"Expected no QP re-solves without nlp_qp_tol_safeguard, got {num_resolves}.")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,140 @@
+#
+# Copyright (c) The acados authors.
+#
+# This file is part of acados.
+#
+# The 2-Clause BSD License
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice,
+# this list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright notice,
+# this list of conditions and the following disclaimer in the documentation
+# and/or other materials provided with the distribution.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.;
+#
+
+import sys
+sys.path.insert(0, '../pendulum_on_cart/common')
+
+import numpy as np
+import scipy.linalg
+from acados_template import AcadosOcp, AcadosOcpSolver
+from pendulum_model import export_pendulum_ode_model
+
+ACADOS_UNKNOWN = -1
+
+def create_ocp(N: int) -> AcadosOcp:
+    ocp = AcadosOcp()
+    ocp.model = export_pendulum_ode_model()
+    ocp.model.name = f'pendulum_snapshot_N{N}'
+    nx = ocp.model.x.rows()
+    nu = ocp.model.u.rows()
+
+    Q_mat = 2*np.diag([1e3, 1e3, 1e-2, 1e-2])
+    R_mat = 2*np.diag([1e-2])
+    ocp.cost.cost_type = 'LINEAR_LS'
+    ocp.cost.cost_type_e = 'LINEAR_LS'
+    ocp.cost.W = scipy.linalg.block_diag(Q_mat, R_mat)
+    ocp.cost.W_e = Q_mat
+    ocp.cost.Vx = np.vstack((np.eye(nx), np.zeros((nu, nx))))
+    ocp.cost.Vu = np.vstack((np.zeros((nx, nu)), np.eye(nu)))
+    ocp.cost.Vx_e = np.eye(nx)
+    ocp.cost.yref = np.zeros((nx+nu,))
+    ocp.cost.yref_e = np.zeros((nx,))
+
+    Fmax = 80
+    ocp.constraints.lbu = np.array([-Fmax])
+    ocp.constraints.ubu = np.array([+Fmax])
+    ocp.constraints.idxbu = np.array([0])
+    ocp.constraints.x0 = np.array([0.0, np.pi, 0.0, 0.0])
+
+    ocp.solver_options.N_horizon = N
+    ocp.solver_options.tf = 1.0
+    ocp.solver_options.qp_solver = 'PARTIAL_CONDENSING_HPIPM'
+    ocp.solver_options.hessian_approx = 'GAUSS_NEWTON'
+    ocp.solver_options.integrator_type = 'ERK'
+    ocp.solver_options.nlp_solver_type = 'SQP_RTI'
+    return ocp
+
+
+def feedback(ocp_solver: AcadosOcpSolver, x0):
+    ocp_solver.set(0, 'lbx', x0)
+    ocp_solver.set(0, 'ubx', x0)
+    ocp_solver.options_set('rti_phase', 2)
+    status = ocp_solver.solve()
+    iterate = ocp_solver.get_flat_iterate()
+    return status, np.concatenate([iterate.x, iterate.u, iterate.pi, iterate.lam])
+
+
+def raw_load(ocp_solver: AcadosOcpSolver, filename: str) -> int:
+    return ocp_solver.acados_lib.ocp_nlp_solver_snapshot_load(ocp_solver.nlp_solver, ocp_solver.nlp_out, filename.encode('utf-8'))
+
+
+def main():
+    N = 20
+    ocp = create_ocp(N)
+    solver_a = AcadosOcpSolver(ocp, json_file=f'{ocp.model.name}.json', verbose=False)
+
+    # warm up with a few RTI iterations, then prepare
+    x0 = np.array([0.0, np.pi, 0.0, 0.0])
+    for i in range(5):
+        solver_a.options_set('rti_phase', 1)
+        solver_a.solve()
+        feedback(solver_a, x0)
+    solver_a.options_set('rti_phase', 1)
+    solver_a.solve()
+    solver_a.save_snapshot('snapshot.bin')
+
+    # fresh solver from the same generated code
+    solver_b = AcadosOcpSolver(ocp, json_file=f'{ocp.model.name}.json', generate=False, build=False, verbose=False)
+    solver_b.load_snapshot('snapshot.bin')
+
+    x0_new = np.array([0.1, np.pi - 0.2, 0.0, 0.0])
+    status_a, iterate_a = feedback(solver_a, x0_new)
+    status_b, iterate_b = feedback(solver_b, x0_new)
+    assert status_a == status_b, f"status after loading the snapshot differs: {status_a} vs {status_b}"
+    assert np.array_equal(iterate_a, iterate_b), \
+        f"feedback after loading the snapshot differs, max difference {np.max(np.abs(iterate_a - iterate_b))}"
+
+    # snapshot of a solver with different dimensions
+    ocp_short = create_ocp(N // 2)
+    solver_c = AcadosOcpSolver(ocp_short, json_file=f'{ocp_short.model.name}.json', verbose=False)
+    assert raw_load(solver_c, 'snapshot.bin') == ACADOS_UNKNOWN
+    try:
+        solver_c.load_snapshot('snapshot.bin')
+        raise Exception("load_snapshot should fail for a snapshot with different dimensions")
+    except RuntimeError:
+        pass
+
+    # truncated snapshot
+    with open('snapshot.bin', 'rb') as f:
+        data = f.read()
+    with open('snapshot_truncated.bin', 'wb') as f:
+        f.write(data[:len(data) // 2])
+    assert raw_load(solver_b, 'snapshot_truncated.bin') == ACADOS_UNKNOWN
+
+    # solver_b is unchanged by the failed loads
+    status_b, iterate_b_after = feedback(solver_b, x0_new)
+    status_a, iterate_a_after = feedback(solver_a, x0_new)
+    assert np.array_equal(iterate_a_after, iterate_b_after)
+
+    print("test_snapshot: round trip, dimension mismatch and truncated snapshot checked.")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,136 @@
+#
+# Copyright (c) The acados authors.
+#
+# This file is part of acados.
+#
+# The 2-Clause BSD License
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice,
+# this list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright notice,
+# this list of conditions and the following disclaimer in the documentation
+# and/or other materials provided with the distribution.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.;
+#
+
+import sys
+sys.path.insert(0, '../pendulum_on_cart/common')
+
+from acados_template import AcadosOcp, AcadosOcpSolver
+from pendulum_model import export_pendulum_ode_model
+import numpy as np
+import scipy.linalg
+
+# solves the nonlinear pendulum swing-up with the TRUST_REGION globalization and compares to MERIT_BACKTRACKING.
+# With all states and controls bounded, the trust region acts on the control bounds and truncation only;
+# the radius has to grow again after being reduced for the solver to converge in a reasonable number of iterations.
+
+TOL = 1e-6
+N = 20
+
+
+def create_solver(globalization: str, radius_init: float = 0.5) -> AcadosOcpSolver:
+    ocp = AcadosOcp()
+
+    model = export_pendulum_ode_model()
+    model.name += f'_{globalization.lower()}'
+    ocp.model = model
+
+    nx = model.x.rows()
+    nu = model.u.rows()
+    ny = nx + nu
+
+    ocp.solver_options.N_horizon = N
+    ocp.solver_options.tf = 1.0
+
+    # cost
+    Q = 2*np.diag([1e3, 1e3, 1e-2, 1e-2])
+    R = 2*np.diag([1e-2])
+    ocp.cost.cost_type = 'LINEAR_LS'
+    ocp.cost.cost_type_e = 'LINEAR_LS'
+    ocp.cost.W = scipy.linalg.block_diag(Q, R)
+    ocp.cost.W_e = Q
+    ocp.cost.Vx = np.zeros((ny, nx))
+    ocp.cost.Vx[:nx, :nx] = np.eye(nx)
+    ocp.cost.Vu = np.zeros((ny, nu))
+    ocp.cost.Vu[nx, 0] = 1.0
+    ocp.cost.Vx_e = np.eye(nx)
+    ocp.cost.yref = np.zeros((ny, ))
+    ocp.cost.yref_e = np.zeros((nx, ))
+
+    # constraints: all variables bounded
+    Fmax = 80
+    ocp.constraints.lbu = np.array([-Fmax])
+    ocp.constraints.ubu = np.array([+Fmax])
+    ocp.constraints.idxbu = np.array([0])
+    ocp.constraints.x0 = np.array([0.0, np.pi, 0.0, 0.0])
+    ocp.constraints.lbx = np.array([-2.0, -2*np.pi, -10.0, -20.0])
+    ocp.constraints.ubx = np.array([2.0, 2*np.pi, 10.0, 20.0])
+    ocp.constraints.idxbx = np.arange(nx)
+
+    ocp.solver_options.qp_solver = 'PARTIAL_CONDENSING_HPIPM'
+    ocp.solver_options.hessian_approx = 'GAUSS_NEWTON'
+    ocp.solver_options.integrator_type = 'ERK'
+    ocp.solver_options.nlp_solver_type = 'SQP'
+    ocp.solver_options.globalization = globalization
+    ocp.solver_options.nlp_solver_max_iter = 200
+    ocp.solver_options.tol = TOL
+    ocp.solver_options.print_level = 0
+    if globalization == 'TRUST_REGION':
+        ocp.solver_options.globalization_trust_region_radius_init = radius_init
+
+    return AcadosOcpSolver(ocp, json_file=f'{model.name}.json', verbose=False)
+
+
+def solve(solver: AcadosOcpSolver):
+    status = solver.solve()
+    solver.print_statistics()
+    x = np.array([solver.get(i, "x") for i in range(N+1)])
+    u = np.array([solver.get(i, "u") for i in range(N)])
+    lam = [solver.get(i, "lam") for i in range(N+1)]
+    return status, x, u, lam, solver.get_stats('nlp_iter')
+
+
+def main():
+    status_ref, x_ref, u_ref, _, iter_ref = solve(create_solver('MERIT_BACKTRACKING'))
+    if status_ref != 0:
+        raise RuntimeError(f"MERIT_BACKTRACKING returned status {status_ref}.")
+
+    for radius_init in [0.5, 1e-2]:
+        status, x, u, lam, nlp_iter = solve(create_solver('TRUST_REGION', radius_init))
+        print(f"TRUST_REGION with radius_init = {radius_init}: status {status} after {nlp_iter} iterations, MERIT_BACKTRACKING: {iter_ref} iterations.")
+        if status != 0:
+            raise RuntimeError(f"TRUST_REGION returned status {status} with radius_init = {radius_init}.")
+        if nlp_iter > 100:
+            raise RuntimeError(f"TRUST_REGION took {nlp_iter} iterations, the radius does not seem to grow.")
+
+        err_x = np.max(np.abs(x - x_ref))
+        err_u = np.max(np.abs(u - u_ref))
+        if err_x > 1e2*TOL or err_u > 1e3*TOL:
+            raise RuntimeError(f"TRUST_REGION solution differs from MERIT_BACKTRACKING: err_x = {err_x}, err_u = {err_u}.")
+
+        # multipliers of the trust region are not NLP multipliers
+        for i in range(N+1):
+            if np.any(lam[i] < -TOL):
+                raise RuntimeError(f"negative multiplier at stage {i}: {lam[i]}")
+
+    print("TRUST_REGION test passed.")
+
+
+if __name__ == '__main__':
+    main()
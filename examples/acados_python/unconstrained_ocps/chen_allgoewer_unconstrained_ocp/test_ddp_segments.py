@@ -0,0 +1,144 @@
+#
+# Copyright (c) The acados authors.
+#
+# This file is part of acados.
+#
+# The 2-Clause BSD License
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice,
+# this list of conditions and the following disclaimer.
+#
+# 2. Redistributions in binary form must reproduce the above copyright notice,
+# this list of conditions and the following disclaimer in the documentation
+# and/or other materials provided with the distribution.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.;
+#
+
+from acados_template import AcadosOcp, AcadosOcpSolver
+from chen_allgoewer_system_model import export_chen_allgoewer_model
+import numpy as np
+
+N = 40
+TOL = 1e-8
+
+def create_solver(num_segments: int, defect_closing: str = 'GRADUAL', nonmonotone_window: int = 1) -> AcadosOcpSolver:
+    ocp = AcadosOcp()
+    ocp.model = export_chen_allgoewer_model(use_SX=False)
+    x = ocp.model.x
+    u = ocp.model.u
+
+    ocp.solver_options.N_horizon = N
+    ocp.solver_options.tf = 5.0
+
+    Q_mat = np.array([[0.5, 0], [0, 0.5]])
+    R_mat = np.array([[0.8]])
+    P_mat = np.array([[10.0, 0], [0, 10.0]])
+    ocp.cost.cost_type = 'EXTERNAL'
+    ocp.cost.cost_type_e = 'EXTERNAL'
+    ocp.model.cost_expr_ext_cost = 0.5 * x.T @ Q_mat @ x + 0.5 * u.T @ R_mat @ u
+    ocp.model.cost_expr_ext_cost_e = 0.5 * x.T @ P_mat @ x
+
+    ocp.constraints.x0 = np.array([0.42, 0.45])
+
+    ocp.solver_options.qp_solver = 'PARTIAL_CONDENSING_HPIPM'
+    ocp.solver_options.qp_solver_cond_N = N
+    ocp.solver_options.hessian_approx = 'EXACT'
+    ocp.solver_options.integrator_type = 'ERK'
+    ocp.solver_options.sim_method_num_steps = 5
+    ocp.solver_options.nlp_solver_type = 'DDP'
+    ocp.solver_options.nlp_solver_max_iter = 100
+    ocp.solver_options.globalization = 'MERIT_BACKTRACKING'
+    ocp.solver_options.with_adaptive_levenberg_marquardt = True
+    ocp.solver_options.tol = TOL
+    ocp.solver_options.ddp_num_segments = num_segments
+    ocp.solver_options.ddp_defect_closing = defect_closing
+    ocp.solver_options.globalization_nonmonotone_window = nonmonotone_window
+
+    name = f'ddp_{num_segments}_{defect_closing}_window_{nonmonotone_window}'
+    ocp.model.name = f'chen_allgoewer_{name}'
+    ocp.code_export_directory = f'c_generated_code_{name}'
+    return AcadosOcpSolver(ocp, json_file=f'acados_ocp_{name}.json', verbose=False)
+
+
+def solve(solver: AcadosOcpSolver, X_init, U_init):
+    for i in range(N):
+        solver.set(i, "x", X_init[i])
+        solver.set(i, "u", U_init[i])
+    solver.set(N, "x", X_init[N])
+
+    status = solver.solve()
+    solver.print_statistics()
+    assert status == 0, f'DDP returned status {status}.'
+
+    res_eq = solver.get_stats('residuals')[1]
+    assert res_eq < TOL, f'DDP converged to an iterate with defects {res_eq:.2e}.'
+
+    X = np.array([solver.get(i, "x") for i in range(N+1)])
+    U = np.array([solver.get(i, "u") for i in range(N)])
+    return X, U
+
+
+def count_rejected_steps(solver: AcadosOcpSolver) -> int:
+    # every rejected trial step reduces the step size by alpha_reduction = 0.7
+    alpha = solver.get_stats('alpha')
+    alpha = alpha[alpha > 0]
+    return int(np.sum(np.round(np.log(alpha) / np.log(0.7))))
+
+
+def main_nonmonotone(initial_guesses):
+    for num_segments in [1, 4]:
+        monotone_solver = create_solver(num_segments, nonmonotone_window=1)
+        nonmonotone_solver = create_solver(num_segments, nonmonotone_window=4)
+        for guess_name, (X_init, U_init) in initial_guesses.items():
+            X_ref, U_ref = solve(monotone_solver, X_init, U_init)
+            rejected_ref = count_rejected_steps(monotone_solver)
+            X, U = solve(nonmonotone_solver, X_init, U_init)
+            rejected = count_rejected_steps(nonmonotone_solver)
+            print(f'{guess_name} initial guess, {num_segments} segments: rejected steps monotone {rejected_ref}, nonmonotone {rejected}')
+            assert np.allclose(X, X_ref, atol=1e-6), f'nonmonotone line search changes the state trajectory for {num_segments} segments.'
+            assert np.allclose(U, U_ref, atol=1e-6), f'nonmonotone line search changes the control trajectory for {num_segments} segments.'
+            assert rejected <= rejected_ref, f'nonmonotone line search rejects more steps ({rejected} > {rejected_ref}) for {num_segments} segments.'
+
+
+def main():
+    # both initial guesses are inconsistent with the dynamics
+    initial_guesses = {
+        'constant': (np.tile(np.array([0.42, 0.45]), (N+1, 1)), np.zeros((N, 1))),
+        'perturbed': (np.tile(np.array([0.1, -0.2]), (N+1, 1)), 0.5 * np.ones((N, 1))),
+    }
+
+    ref_solver = create_solver(1)
+    solvers = {(num_segments, closing): create_solver(num_segments, closing)
+               for num_segments in [4, 7] for closing in ['GRADUAL', 'MERGE']}
+
+    for guess_name, (X_init, U_init) in initial_guesses.items():
+        X_init[0] = np.array([0.42, 0.45])
+
+        X_ref, U_ref = solve(ref_solver, X_init, U_init)
+        for (num_segments, closing), solver in solvers.items():
+            X, U = solve(solver, X_init, U_init)
+            print(f'{guess_name} initial guess, {num_segments} segments, {closing}: iter {solver.get_stats("nlp_iter")}')
+            assert np.allclose(X, X_ref, atol=1e-6), f'state trajectories differ for {num_segments} segments, {closing}.'
+            assert np.allclose(U, U_ref, atol=1e-6), f'control trajectories differ for {num_segments} segments, {closing}.'
+
+    main_nonmonotone(initial_guesses)
+
+    print('test_ddp_segments: success')
+
+
+if __name__ == '__main__':
+    main()
@@ -49,6 +49,7 @@
 #include "acados/ocp_nlp/ocp_nlp_constraints_bgp.h"
 #include "acados/ocp_nlp/ocp_nlp_reg_convexify.h"
 #include "acados/ocp_nlp/ocp_nlp_reg_glm.h"
+#include "acados/ocp_nlp/ocp_nlp_reg_inertia.h"
 #include "acados/ocp_nlp/ocp_nlp_reg_mirror.h"
 #include "acados/ocp_nlp/ocp_nlp_reg_project.h"
 #include "acados/ocp_nlp/ocp_nlp_reg_project_reduc_hess.h"
@@ -57,13 +58,16 @@
 #include "acados/ocp_nlp/ocp_nlp_globalization_fixed_step.h"
 #include "acados/ocp_nlp/ocp_nlp_globalization_merit_backtracking.h"
 #include "acados/ocp_nlp/ocp_nlp_globalization_funnel.h"
+#include "acados/ocp_nlp/ocp_nlp_globalization_trust_region.h"
 #include "acados/ocp_nlp/ocp_nlp_sqp.h"
 #include "acados/ocp_nlp/ocp_nlp_sqp_with_feasible_qp.h"
 #include "acados/ocp_nlp/ocp_nlp_sqp_rti.h"
 #include "acados/ocp_nlp/ocp_nlp_ddp.h"
+#include "acados/ocp_nlp/ocp_nlp_snapshot.h"
 #include "acados/dense_qp/dense_qp_common.h"
 #include "acados/utils/mem.h"
 #include "acados/utils/strsep.h"
+#include "acados/utils/timing.h"
 
 // blasfeo
 #include "blasfeo/include/blasfeo_d_blas.h"
@@ -246,6 +250,9 @@ ocp_nlp_config *ocp_nlp_config_create(ocp_nlp_plan_t plan)
         case GERSHGORIN_LEVENBERG_MARQUARDT:
             ocp_nlp_reg_glm_config_initialize_default(config->regularize);
             break;
+        case INERTIA_CORRECTION:
+            ocp_nlp_reg_inertia_config_initialize_default(config->regularize);
+            break;
         default:
             printf("\nerror: ocp_nlp_config_create: unsupported plan->regularization\n");
             exit(1);
@@ -263,6 +270,9 @@ ocp_nlp_config *ocp_nlp_config_create(ocp_nlp_plan_t plan)
         case FUNNEL_L1PEN_LINESEARCH:
             ocp_nlp_globalization_funnel_config_initialize_default(config->globalization);
             break;
+        case TRUST_REGION:
+            ocp_nlp_globalization_trust_region_config_initialize_default(config->globalization);
+            break;
         default:
             printf("\nerror: ocp_nlp_config_create: unsupported plan->globalization\n");
             exit(1);
@@ -1376,10 +1386,15 @@ static ocp_nlp_solver *ocp_nlp_assign(ocp_nlp_config *config, ocp_nlp_dims *dims
 ocp_nlp_solver *ocp_nlp_solver_create(ocp_nlp_config *config, ocp_nlp_dims *dims, void *opts_, ocp_nlp_in *nlp_in)
 {
     config->opts_update(config, dims, opts_);
+    acados_timer_calibrate();
 
     acados_size_t bytes = ocp_nlp_calculate_size(config, dims, opts_, nlp_in);
 
-    void *ptr = acados_calloc(1, bytes);
+    ocp_nlp_opts *nlp_opts;
+    config->opts_get(config, opts_, "nlp_opts", &nlp_opts);
+
+    // memory and workspace are placed in one region, which is touched by the calling thread
+    void *ptr = acados_arena_alloc(bytes, nlp_opts->alloc_hugepages);
     assert(ptr != 0);
 
     ocp_nlp_solver *solver = ocp_nlp_assign(config, dims, opts_, nlp_in, ptr);
@@ -1391,7 +1406,30 @@ ocp_nlp_solver *ocp_nlp_solver_create(ocp_nlp_config *config, ocp_nlp_dims *dims
 void ocp_nlp_solver_destroy(ocp_nlp_solver *solver)
 {
     solver->config->terminate(solver->config, solver->mem, solver->work);
-    free(solver);
+    acados_arena_free(solver);
+}
+
+
+acados_size_t ocp_nlp_solver_memory_footprint(ocp_nlp_solver *solver, ocp_nlp_in *nlp_in, const char *module, int stage)
+{
+    ocp_nlp_config *config = solver->config;
+
+    if (!strcmp(module, "total"))
+    {
+        return ocp_nlp_calculate_size(config, solver->dims, solver->opts, nlp_in);
+    }
+    else if (!strcmp(module, "solver_memory"))
+    {
+        return config->memory_calculate_size(config, solver->dims, solver->opts, nlp_in);
+    }
+    else if (!strcmp(module, "solver_workspace"))
+    {
+        return config->workspace_calculate_size(config, solver->dims, solver->opts, nlp_in);
+    }
+
+    ocp_nlp_opts *nlp_opts;
+    config->opts_get(config, solver->opts, "nlp_opts", &nlp_opts);
+    return ocp_nlp_memory_footprint(config, solver->dims, nlp_opts, nlp_in, module, stage);
 }
 
 
@@ -1420,8 +1458,25 @@ void ocp_nlp_solver_reset_integrator_memory(ocp_nlp_solver *solver, ocp_nlp_in *
 
 int ocp_nlp_solve(ocp_nlp_solver *solver, ocp_nlp_in *nlp_in, ocp_nlp_out *nlp_out)
 {
-    return solver->config->evaluate(solver->config, solver->dims, nlp_in, nlp_out,
+    ocp_nlp_config *config = solver->config;
+    int status = config->evaluate(config, solver->dims, nlp_in, nlp_out,
                                     solver->opts, solver->mem, solver->work);
+
+    // NOTE: real-time algorithms record the latencies of their phases themselves
+    if (!config->is_real_time_algorithm())
+    {
+        ocp_nlp_memory *nlp_mem;
+        ocp_nlp_opts *nlp_opts;
+        config->get(config, solver->dims, solver->mem, "nlp_mem", &nlp_mem);
+        config->opts_get(config, solver->opts, "nlp_opts", &nlp_opts);
+        if (nlp_mem->latency_hist != NULL)
+        {
+            ocp_nlp_timings *timings = nlp_mem->nlp_timings;
+            ocp_nlp_latency_record(nlp_opts, nlp_mem, LATENCY_TIME_TOT, timings->time_tot);
+            ocp_nlp_latency_record(nlp_opts, nlp_mem, LATENCY_TIME_QP_SOLVER_CALL, timings->time_qp_solver_call);
+        }
+    }
+    return status;
 }
 
 
@@ -1448,6 +1503,22 @@ void ocp_nlp_eval_param_sens(ocp_nlp_solver *solver, char *field, int stage, int
     return;
 }
 
+void ocp_nlp_eval_param_sens_block(ocp_nlp_solver *solver, char *field, int stage, int index, int n_dir,
+                                   double *sens, int ld_sens)
+{
+    ocp_nlp_config *config = solver->config;
+    ocp_nlp_memory *nlp_mem;
+    ocp_nlp_opts *nlp_opts;
+    ocp_nlp_workspace *nlp_work;
+
+    config->get(config, solver->dims, solver->mem, "nlp_mem", &nlp_mem);
+    config->opts_get(config, solver->opts, "nlp_opts", &nlp_opts);
+    config->work_get(config, solver->dims, solver->work, "nlp_work", &nlp_work);
+
+    ocp_nlp_common_eval_param_sens_block(config, solver->dims, nlp_opts, nlp_mem, nlp_work,
+                                         field, stage, index, n_dir, sens, ld_sens);
+}
+
 void ocp_nlp_eval_lagrange_grad_p(ocp_nlp_solver *solver, ocp_nlp_in *nlp_in, const char *field, double *out)
 {
     solver->config->eval_lagr_grad_p(solver->config, solver->dims, nlp_in, solver->opts, solver->mem, solver->work, field, out);
@@ -1514,6 +1585,23 @@ void ocp_nlp_eval_solution_sens_adj_p(ocp_nlp_solver *solver, ocp_nlp_in *nlp_in
 }
 
 
+void ocp_nlp_eval_solution_sens_adj_p_block(ocp_nlp_solver *solver, ocp_nlp_in *nlp_in, const char *field,
+                                            int n_dir, double *seed, int ld_seed, double *out, int ld_out)
+{
+    ocp_nlp_config *config = solver->config;
+    ocp_nlp_memory *nlp_mem;
+    ocp_nlp_opts *nlp_opts;
+    ocp_nlp_workspace *nlp_work;
+
+    config->get(config, solver->dims, solver->mem, "nlp_mem", &nlp_mem);
+    config->opts_get(config, solver->opts, "nlp_opts", &nlp_opts);
+    config->work_get(config, solver->dims, solver->work, "nlp_work", &nlp_work);
+
+    ocp_nlp_common_eval_solution_sens_adj_p_block(config, solver->dims, nlp_in, nlp_opts, nlp_mem, nlp_work,
+                                                  field, n_dir, seed, ld_seed, out, ld_out);
+}
+
+
 void ocp_nlp_get(ocp_nlp_solver *solver, const char *field, void *return_value_)
 {
     solver->config->get(solver->config, solver->dims, solver->mem, field, return_value_);
@@ -2371,4 +2459,116 @@ void ocp_nlp_dump_last_qp_to_json(ocp_nlp_config *config, ocp_nlp_dims *dims, oc
     fprintf(fp, "\n}\n");
     fclose(fp);
     free(buffer);
-}
\ No newline at end of file
+}
+
+
+int ocp_nlp_write_profile(ocp_nlp_solver *solver, const char *filename, const char *format)
+{
+    ocp_nlp_config *config = solver->config;
+    ocp_nlp_memory *nlp_mem;
+    config->get(config, solver->dims, solver->mem, "nlp_mem", &nlp_mem);
+
+    return ocp_nlp_profiler_write(nlp_mem, filename, format);
+}
+
+
+
+void ocp_nlp_reset_latency(ocp_nlp_solver *solver)
+{
+    ocp_nlp_config *config = solver->config;
+    ocp_nlp_memory *nlp_mem;
+    config->get(config, solver->dims, solver->mem, "nlp_mem", &nlp_mem);
+
+    ocp_nlp_latency_reset(nlp_mem);
+}
+
+
+
+acados_size_t ocp_nlp_solver_snapshot_size(ocp_nlp_solver *solver, ocp_nlp_out *nlp_out)
+{
+    ocp_nlp_config *config = solver->config;
+    ocp_nlp_memory *nlp_mem;
+    config->get(config, solver->dims, solver->mem, "nlp_mem", &nlp_mem);
+
+    return ocp_nlp_snapshot_calculate_size(config, solver->dims, nlp_out, nlp_mem);
+}
+
+
+
+acados_size_t ocp_nlp_solver_snapshot_write(ocp_nlp_solver *solver, ocp_nlp_out *nlp_out, void *buffer, acados_size_t buffer_size)
+{
+    ocp_nlp_config *config = solver->config;
+    ocp_nlp_memory *nlp_mem;
+    config->get(config, solver->dims, solver->mem, "nlp_mem", &nlp_mem);
+
+    return ocp_nlp_snapshot_write(config, solver->dims, nlp_out, nlp_mem, buffer, buffer_size);
+}
+
+
+
+static void ocp_nlp_solver_snapshot_resume(ocp_nlp_solver *solver)
+{
+    ocp_nlp_config *config = solver->config;
+    ocp_nlp_dims *dims = solver->dims;
+
+    if (!config->is_real_time_algorithm())
+        return;
+
+    ocp_nlp_memory *nlp_mem;
+    config->get(config, dims, solver->mem, "nlp_mem", &nlp_mem);
+    ocp_nlp_opts *nlp_opts;
+    config->opts_get(config, solver->opts, "nlp_opts", &nlp_opts);
+    ocp_nlp_workspace *nlp_work;
+    config->work_get(config, dims, solver->work, "nlp_work", &nlp_work);
+
+    // the solver is warm, QP warm starts continue as after any other call
+    bool *is_first_call;
+    config->get(config, dims, solver->mem, "is_first_call", &is_first_call);
+    *is_first_call = false;
+
+    // the condensed QP lives in the QP solver memory, rebuild it from the restored QP
+    config->qp_solver->condense_lhs(config->qp_solver, dims->qp_solver,
+        nlp_mem->qp_in, nlp_mem->qp_out, nlp_opts->qp_solver_opts,
+        nlp_mem->qp_solver_mem, nlp_work->qp_work);
+}
+
+
+
+int ocp_nlp_solver_snapshot_read(ocp_nlp_solver *solver, ocp_nlp_out *nlp_out, const void *buffer, acados_size_t buffer_size)
+{
+    ocp_nlp_config *config = solver->config;
+    ocp_nlp_memory *nlp_mem;
+    config->get(config, solver->dims, solver->mem, "nlp_mem", &nlp_mem);
+
+    int status = ocp_nlp_snapshot_read(config, solver->dims, nlp_out, nlp_mem, buffer, buffer_size);
+    if (status == ACADOS_SUCCESS)
+        ocp_nlp_solver_snapshot_resume(solver);
+
+    return status;
+}
+
+
+
+int ocp_nlp_solver_snapshot_save(ocp_nlp_solver *solver, ocp_nlp_out *nlp_out, const char *filename)
+{
+    ocp_nlp_config *config = solver->config;
+    ocp_nlp_memory *nlp_mem;
+    config->get(config, solver->dims, solver->mem, "nlp_mem", &nlp_mem);
+
+    return ocp_nlp_snapshot_save(config, solver->dims, nlp_out, nlp_mem, filename);
+}
+
+
+
+int ocp_nlp_solver_snapshot_load(ocp_nlp_solver *solver, ocp_nlp_out *nlp_out, const char *filename)
+{
+    ocp_nlp_config *config = solver->config;
+    ocp_nlp_memory *nlp_mem;
+    config->get(config, solver->dims, solver->mem, "nlp_mem", &nlp_mem);
+
+    int status = ocp_nlp_snapshot_load(config, solver->dims, nlp_out, nlp_mem, filename);
+    if (status == ACADOS_SUCCESS)
+        ocp_nlp_solver_snapshot_resume(solver);
+
+    return status;
+}
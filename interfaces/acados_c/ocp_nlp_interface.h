@@ -93,6 +93,7 @@ typedef enum
     PROJECT_REDUC_HESS,
     CONVEXIFY,
     GERSHGORIN_LEVENBERG_MARQUARDT,
+    INERTIA_CORRECTION,
     INVALID_REGULARIZE,
 } ocp_nlp_reg_t;
 
@@ -102,7 +103,8 @@ typedef enum
 {
     FIXED_STEP,
     MERIT_BACKTRACKING,
-    FUNNEL_L1PEN_LINESEARCH
+    FUNNEL_L1PEN_LINESEARCH,
+    TRUST_REGION
 } ocp_nlp_globalization_t;
 
 /// Structure to store the configuration of a non-linear program
@@ -450,12 +452,21 @@ ACADOS_SYMBOL_EXPORT void ocp_nlp_eval_residuals(ocp_nlp_solver *solver, ocp_nlp
 //
 ACADOS_SYMBOL_EXPORT void ocp_nlp_eval_param_sens(ocp_nlp_solver *solver, char *field, int stage, int index, ocp_nlp_out *sens_nlp_out);
 
+// Computes the solution sensitivities in the directions index, ..., index+n_dir-1 with one factorization;
+// column k of sens (leading dimension ld_sens) holds [ux; pi; lam] of all stages, stage after stage.
+ACADOS_SYMBOL_EXPORT void ocp_nlp_eval_param_sens_block(ocp_nlp_solver *solver, char *field, int stage, int index, int n_dir, double *sens, int ld_sens);
+
 // Computes the gradient of the Lagrange function wrt parameters
 ACADOS_SYMBOL_EXPORT void ocp_nlp_eval_lagrange_grad_p(ocp_nlp_solver *solver, ocp_nlp_in *nlp_in, const char *field, double *out);
 
 
 ACADOS_SYMBOL_EXPORT void ocp_nlp_eval_solution_sens_adj_p(ocp_nlp_solver *solver, ocp_nlp_in *nlp_in, ocp_nlp_out *sens_nlp_out, const char *field, int stage, double *out);
 
+// Computes the adjoint solution sensitivities for n_dir seeds with one factorization;
+// column k of seed holds the seed for ux of all stages, column k of out the corresponding gradient.
+ACADOS_SYMBOL_EXPORT void ocp_nlp_eval_solution_sens_adj_p_block(ocp_nlp_solver *solver, ocp_nlp_in *nlp_in, const char *field,
+                                            int n_dir, double *seed, int ld_seed, double *out, int ld_out);
+
 /* get */
 /// \param solver The solver struct.
 /// \param field Supports "sqp_iter", "status", "nlp_res", "time_tot", ...
@@ -471,6 +482,58 @@ ACADOS_SYMBOL_EXPORT void ocp_nlp_get(ocp_nlp_solver *solver, const char *field,
 /// \param value The initial guess for the algebraic variables in the integrator (if continuous model is used).
 ACADOS_SYMBOL_EXPORT void ocp_nlp_set(ocp_nlp_solver *solver, int stage, const char *field, void *value);
 
+/* memory footprint */
+/// Returns the number of bytes required by the solver or one of its submodules.
+///
+/// \param solver The ocp_nlp_solver struct.
+/// \param nlp_in The inputs struct the solver was created with.
+/// \param module "total" (whole solver allocation), "solver_memory", "solver_workspace",
+///     "memory", "workspace" (common NLP parts), "qp_solver", "regularize", "globalization",
+///     "qpscaling", "iterates", or "dynamics", "cost", "constraints" at the given stage;
+///     submodule sizes include their workspace, which may be shared, see reuse_workspace.
+/// \param stage Stage index, only used for dynamics, cost and constraints.
+ACADOS_SYMBOL_EXPORT acados_size_t ocp_nlp_solver_memory_footprint(ocp_nlp_solver *solver, ocp_nlp_in *nlp_in, const char *module, int stage);
+
+/* profiler */
+/// Writes the events kept by the profiler, requires profiler_buffer_size > 0.
+///
+/// \param solver The ocp_nlp_solver struct.
+/// \param filename Name of the output file.
+/// \param format "json" (Chrome trace event format) or "binary".
+ACADOS_SYMBOL_EXPORT int ocp_nlp_write_profile(ocp_nlp_solver *solver, const char *filename, const char *format);
+
+/// Clears the latency histograms accumulated with the option log_latency.
+///
+/// \param solver The ocp_nlp_solver struct.
+ACADOS_SYMBOL_EXPORT void ocp_nlp_reset_latency(ocp_nlp_solver *solver);
+
+/* snapshot */
+/// Returns the number of bytes of a snapshot of the warm solver state.
+ACADOS_SYMBOL_EXPORT acados_size_t ocp_nlp_solver_snapshot_size(ocp_nlp_solver *solver, ocp_nlp_out *nlp_out);
+
+/// Writes the warm solver state, i.e. the iterate, the last QP and its solution, the linearization
+/// and the globalization and Levenberg-Marquardt state, into a versioned binary buffer.
+///
+/// \param solver The ocp_nlp_solver struct.
+/// \param nlp_out The current iterate.
+/// \param buffer Output buffer of at least ocp_nlp_solver_snapshot_size bytes, 8-byte aligned.
+/// \param buffer_size Size of the buffer.
+/// \return Number of bytes written, 0 if the buffer is too small.
+ACADOS_SYMBOL_EXPORT acados_size_t ocp_nlp_solver_snapshot_write(ocp_nlp_solver *solver, ocp_nlp_out *nlp_out, void *buffer, acados_size_t buffer_size);
+
+/// Restores the warm solver state from a snapshot of a solver with the same dimensions and modules.
+/// The buffer can point into a mapped file. For SQP_RTI the condensing of the restored QP is redone,
+/// such that the next call can be a feedback phase.
+///
+/// \return ACADOS_SUCCESS, or ACADOS_UNKNOWN if the snapshot does not match the solver.
+ACADOS_SYMBOL_EXPORT int ocp_nlp_solver_snapshot_read(ocp_nlp_solver *solver, ocp_nlp_out *nlp_out, const void *buffer, acados_size_t buffer_size);
+
+/// Writes a snapshot of the warm solver state to a file.
+ACADOS_SYMBOL_EXPORT int ocp_nlp_solver_snapshot_save(ocp_nlp_solver *solver, ocp_nlp_out *nlp_out, const char *filename);
+
+/// Restores the warm solver state from a file written by ocp_nlp_solver_snapshot_save.
+ACADOS_SYMBOL_EXPORT int ocp_nlp_solver_snapshot_load(ocp_nlp_solver *solver, ocp_nlp_out *nlp_out, const char *filename);
+
 
 
 #ifdef __cplusplus
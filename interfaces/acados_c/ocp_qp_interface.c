@@ -43,6 +43,7 @@
 // acados
 #include "acados/utils/mem.h"
 #include "acados/utils/print.h"
+#include "acados/utils/timing.h"
 
 
 #include "acados/dense_qp/dense_qp_hpipm.h"
@@ -552,6 +553,7 @@ ocp_qp_solver *ocp_qp_create(ocp_qp_xcond_solver_config *config,
 {
 
     config->opts_update(config, dims, opts_);
+    acados_timer_calibrate();
 
     acados_size_t bytes = ocp_qp_calculate_size(config, dims, opts_);
 
@@ -43,6 +43,7 @@
 #include <string.h>
 
 #include "acados/utils/mem.h"
+#include "acados/utils/timing.h"
 
 
 
@@ -364,6 +365,7 @@ sim_solver *sim_solver_create(sim_config *config, void *dims, void *opts_, sim_i
 {
     // update Butcher tableau (needed if the user changed ns)
     config->opts_update(config, dims, opts_);
+    acados_timer_calibrate();
     acados_size_t bytes = sim_calculate_size(config, dims, opts_, in);
 
     void *ptr = calloc(1, bytes);
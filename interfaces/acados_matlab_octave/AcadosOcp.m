@@ -1188,7 +1188,7 @@ classdef AcadosOcp < handle
                 error(['Invalid qp_solver: ', opts.qp_solver, '. Available options are: ', strjoin(qp_solvers, ', ')]);
             end
 
-            regularize_methods = {'NO_REGULARIZE', 'MIRROR', 'PROJECT', 'PROJECT_REDUC_HESS', 'CONVEXIFY', 'GERSHGORIN_LEVENBERG_MARQUARDT'};
+            regularize_methods = {'NO_REGULARIZE', 'MIRROR', 'PROJECT', 'PROJECT_REDUC_HESS', 'CONVEXIFY', 'GERSHGORIN_LEVENBERG_MARQUARDT', 'INERTIA_CORRECTION'};
             if ~ismember(opts.regularize_method, regularize_methods)
                 error(['Invalid regularize_method: ', opts.regularize_method, '. Available options are: ', strjoin(regularize_methods, ', ')]);
             end
@@ -1216,6 +1216,11 @@ classdef AcadosOcp < handle
                 error(['Invalid search_direction_mode: ', opts.search_direction_mode, '. Available options are: ', strjoin(search_direction_modes, ', ')]);
             end
 
+            ddp_defect_closing_types = {'GRADUAL', 'MERGE'};
+            if ~ismember(opts.ddp_defect_closing, ddp_defect_closing_types)
+                error(['Invalid ddp_defect_closing: ', opts.ddp_defect_closing, '. Available options are: ', strjoin(ddp_defect_closing_types, ', ')]);
+            end
+
             qpscaling_scale_constraints_types = {'INF_NORM', 'NO_CONSTRAINT_SCALING'};
             if ~ismember(opts.qpscaling_scale_constraints, qpscaling_scale_constraints_types)
                 error(['Invalid qpscaling_scale_constraints: ', opts.qpscaling_scale_constraints, '. Available options are: ', strjoin(qpscaling_scale_constraints_types, ', ')]);
@@ -1577,6 +1582,9 @@ classdef AcadosOcp < handle
             if strcmp(opts.globalization, 'FUNNEL_L1PEN_LINESEARCH') && ~strcmp(opts.nlp_solver_type, 'SQP')
                 error('FUNNEL_L1PEN_LINESEARCH only supports SQP.');
             end
+            if strcmp(opts.globalization, 'TRUST_REGION') && ~strcmp(opts.nlp_solver_type, 'SQP')
+                error('TRUST_REGION only supports SQP.');
+            end
 
             % termination
             if isempty(opts.nlp_solver_tol_min_step_norm)
@@ -1648,6 +1656,9 @@ classdef AcadosOcp < handle
             if length(opts.anderson_activation_threshold) ~= 1
                 error('anderson_activation_threshold must be a scalar.');
             end
+            if length(opts.anderson_depth) ~= 1 || opts.anderson_depth < 1
+                error('anderson_depth must be a positive integer.');
+            end
 
             % check terminal stage
             fields = {'cost_expr_ext_cost_e', 'cost_expr_ext_cost_custom_hess_e', ...
@@ -94,6 +94,7 @@ classdef AcadosOcpOptions < handle
         nlp_qp_tol_min_eq
         nlp_qp_tol_min_ineq
         nlp_qp_tol_min_comp
+        nlp_qp_tol_safeguard
         exact_hess_cost
         exact_hess_dyn
         exact_hess_constr
@@ -103,6 +104,7 @@ classdef AcadosOcpOptions < handle
         globalization_alpha_min
         globalization_alpha_reduction
         globalization_line_search_use_sufficient_descent
+        globalization_nonmonotone_window
         globalization_use_SOC
         globalization_full_step_dual
         globalization_eps_sufficient_descent
@@ -113,14 +115,21 @@ classdef AcadosOcpOptions < handle
         globalization_funnel_fraction_switching_condition
         globalization_funnel_initial_penalty_parameter
         globalization_funnel_use_merit_fun_only
+        globalization_trust_region_radius_init
+        globalization_trust_region_radius_max
+        globalization_trust_region_eta
 
         search_direction_mode
         byrd_omojokon_slack_relaxation_factor
         use_constraint_hessian_in_feas_qp
+        warm_start_nominal_qp_from_feasibility_qp
         allow_direction_mode_switch_to_nominal
         hpipm_mode
+        osqp_reuse_factorization
         solution_sens_qp_t_lam_min
         as_rti_iter
+        ddp_num_segments
+        ddp_defect_closing
         as_rti_level
         with_adaptive_levenberg_marquardt
         adaptive_levenberg_marquardt_lam
@@ -129,10 +138,16 @@ classdef AcadosOcpOptions < handle
         adaptive_levenberg_marquardt_obj_scalar
         log_primal_step_norm
         log_dual_step_norm
+        log_latency
+        latency_deadline
         store_iterates
+        profiler_buffer_size
+        alloc_hugepages
+        minimal_memory
         eval_residual_at_max_iter
         with_anderson_acceleration
         anderson_activation_threshold
+        anderson_depth
 
         timeout_max_time
         timeout_heuristic
@@ -217,6 +232,7 @@ classdef AcadosOcpOptions < handle
             obj.nlp_qp_tol_min_eq = 1e-10;
             obj.nlp_qp_tol_min_ineq = 1e-10;
             obj.nlp_qp_tol_min_comp = 1e-11;
+            obj.nlp_qp_tol_safeguard = false;
             obj.reg_epsilon = 1e-4;
             obj.reg_adaptive_eps = false;
             obj.reg_max_cond_block = 1e7;
@@ -231,6 +247,7 @@ classdef AcadosOcpOptions < handle
             obj.globalization_alpha_min = [];
             obj.globalization_alpha_reduction = 0.7;
             obj.globalization_line_search_use_sufficient_descent = 0;
+            obj.globalization_nonmonotone_window = 1;
             obj.globalization_use_SOC = 0;
             obj.globalization_full_step_dual = [];
             obj.globalization_eps_sufficient_descent = [];
@@ -243,16 +260,23 @@ classdef AcadosOcpOptions < handle
             obj.globalization_funnel_fraction_switching_condition = 1e-3;
             obj.globalization_funnel_initial_penalty_parameter = 1.0;
             obj.globalization_funnel_use_merit_fun_only = false;
+            obj.globalization_trust_region_radius_init = 1.0;
+            obj.globalization_trust_region_radius_max = 1e4;
+            obj.globalization_trust_region_eta = 1e-4;
 
             % SQP_WITH_FEASIBLE_QP options
             obj.search_direction_mode = 'NOMINAL_QP';
             obj.byrd_omojokon_slack_relaxation_factor = 1.00001;
             obj.use_constraint_hessian_in_feas_qp = false;
+            obj.warm_start_nominal_qp_from_feasibility_qp = false;
             obj.allow_direction_mode_switch_to_nominal = true;
 
             obj.hpipm_mode = 'BALANCE';
+            obj.osqp_reuse_factorization = false;
             obj.solution_sens_qp_t_lam_min = 1e-9;
             obj.as_rti_iter = 1;
+            obj.ddp_num_segments = 1;
+            obj.ddp_defect_closing = 'GRADUAL';
             obj.as_rti_level = 4;
             obj.with_adaptive_levenberg_marquardt = 0;
             obj.adaptive_levenberg_marquardt_lam = 5.0;
@@ -261,10 +285,16 @@ classdef AcadosOcpOptions < handle
             obj.adaptive_levenberg_marquardt_obj_scalar = 2.0;
             obj.log_primal_step_norm = 0;
             obj.log_dual_step_norm = 0;
+            obj.log_latency = false;
+            obj.latency_deadline = 0.0;
             obj.store_iterates = false;
+            obj.profiler_buffer_size = 0;
+            obj.alloc_hugepages = false;
+            obj.minimal_memory = false;
             obj.eval_residual_at_max_iter = [];
             obj.with_anderson_acceleration = 0;
             obj.anderson_activation_threshold = 1e1;
+            obj.anderson_depth = 1;
             obj.timeout_max_time = 0.;
             obj.timeout_heuristic = 'ZERO';
 
@@ -1349,6 +1349,9 @@ class AcadosOcp:
         if opts.globalization == 'FUNNEL_L1PEN_LINESEARCH' and opts.nlp_solver_type not in ['SQP', 'SQP_WITH_FEASIBLE_QP']:
             raise NotImplementedError('FUNNEL_L1PEN_LINESEARCH only supports SQP.')
 
+        if opts.globalization == 'TRUST_REGION' and opts.nlp_solver_type != 'SQP':
+            raise NotImplementedError('TRUST_REGION only supports SQP.')
+
         # RTI checks
         if opts.nlp_solver_type == "SQP_RTI":
             if opts.nlp_qp_tol_strategy != "FIXED_QP_TOL":
@@ -106,6 +106,9 @@ class AcadosOcpBatchSolver():
         getattr(self.__shared_lib, f"{self.__name}_acados_batch_eval_solution_sens_adj_p").argtypes = [POINTER(c_void_p), c_char_p, c_int, POINTER(c_double), c_int, c_int, c_int]
         getattr(self.__shared_lib, f"{self.__name}_acados_batch_eval_solution_sens_adj_p").restype = c_void_p
 
+        getattr(self.__shared_lib, f"{self.__name}_acados_batch_eval_solution_sens_adj_p_block").argtypes = [POINTER(c_void_p), c_char_p, c_int, POINTER(c_double), c_int, POINTER(c_double), c_int, c_int, c_int]
+        getattr(self.__shared_lib, f"{self.__name}_acados_batch_eval_solution_sens_adj_p_block").restype = c_void_p
+
         getattr(self.__shared_lib, f"{self.__name}_acados_batch_set_flat").argtypes = [POINTER(c_void_p), c_char_p, POINTER(c_double), c_int, c_int, c_int]
         getattr(self.__shared_lib, f"{self.__name}_acados_batch_set_flat").restype = c_void_p
 
@@ -289,24 +292,21 @@ class AcadosOcpBatchSolver():
             t1 = time.time()
 
             grad_p = np.zeros((n_batch, n_seeds, np_global), order="C", dtype=np.float64)
-            offset = n_seeds*np_global
-
-            for i_seed in range(n_seeds):
-                # set seed:
-                self._reset_sens_out(n_batch)
-
-                # TODO this could be a batch_set
-                for m in range(n_batch):
-                    for (stage, sx) in seed_x:
-                        self.ocp_solvers[m].set(stage, 'sens_x', sx[m, :, i_seed])
-                    for (stage, su) in seed_u:
-                        self.ocp_solvers[m].set(stage, 'sens_u', su[m, :, i_seed])
-
-                c_grad_p = cast(grad_p[0, i_seed].ctypes.data, POINTER(c_double))
 
-                # solve adjoint sensitivities
-                getattr(self.__shared_lib, f"{self.__name}_acados_batch_eval_solution_sens_adj_p")(
-                    self.__ocp_solvers_pointer, field, 0, c_grad_p, offset, n_batch, self.__num_threads_in_batch_solve)
+            # seeds for ux of all stages, for all instances and seeds at once
+            offsets, _, n_ux = self.__ocp_solvers[0]._get_sens_offsets()
+            seed = np.zeros((n_batch, n_seeds, n_ux), order="C", dtype=np.float64)
+            for (stage, sx) in seed_x:
+                o = offsets[stage]['ux_adj'] + offsets[stage]['nu']
+                seed[:, :, o:o + offsets[stage]['nx']] = sx.transpose(0, 2, 1)
+            for (stage, su) in seed_u:
+                o = offsets[stage]['ux_adj']
+                seed[:, :, o:o + offsets[stage]['nu']] = su.transpose(0, 2, 1)
+
+            # solve adjoint sensitivities, parallel over the instances
+            getattr(self.__shared_lib, f"{self.__name}_acados_batch_eval_solution_sens_adj_p_block")(
+                self.__ocp_solvers_pointer, field, n_seeds, cast(seed.ctypes.data, POINTER(c_double)), n_ux,
+                cast(grad_p.ctypes.data, POINTER(c_double)), np_global, n_batch, self.__num_threads_in_batch_solve)
 
             self.time_solution_sens_solve = time.time() - t1
 
@@ -37,6 +37,8 @@ from .utils import check_if_nparray_and_flatten, use_int_or_cast_to_1d_nparray
 INTEGRATOR_TYPES = ('ERK', 'IRK', 'GNSF', 'DISCRETE', 'LIFTED_IRK')
 COLLOCATION_TYPES = ('GAUSS_RADAU_IIA', 'GAUSS_LEGENDRE', 'EXPLICIT_RUNGE_KUTTA')
 COST_DISCRETIZATION_TYPES = ('EULER', 'INTEGRATOR')
+# default eta_shrink of the C trust region globalization, upper bound for globalization_trust_region_eta
+TRUST_REGION_ETA_SHRINK = 0.25
 
 class AcadosOcpOptions:
     """
@@ -98,6 +100,7 @@ class AcadosOcpOptions:
         self.__exact_hess_constr = 1
         self.__eval_residual_at_max_iter = None
         self.__use_constraint_hessian_in_feas_qp = False
+        self.__warm_start_nominal_qp_from_feasibility_qp = False
         self.__byrd_omojokon_slack_relaxation_factor = 1.00001
         self.__search_direction_mode = 'NOMINAL_QP'
         self.__allow_direction_mode_switch_to_nominal = True
@@ -109,6 +112,9 @@ class AcadosOcpOptions:
         self.__globalization_funnel_fraction_switching_condition = 1e-3
         self.__globalization_funnel_initial_penalty_parameter = 1.0
         self.__globalization_funnel_use_merit_fun_only = False
+        self.__globalization_trust_region_radius_init = 1.0
+        self.__globalization_trust_region_radius_max = 1e4
+        self.__globalization_trust_region_eta = 1e-4
         self.__globalization_fixed_step_length = 1.0
         self.__qpscaling_ub_max_abs_eig = 1e5
         self.__qpscaling_lb_norm_inf_grad_obj = 1e-4
@@ -122,17 +128,22 @@ class AcadosOcpOptions:
         self.__nlp_qp_tol_min_eq = 1e-10
         self.__nlp_qp_tol_min_ineq = 1e-10
         self.__nlp_qp_tol_min_comp = 1e-11
+        self.__nlp_qp_tol_safeguard = False
 
         self.__ext_cost_num_hess = 0
         self.__globalization_use_SOC = 0
         self.__globalization_alpha_min = None
         self.__globalization_alpha_reduction = 0.7
         self.__globalization_line_search_use_sufficient_descent = 0
+        self.__globalization_nonmonotone_window = 1
         self.__globalization_full_step_dual = None
         self.__globalization_eps_sufficient_descent = None
         self.__hpipm_mode = 'BALANCE'
+        self.__osqp_reuse_factorization = False
         self.__as_rti_iter = 1
         self.__as_rti_level = 4
+        self.__ddp_num_segments = 1
+        self.__ddp_defect_closing = 'GRADUAL'
         self.__with_adaptive_levenberg_marquardt = False
         self.__adaptive_levenberg_marquardt_lam = 5.0
         self.__adaptive_levenberg_marquardt_mu_min = 1e-16
@@ -140,11 +151,17 @@ class AcadosOcpOptions:
         self.__adaptive_levenberg_marquardt_obj_scalar = 2.0
         self.__log_primal_step_norm: bool = False
         self.__log_dual_step_norm: bool = False
+        self.__log_latency: bool = False
+        self.__latency_deadline: float = 0.0
         self.__store_iterates: bool = False
+        self.__profiler_buffer_size: int = 0
+        self.__alloc_hugepages: bool = False
+        self.__minimal_memory: bool = False
         self.__timeout_max_time = 0.
         self.__timeout_heuristic = 'LAST'
         self.__with_anderson_acceleration: bool = False
         self.__anderson_activation_threshold: float = 1e1
+        self.__anderson_depth: int = 1
 
         self.__custom_update_copy = True
         self.__custom_templates = []
@@ -449,6 +466,27 @@ class AcadosOcpOptions:
                     + ',\n'.join(hpipm_modes) + '.\n\nYou have: ' + hpipm_mode + '.\n\n')
         self.__hpipm_mode = hpipm_mode
 
+    @property
+    def osqp_reuse_factorization(self):
+        """
+        If True, OSQP skips the factorization of the KKT matrix when the QP matrices P and A are unchanged
+        since the last factorization, e.g. for linear dynamics and constraints with a constant Hessian.
+        Otherwise, the KKT matrix is factorized in every QP solver call.
+        The number of factorizations can be obtained via `get_stats('qp_num_refactorizations')`.
+        Only used with OSQP.
+
+        Type: bool.
+        Default: False.
+        """
+        return self.__osqp_reuse_factorization
+
+    @osqp_reuse_factorization.setter
+    def osqp_reuse_factorization(self, osqp_reuse_factorization):
+        if isinstance(osqp_reuse_factorization, bool):
+            self.__osqp_reuse_factorization = osqp_reuse_factorization
+        else:
+            raise TypeError('Invalid osqp_reuse_factorization value, expected bool.\n')
+
     @property
     def hessian_approx(self):
         """Hessian approximation.
@@ -503,7 +541,7 @@ class AcadosOcpOptions:
     @property
     def globalization(self):
         """Globalization type.
-        String in ('FIXED_STEP', 'MERIT_BACKTRACKING', 'FUNNEL_L1PEN_LINESEARCH').
+        String in ('FIXED_STEP', 'MERIT_BACKTRACKING', 'FUNNEL_L1PEN_LINESEARCH', 'TRUST_REGION').
         Default: 'FIXED_STEP'.
 
         - FIXED_STEP: performs steps with a given step length, see option globalization_fixed_step_length
@@ -511,12 +549,15 @@ class AcadosOcpOptions:
         - FUNNEL_L1PEN_LINESEARCH: following "A Unified Funnel Restoration SQP Algorithm" by Kiessling et al.
             https://arxiv.org/pdf/2409.09208
             NOTE: preliminary implementation
+        - TRUST_REGION: trust region on the inf-norm of the primal step with ratio based radius updates on the l1 merit function.
+            The radius is imposed on the QP control bounds and the QP step is truncated to it, rejected steps only shrink the radius.
+            See options globalization_trust_region_*.
         """
         return self.__globalization
 
     @globalization.setter
     def globalization(self, globalization):
-        globalization_types = ('FUNNEL_L1PEN_LINESEARCH', 'MERIT_BACKTRACKING', 'FIXED_STEP')
+        globalization_types = ('FUNNEL_L1PEN_LINESEARCH', 'MERIT_BACKTRACKING', 'FIXED_STEP', 'TRUST_REGION')
         if globalization in globalization_types:
             self.__globalization = globalization
         else:
@@ -550,13 +591,14 @@ class AcadosOcpOptions:
     @property
     def regularize_method(self):
         """Regularization method for the Hessian.
-        String in ('NO_REGULARIZE', 'MIRROR', 'PROJECT', 'PROJECT_REDUC_HESS', 'CONVEXIFY', 'GERSHGORIN_LEVENBERG_MARQUARDT').
+        String in ('NO_REGULARIZE', 'MIRROR', 'PROJECT', 'PROJECT_REDUC_HESS', 'CONVEXIFY', 'GERSHGORIN_LEVENBERG_MARQUARDT', 'INERTIA_CORRECTION').
 
         - MIRROR: performs eigenvalue decomposition H = V^T D V and sets D_ii = max(eps, abs(D_ii))
         - PROJECT: performs eigenvalue decomposition H = V^T D V and sets D_ii = max(eps, D_ii)
         - CONVEXIFY: Algorithm 6 from Verschueren2017, https://cdn.syscop.de/publications/Verschueren2017.pdf, experimental, might not be correct if inequality constraints are active.
         - PROJECT_REDUC_HESS: experimental, should make sure that the reduced Hessian is positive definite. Has to be used with qp_solver_ric_alg = 0 and qp_solver_cond_ric_alg = 0
         - GERSHGORIN_LEVENBERG_MARQUARDT: estimates the smallest eigenvalue of each Hessian block using Gershgorin circles and adds multiple of identity to each block, such that smallest eigenvalue after regularization is at least reg_epsilon
+        - INERTIA_CORRECTION: performs a backward Riccati factorization of the equality constrained QP and adds a multiple of identity to the R block of the stages where the factorization breaks down, starting from reg_epsilon and increasing it as in the inertia correction of IPOPT, experimental, inequality constraints are not taken into account
 
         Default: 'NO_REGULARIZE'.
         """
@@ -565,7 +607,7 @@ class AcadosOcpOptions:
     @regularize_method.setter
     def regularize_method(self, regularize_method):
         regularize_methods = ('NO_REGULARIZE', 'MIRROR', 'PROJECT', \
-                                'PROJECT_REDUC_HESS', 'CONVEXIFY', 'GERSHGORIN_LEVENBERG_MARQUARDT')
+                                'PROJECT_REDUC_HESS', 'CONVEXIFY', 'GERSHGORIN_LEVENBERG_MARQUARDT', 'INERTIA_CORRECTION')
         if regularize_method in regularize_methods:
             self.__regularize_method = regularize_method
         else:
@@ -789,6 +831,27 @@ class AcadosOcpOptions:
         else:
             raise ValueError('Invalid nlp_qp_tol_min_comp value. nlp_qp_tol_min_comp must be a positive float.')
 
+    @property
+    def nlp_qp_tol_safeguard(self):
+        """
+        Safeguard for the inexact QP solves of the ADAPTIVE_CURRENT_RES_JOINT strategy.
+        If the current iterate is feasible w.r.t. ``nlp_solver_tol_eq`` and ``nlp_solver_tol_ineq``, but the QP step is not a descent direction for the objective,
+        the QP is solved again with the tolerances ``MAX(nlp_qp_tol_safety_factor * nlp_solver_tol_*, nlp_qp_tol_min_*)``.
+        The number of such re-solves in the last solver call is available via `get_stats('qp_num_resolves')`.
+        Off by default, since it changes the iterates and the number of QP solves of the adaptive strategy.
+
+        Type: bool.
+        Default: False.
+        """
+        return self.__nlp_qp_tol_safeguard
+
+    @nlp_qp_tol_safeguard.setter
+    def nlp_qp_tol_safeguard(self, nlp_qp_tol_safeguard):
+        if isinstance(nlp_qp_tol_safeguard, bool):
+            self.__nlp_qp_tol_safeguard = nlp_qp_tol_safeguard
+        else:
+            raise ValueError('Invalid nlp_qp_tol_safeguard value. nlp_qp_tol_safeguard must be a bool.')
+
     @property
     def nlp_solver_warm_start_first_qp(self):
         """
@@ -1216,11 +1279,54 @@ class AcadosOcpOptions:
         else:
             raise ValueError('Invalid as_rti_iter value. as_rti_iter must be a nonnegative int.')
 
+    @property
+    def ddp_num_segments(self):
+        """
+        Number of shooting segments of the DDP forward rollout.
+        The segments are rolled out in parallel, each one starting from the linear prediction of the QP,
+        such that the defects between segments are closed at the rate of the step length and vanish at convergence.
+        With MERIT_BACKTRACKING, the defects enter the line search via an l1 merit function.
+        Values > 1 only pay off if acados is built with OpenMP and for long horizons.
+        See also `ddp_defect_closing`.
+        Type: int > 0
+        Default: 1, i.e. single shooting rollout.
+        """
+        return self.__ddp_num_segments
+
+    @ddp_num_segments.setter
+    def ddp_num_segments(self, ddp_num_segments):
+        if isinstance(ddp_num_segments, int) and ddp_num_segments > 0:
+            self.__ddp_num_segments = ddp_num_segments
+        else:
+            raise ValueError(f'Invalid ddp_num_segments value, expected int > 0, got {ddp_num_segments}.')
+
+    @property
+    def ddp_defect_closing(self):
+        """
+        Policy of closing the defects between the shooting segments of the DDP forward rollout, used if `ddp_num_segments` > 1.
+        String in ('GRADUAL', 'MERGE').
+        - GRADUAL: the segments are kept in all iterations.
+        - MERGE: the segments are merged to a single shooting rollout once the equality residual is below `tol_eq`.
+        Default: 'GRADUAL'.
+        """
+        return self.__ddp_defect_closing
+
+    @ddp_defect_closing.setter
+    def ddp_defect_closing(self, ddp_defect_closing):
+        ddp_defect_closing_types = ('GRADUAL', 'MERGE')
+        if isinstance(ddp_defect_closing, str):
+            if ddp_defect_closing in ddp_defect_closing_types:
+                self.__ddp_defect_closing = ddp_defect_closing
+            else:
+                raise ValueError('Invalid string for ddp_defect_closing. Possible values are ' + ', '.join(ddp_defect_closing_types) + f', got {ddp_defect_closing}')
+        else:
+            raise TypeError(f'Invalid datatype for ddp_defect_closing. Should be str, got {type(ddp_defect_closing)}')
+
     @property
     def with_anderson_acceleration(self):
         """
         Determines if algorithm uses Anderson accelerations.
-        Only depth one is supported.
+        The number of stored step differences is set by ``anderson_depth``.
         Anderson accelerations are performed whenever the infinity norm of the KKT residual is < ``anderson_activation_threshold``.
         Only supported for globalization == 'FIXED_STEP'.
 
@@ -1261,6 +1367,25 @@ class AcadosOcpOptions:
             raise TypeError('Invalid anderson_activation_threshold value, must be float.')
         self.__anderson_activation_threshold = anderson_activation_threshold
 
+    @property
+    def anderson_depth(self):
+        """
+        Depth of Anderson acceleration, i.e. number of previous step differences used in the least-squares problem.
+        Only relevant if with_anderson_acceleration == True.
+        The history is restarted whenever the KKT residual norm is larger than ``anderson_activation_threshold``.
+
+        Type: int > 0
+        Default: 1
+        """
+        return self.__anderson_depth
+
+    @anderson_depth.setter
+    def anderson_depth(self, anderson_depth):
+        if isinstance(anderson_depth, int) and anderson_depth > 0:
+            self.__anderson_depth = anderson_depth
+        else:
+            raise ValueError(f'Invalid anderson_depth value, expected int > 0, got {anderson_depth}.')
+
     @property
     def as_rti_level(self):
         """
@@ -1402,6 +1527,41 @@ class AcadosOcpOptions:
             raise TypeError('Invalid log_dual_step_norm value. Expected bool.')
         self.__log_dual_step_norm = val
 
+    @property
+    def log_latency(self):
+        """
+        Flag indicating whether histograms of the computation times `time_tot`, `time_feedback`, `time_preparation` and `time_qp_solver_call`
+        should be accumulated across solver calls.
+        The statistics can be obtained with `get_stats`, e.g. `get_stats('latency_time_tot')`, and cleared with `AcadosOcpSolver.reset_latency_stats()`.
+        `time_feedback` and `time_preparation` are only recorded for `SQP_RTI`, the other solvers have no separate phases.
+        Default: False
+        """
+        return self.__log_latency
+
+    @log_latency.setter
+    def log_latency(self, val):
+        if not isinstance(val, bool):
+            raise TypeError('Invalid log_latency value. Expected bool.')
+        self.__log_latency = val
+
+    @property
+    def latency_deadline(self):
+        """
+        Deadline in seconds for the latency statistics, total and feedback times above it are counted as deadline misses.
+        The preparation and QP solver times do not bound the time until the control is available and have no deadline.
+        If 0, deadline misses are not counted.
+        Only used if `log_latency` is True.
+        Type: float >= 0
+        Default: 0.0
+        """
+        return self.__latency_deadline
+
+    @latency_deadline.setter
+    def latency_deadline(self, val):
+        if not isinstance(val, (float, int)) or val < 0:
+            raise TypeError('Invalid latency_deadline value. Expected float >= 0.')
+        self.__latency_deadline = float(val)
+
     @property
     def store_iterates(self):
         """
@@ -1418,6 +1578,65 @@ class AcadosOcpOptions:
         else:
             raise TypeError('Invalid store_iterates value. Expected bool.')
 
+    @property
+    def alloc_hugepages(self):
+        """
+        Flag indicating whether the solver memory and workspace, which are allocated as one contiguous region, should be backed by huge pages.
+        Explicit huge pages are used if reserved, e.g. via `/proc/sys/vm/nr_hugepages`, otherwise transparent huge pages are requested.
+        Independent of this option, all pages are touched by the thread creating the solver, such that they are placed on its NUMA node;
+        for batch solvers on multi-socket machines, create each solver on the thread that runs it.
+        Only has an effect on Linux.
+        Default: False
+        """
+        return self.__alloc_hugepages
+
+    @alloc_hugepages.setter
+    def alloc_hugepages(self, val):
+        if isinstance(val, bool):
+            self.__alloc_hugepages = val
+        else:
+            raise TypeError('Invalid alloc_hugepages value. Expected bool.')
+
+    @property
+    def minimal_memory(self):
+        """
+        Flag indicating whether the solver should only allocate the buffers required by the selected options.
+        Currently, for SQP_WITH_FEASIBLE_QP the constraint Hessian is evaluated directly into the nominal QP
+        instead of a separate buffer per stage.
+        The memory requirement can be inspected with `AcadosOcpSolver.get_memory_footprint()`.
+        Default: False
+        """
+        return self.__minimal_memory
+
+    @minimal_memory.setter
+    def minimal_memory(self, val):
+        if isinstance(val, bool):
+            self.__minimal_memory = val
+        else:
+            raise TypeError('Invalid minimal_memory value. Expected bool.')
+
+    @property
+    def profiler_buffer_size(self):
+        """
+        Number of profiler events, i.e. timings of the dynamics, cost and constraint evaluations per stage,
+        the external function evaluations within the integrator per stage, aggregated into one `ext_function` event placed at the start of the dynamics event,
+        linearization, QP scaling, regularization, QP solve and globalization per iteration,
+        as well as preparation and feedback phases for `SQP_RTI`, which are kept in a ring buffer across solver calls.
+        The events can be written to a file with `AcadosOcpSolver.dump_profile()`.
+        If 0, profiling is disabled.
+        This is implemented for the solver types `SQP`, `SQP_RTI`, `DDP` and `SQP_WITH_FEASIBLE_QP`.
+        Type: int >= 0
+        Default: 0
+        """
+        return self.__profiler_buffer_size
+
+    @profiler_buffer_size.setter
+    def profiler_buffer_size(self, val):
+        if isinstance(val, int) and val >= 0:
+            self.__profiler_buffer_size = val
+        else:
+            raise TypeError('Invalid profiler_buffer_size value. Expected int >= 0.')
+
     @property
     def timeout_max_time(self):
         """
@@ -1584,7 +1803,8 @@ class AcadosOcpOptions:
 
     @property
     def reg_epsilon(self):
-        """Epsilon for regularization, used if regularize_method in ['PROJECT', 'MIRROR', 'CONVEXIFY', 'GERSHGORIN_LEVENBERG_MARQUARDT'].
+        """Epsilon for regularization, used if regularize_method in ['PROJECT', 'MIRROR', 'CONVEXIFY', 'GERSHGORIN_LEVENBERG_MARQUARDT', 'INERTIA_CORRECTION'].
+        For 'INERTIA_CORRECTION' it is the first trial shift.
 
         Type: float.
         Default: 1e-4.
@@ -1676,6 +1896,26 @@ class AcadosOcpOptions:
         else:
             raise ValueError(f'Invalid value for globalization_line_search_use_sufficient_descent. Possible values are 0, 1, got {globalization_line_search_use_sufficient_descent}')
 
+    @property
+    def globalization_nonmonotone_window(self):
+        """
+        Number of iterates over which the merit function reference value is taken in the nonmonotone line search, used with MERIT_BACKTRACKING,
+        for `SQP` and `DDP`; for `DDP`, the merit function is the cost, plus the weighted defects if the rollout has multiple segments.
+        A trial point is accepted if it gives sufficient descent with respect to the maximum merit value of the current and the last globalization_nonmonotone_window-1 iterates (Grippo, Lampariello, Lucidi 1986).
+        This accepts more full steps and reduces the number of rejected trial points.
+        For values > 1, the merit function weights are only increased where the multipliers exceed them, and the stored merit values are discarded whenever the weights change.
+        Type: int in [1, 16]; 1 gives the monotone line search;
+        default: 1.
+        """
+        return self.__globalization_nonmonotone_window
+
+    @globalization_nonmonotone_window.setter
+    def globalization_nonmonotone_window(self, globalization_nonmonotone_window):
+        if isinstance(globalization_nonmonotone_window, int) and 1 <= globalization_nonmonotone_window <= 16:
+            self.__globalization_nonmonotone_window = globalization_nonmonotone_window
+        else:
+            raise ValueError(f'Invalid value for globalization_nonmonotone_window, expected int in [1, 16], got {globalization_nonmonotone_window}')
+
     @property
     def globalization_eps_sufficient_descent(self):
         """
@@ -1862,6 +2102,24 @@ class AcadosOcpOptions:
         else:
             raise TypeError(f'Invalid datatype for use_constraint_hessian_in_feas_qp. Should be bool, got {type(use_constraint_hessian_in_feas_qp)}')
 
+    @property
+    def warm_start_nominal_qp_from_feasibility_qp(self):
+        """
+        If True, the nominal QP in the Byrd-Omojokun iterations of ``SQP_WITH_FEASIBLE_QP`` is warm started
+        with the primal solution of the feasibility QP, which is feasible for the nominal QP with the adjusted bounds.
+        The QP solver warm start level 1 is used for this QP, i.e. the multipliers are cold started.
+
+        Default: False
+        """
+        return self.__warm_start_nominal_qp_from_feasibility_qp
+
+    @warm_start_nominal_qp_from_feasibility_qp.setter
+    def warm_start_nominal_qp_from_feasibility_qp(self, warm_start_nominal_qp_from_feasibility_qp):
+        if isinstance(warm_start_nominal_qp_from_feasibility_qp, bool):
+            self.__warm_start_nominal_qp_from_feasibility_qp = warm_start_nominal_qp_from_feasibility_qp
+        else:
+            raise TypeError(f'Invalid datatype for warm_start_nominal_qp_from_feasibility_qp. Should be bool, got {type(warm_start_nominal_qp_from_feasibility_qp)}')
+
     @property
     def byrd_omojokon_slack_relaxation_factor(self):
         """
@@ -1961,6 +2219,59 @@ class AcadosOcpOptions:
         else:
             raise TypeError(f'Invalid type for globalization_funnel_use_merit_fun_only. Should be bool, got {globalization_funnel_use_merit_fun_only}')
 
+    @property
+    def globalization_trust_region_radius_init(self):
+        """
+        Initial trust region radius, bound on the inf-norm of the primal step, used with TRUST_REGION.
+
+        Type: float > 0
+        Default: 1.0
+        """
+        return self.__globalization_trust_region_radius_init
+
+    @globalization_trust_region_radius_init.setter
+    def globalization_trust_region_radius_init(self, globalization_trust_region_radius_init):
+        if isinstance(globalization_trust_region_radius_init, float) and globalization_trust_region_radius_init > 0.0:
+            self.__globalization_trust_region_radius_init = globalization_trust_region_radius_init
+        else:
+            raise ValueError(f'Invalid value for globalization_trust_region_radius_init. Should be float > 0, got {globalization_trust_region_radius_init}')
+
+    @property
+    def globalization_trust_region_radius_max(self):
+        """
+        Maximum trust region radius, used with TRUST_REGION.
+
+        Type: float > 0
+        Default: 1e4
+        """
+        return self.__globalization_trust_region_radius_max
+
+    @globalization_trust_region_radius_max.setter
+    def globalization_trust_region_radius_max(self, globalization_trust_region_radius_max):
+        if isinstance(globalization_trust_region_radius_max, float) and globalization_trust_region_radius_max > 0.0:
+            self.__globalization_trust_region_radius_max = globalization_trust_region_radius_max
+        else:
+            raise ValueError(f'Invalid value for globalization_trust_region_radius_max. Should be float > 0, got {globalization_trust_region_radius_max}')
+
+    @property
+    def globalization_trust_region_eta(self):
+        """
+        Minimum ratio of actual to predicted merit function reduction for a step to be accepted, used with TRUST_REGION.
+
+        Must be below the ratio at which the trust region radius is reduced, `eta_shrink` = 0.25 in acados.
+
+        Type: float in [0, 0.25)
+        Default: 1e-4
+        """
+        return self.__globalization_trust_region_eta
+
+    @globalization_trust_region_eta.setter
+    def globalization_trust_region_eta(self, globalization_trust_region_eta):
+        if isinstance(globalization_trust_region_eta, float) and 0.0 <= globalization_trust_region_eta < TRUST_REGION_ETA_SHRINK:
+            self.__globalization_trust_region_eta = globalization_trust_region_eta
+        else:
+            raise ValueError(f'Invalid value for globalization_trust_region_eta. Should be float in [0, {TRUST_REGION_ETA_SHRINK}), got {globalization_trust_region_eta}')
+
     @property
     def nlp_solver_tol_ineq(self):
         """NLP solver inequality tolerance"""
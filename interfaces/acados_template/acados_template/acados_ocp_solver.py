@@ -37,7 +37,7 @@ import time
 import warnings
 
 from ctypes import (POINTER, byref, c_char_p, c_double, c_int, c_bool,
-                    c_void_p, cast)
+                    c_void_p, c_size_t, cast)
 if os.name == 'nt':
     from ctypes import wintypes
     from ctypes import WinDLL as DllLoader
@@ -389,6 +389,12 @@ class AcadosOcpSolver:
         self.__acados_lib.ocp_nlp_eval_solution_sens_adj_p.argtypes = [c_void_p, c_void_p, c_void_p, c_char_p, c_int, c_void_p]
         self.__acados_lib.ocp_nlp_eval_solution_sens_adj_p.restype = None
 
+        self.__acados_lib.ocp_nlp_eval_param_sens_block.argtypes = [c_void_p, c_char_p, c_int, c_int, c_int, c_void_p, c_int]
+        self.__acados_lib.ocp_nlp_eval_param_sens_block.restype = None
+
+        self.__acados_lib.ocp_nlp_eval_solution_sens_adj_p_block.argtypes = [c_void_p, c_void_p, c_char_p, c_int, c_void_p, c_int, c_void_p, c_int]
+        self.__acados_lib.ocp_nlp_eval_solution_sens_adj_p_block.restype = None
+
         self.__acados_lib.ocp_nlp_solver_opts_set.argtypes = [c_void_p, c_void_p, c_char_p, c_void_p]
         self.__acados_lib.ocp_nlp_solver_opts_get.argtypes = [c_void_p, c_void_p, c_char_p, c_void_p]
         self.__acados_lib.ocp_nlp_get.argtypes = [c_void_p, c_char_p, c_void_p]
@@ -431,6 +437,20 @@ class AcadosOcpSolver:
         self.__acados_lib.ocp_nlp_dump_last_qp_to_json.argtypes = [c_void_p, c_void_p, c_void_p, c_char_p]
         self.__acados_lib.ocp_nlp_dump_last_qp_to_json.restype = None
 
+        self.__acados_lib.ocp_nlp_write_profile.argtypes = [c_void_p, c_char_p, c_char_p]
+        self.__acados_lib.ocp_nlp_write_profile.restype = c_int
+
+        self.__acados_lib.ocp_nlp_reset_latency.argtypes = [c_void_p]
+        self.__acados_lib.ocp_nlp_reset_latency.restype = None
+
+        self.__acados_lib.ocp_nlp_solver_memory_footprint.argtypes = [c_void_p, c_void_p, c_char_p, c_int]
+        self.__acados_lib.ocp_nlp_solver_memory_footprint.restype = c_size_t
+
+        self.__acados_lib.ocp_nlp_solver_snapshot_save.argtypes = [c_void_p, c_void_p, c_char_p]
+        self.__acados_lib.ocp_nlp_solver_snapshot_save.restype = c_int
+        self.__acados_lib.ocp_nlp_solver_snapshot_load.argtypes = [c_void_p, c_void_p, c_char_p]
+        self.__acados_lib.ocp_nlp_solver_snapshot_load.restype = c_int
+
         getattr(self.shared_lib, f"{self.name}_acados_solve").argtypes = [c_void_p]
         getattr(self.shared_lib, f"{self.name}_acados_solve").restype = c_int
 
@@ -873,6 +893,33 @@ class AcadosOcpSolver:
         self.ocp.ensure_solution_sensitivities_available(parametric=parametric, forward=forward)
 
 
+    def _get_sens_offsets(self):
+        """
+        Returns the offsets of the stage-wise fields in the columns used by the block sensitivity functions,
+        and the lengths of the forward and adjoint columns.
+        Forward sensitivities hold [ux; pi; lam] of all stages, with ux = [u; x; sl; su]; adjoint seeds hold ux of all stages.
+        """
+        offsets = []
+        offset = 0
+        offset_adj = 0
+        for s in range(self.N+1):
+            o = dict()
+            for name, attr in [('nu', 'u'), ('nx', 'x'), ('ns', 'sl'), ('nlam', 'lam')]:
+                o[name] = self.__acados_lib.ocp_nlp_dims_get_from_attr(self.nlp_config, self.nlp_dims, self.nlp_out, s, attr.encode('utf-8'))
+            o['npi'] = self.__acados_lib.ocp_nlp_dims_get_from_attr(self.nlp_config, self.nlp_dims, self.nlp_out, s, "pi".encode('utf-8')) if s < self.N else 0
+            nv = o['nu'] + o['nx'] + 2 * o['ns']
+            o['u'] = offset
+            o['x'] = offset + o['nu']
+            o['sl'] = o['x'] + o['nx']
+            o['su'] = o['sl'] + o['ns']
+            o['pi'] = offset + nv
+            o['lam'] = o['pi'] + o['npi']
+            o['ux_adj'] = offset_adj
+            offset = o['lam'] + o['nlam']
+            offset_adj += nv
+            offsets.append(o)
+        return offsets, offset, offset_adj
+
     def eval_solution_sensitivity(self,
                                   stages: Union[int, List[int]],
                                   with_respect_to: str,
@@ -953,59 +1000,29 @@ class AcadosOcpSolver:
         else:
             raise ValueError(f"AcadosOcpSolver.eval_solution_sensitivity(): Unknown field: with_respect_to = {with_respect_to}")
 
-        # initialize jacobians with zeros
-        for s in stages_:
+        # all directions with one factorization, row k holds [ux; pi; lam] of all stages for direction k
+        offsets, n_sens, _ = self._get_sens_offsets()
+        sens = np.zeros((ngrad, n_sens), order='C', dtype=np.float64)
+        self.__acados_lib.ocp_nlp_eval_param_sens_block(self.nlp_solver, field.encode('utf-8'), 0, 0, ngrad,
+                                                        cast(sens.ctypes.data, POINTER(c_double)), n_sens)
+        self.time_solution_sens_solve = self.get_stats("time_solution_sensitivities")
 
+        for s in stages_:
+            o = offsets[s]
             if return_sens_x:
-                nx = self.__acados_lib.ocp_nlp_dims_get_from_attr(self.nlp_config, self.nlp_dims, self.nlp_out, s, "x".encode('utf-8'))
-                sens_x.append(np.zeros((nx, ngrad)))
-
+                sens_x.append(sens[:, o['x']:o['x']+o['nx']].T.copy())
             if return_sens_lam:
-                nlam = self.__acados_lib.ocp_nlp_dims_get_from_attr(self.nlp_config, self.nlp_dims, self.nlp_out, s, "lam".encode('utf-8'))
-                sens_lam.append(np.zeros((nlam, ngrad)))
-
+                sens_lam.append(sens[:, o['lam']:o['lam']+o['nlam']].T.copy())
             if return_sens_sl:
-                ns = self.__acados_lib.ocp_nlp_dims_get_from_attr(self.nlp_config, self.nlp_dims, self.nlp_out, s, "s".encode('utf-8'))
-                sens_sl.append(np.zeros((ns, ngrad)))
-
+                sens_sl.append(sens[:, o['sl']:o['sl']+o['ns']].T.copy())
             if return_sens_su:
-                ns = self.__acados_lib.ocp_nlp_dims_get_from_attr(self.nlp_config, self.nlp_dims, self.nlp_out, s, "s".encode('utf-8'))
-                sens_su.append(np.zeros((ns, ngrad)))
+                sens_su.append(sens[:, o['su']:o['su']+o['ns']].T.copy())
 
             if s < self.N:
                 if return_sens_u:
-                    nu = self.__acados_lib.ocp_nlp_dims_get_from_attr(self.nlp_config, self.nlp_dims, self.nlp_out, s, "u".encode('utf-8'))
-                    sens_u.append(np.zeros((nu, ngrad)))
-
+                    sens_u.append(sens[:, o['u']:o['u']+o['nu']].T.copy())
                 if return_sens_pi:
-                    npi = self.__acados_lib.ocp_nlp_dims_get_from_attr(self.nlp_config, self.nlp_dims, self.nlp_out, s, "pi".encode('utf-8'))
-                    sens_pi.append(np.zeros((npi, ngrad)))
-
-        self.time_solution_sens_solve = 0.0
-        for k in range(ngrad):
-            # evaluate sensitivity
-            self.__acados_lib.ocp_nlp_eval_param_sens(self.nlp_solver, field.encode('utf-8'), 0, k, self.sens_out)
-
-            # get timing
-            self.time_solution_sens_solve += self.get_stats("time_solution_sensitivities")
-
-            # extract sensitivities
-            for n, s in enumerate(stages_):
-
-                if return_sens_x:
-                    sens_x[n][:, k] = self.get(s, "sens_x")
-                if return_sens_lam:
-                    sens_lam[n][:, k] = self.get(s, "sens_lam")
-                if return_sens_sl:
-                    sens_sl[n][:, k] = self.get(s, "sens_sl")
-                if return_sens_su:
-                    sens_su[n][:, k] = self.get(s, "sens_su")
-
-                if s < self.N:
-                    if return_sens_u:
-                        sens_u[n][:, k] = self.get(s, "sens_u")
-                    if return_sens_pi:
-                        sens_pi[n][:, k] = self.get(s, "sens_pi")
+                    sens_pi.append(sens[:, o['pi']:o['pi']+o['npi']].T.copy())
 
         out = {}
 
@@ -1101,20 +1118,20 @@ class AcadosOcpSolver:
             # NOTE: linearization and solve are done together, full timing is reported as time_solution_sens_solve
             self.time_solution_sens_lin = 0.0
 
-            self.time_solution_sens_solve = 0.0
-            for i_seed in range(n_seeds):
-                # set seed:
-                self.reset_sens_out()
-                for (stage, sx) in seed_x:
-                    self.set(stage, 'sens_x', sx[:, i_seed])
-                for (stage, su) in seed_u:
-                    self.set(stage, 'sens_u', su[:, i_seed])
-
-                c_grad_p = cast(grad_p[i_seed, :].ctypes.data, POINTER(c_double))
-
-                # solve adjoint sensitivities
-                self.__acados_lib.ocp_nlp_eval_solution_sens_adj_p(self.nlp_solver, self.nlp_in, self.sens_out, field, 0, c_grad_p)
-                self.time_solution_sens_solve += self.get_stats("time_solution_sensitivities")
+            # all seeds with one factorization, row k holds the seed for ux of all stages
+            offsets, _, n_ux = self._get_sens_offsets()
+            seed = np.zeros((n_seeds, n_ux), order='C', dtype=np.float64)
+            for (stage, sx) in seed_x:
+                o = offsets[stage]['ux_adj']
+                seed[:, o + offsets[stage]['nu']:o + offsets[stage]['nu'] + offsets[stage]['nx']] = sx.T
+            for (stage, su) in seed_u:
+                o = offsets[stage]['ux_adj']
+                seed[:, o:o + offsets[stage]['nu']] = su.T
+
+            self.__acados_lib.ocp_nlp_eval_solution_sens_adj_p_block(self.nlp_solver, self.nlp_in, field, n_seeds,
+                                            cast(seed.ctypes.data, POINTER(c_double)), n_ux,
+                                            cast(grad_p.ctypes.data, POINTER(c_double)), nparam)
+            self.time_solution_sens_solve = self.get_stats("time_solution_sensitivities")
 
             return grad_p
         else:
@@ -1547,6 +1564,84 @@ class AcadosOcpSolver:
         else:
             raise ValueError("backend should be string with value 'Python' or 'C'")
 
+    def dump_profile(self, filename: str = '', format: str = 'json'):
+        """
+        Dumps the events kept by the profiler into a file, requires `solver_options.profiler_buffer_size > 0`.
+
+        :param filename: if not set, use name + '_profile.json' or name + '_profile.bin'
+        :param format: string in ['json', 'binary'], 'json' uses the Chrome trace event format, which can be opened in Perfetto,
+            'binary' writes "ACPROF", int32 version, int32 number of events, followed by the events as
+            float64 t_start, float64 t_end, int32 category, int32 stage, int32 iter, int32 solve, all little endian.
+        """
+        if format not in ['json', 'binary']:
+            raise ValueError("format should be string with value 'json' or 'binary'")
+        if self.ocp.solver_options.profiler_buffer_size == 0:
+            raise ValueError("dump_profile: the solver option profiler_buffer_size needs to be positive.")
+
+        if filename == '':
+            filename = f'{self.name}_profile.' + ('json' if format == 'json' else 'bin')
+
+        status = self.__acados_lib.ocp_nlp_write_profile(self.nlp_solver, filename.encode('utf-8'), format.encode('utf-8'))
+        if status != 0:
+            raise RuntimeError(f"dump_profile: failed to write {filename}.")
+
+    def reset_latency_stats(self):
+        """
+        Clears the latency statistics accumulated across solver calls, requires `solver_options.log_latency`,
+        e.g. to exclude the first calls or to evaluate a new operating condition.
+        """
+        if not self.ocp.solver_options.log_latency:
+            raise ValueError("reset_latency_stats: the solver option log_latency needs to be True.")
+        self.__acados_lib.ocp_nlp_reset_latency(self.nlp_solver)
+
+    def save_snapshot(self, filename: str = ''):
+        """
+        Saves the warm solver state into a compact binary file, which can be restored with `load_snapshot()`
+        by a solver created from the same OCP, e.g. in a restarted process or on a standby controller.
+        The snapshot contains the iterate, the last QP and its solution, the linearization, the regularization state, e.g. of `convexify`,
+        and the globalization and Levenberg-Marquardt state.
+
+        :param filename: if not set, use name + '_snapshot.bin'
+        """
+        if filename == '':
+            filename = f'{self.name}_snapshot.bin'
+
+        status = self.__acados_lib.ocp_nlp_solver_snapshot_save(self.nlp_solver, self.nlp_out, filename.encode('utf-8'))
+        if status != 0:
+            raise RuntimeError(f"save_snapshot: failed to write {filename}.")
+
+    def load_snapshot(self, filename: str = ''):
+        """
+        Restores the warm solver state saved with `save_snapshot()`.
+        For SQP_RTI, a snapshot taken after a preparation phase can be followed directly by a feedback phase.
+
+        :param filename: if not set, use name + '_snapshot.bin'
+        """
+        if filename == '':
+            filename = f'{self.name}_snapshot.bin'
+
+        status = self.__acados_lib.ocp_nlp_solver_snapshot_load(self.nlp_solver, self.nlp_out, filename.encode('utf-8'))
+        if status != 0:
+            raise RuntimeError(f"load_snapshot: failed to restore {filename}, it does not match this solver.")
+
+    def get_memory_footprint(self) -> dict:
+        """
+        Returns the number of bytes required by the solver and its submodules as a dict.
+
+        The entry 'total' is the size of the single solver allocation.
+        Submodule entries include their workspace requirement before any sharing, so they do not sum up to 'total'.
+        The stage-wise modules 'dynamics', 'cost' and 'constraints' are returned as lists over the stages.
+        """
+        footprint = dict()
+        for module in ['total', 'solver_memory', 'solver_workspace', 'memory', 'workspace',
+                       'qp_solver', 'regularize', 'globalization', 'qpscaling', 'iterates']:
+            footprint[module] = self.__acados_lib.ocp_nlp_solver_memory_footprint(self.nlp_solver, self.nlp_in, module.encode('utf-8'), 0)
+
+        for module, n_stages in [('dynamics', self.N), ('cost', self.N+1), ('constraints', self.N+1)]:
+            footprint[module] = [self.__acados_lib.ocp_nlp_solver_memory_footprint(self.nlp_solver, self.nlp_in, module.encode('utf-8'), i)
+                                 for i in range(n_stages)]
+        return footprint
+
     def get_last_qp(self) -> dict:
         """
         Returns the latest QP data as a dict
@@ -1721,12 +1816,17 @@ class AcadosOcpSolver:
             - qp_stat: vector of QP solver status for last NLP solver call
             - qp_iter: vector of QP iterations for last NLP solver call
             - qpscaling_status: status of last call to qpscaling module
+            - qp_num_refactorizations: number of KKT factorizations of OSQP, accumulated over all solver calls, only available for OSQP
+            - qp_num_resolves: number of QPs solved again by the solver option nlp_qp_tol_safeguard in the last solver call
             - qp_residuals: residuals of last QP solve [res_stat, res_eq, res_ineq, res_comp], only available if nlp_solver_ext_qp_res is enabled and nlp_solver_type is SQP
             - statistics: table with info about last iteration
             - stat_m: number of rows in statistics matrix
             - stat_n: number of columns in statistics matrix
             - residuals: residuals of current iterate
             - alpha: step sizes of SQP iterations
+            - latency_time_tot, latency_time_feedback, latency_time_preparation, latency_time_qp_solver_call: statistics of the respective computation time accumulated over all solver calls,
+              [count, mean, p50, p99, p99.9, max, number of deadline misses], requires solver option log_latency,
+              deadline misses are only counted for latency_time_tot and latency_time_feedback, see `reset_latency_stats()`
         """
 
         if field_ == "time_solution_sens_lin":
@@ -1750,7 +1850,7 @@ class AcadosOcpSolver:
                   'time_feedback',
                   'qp_tau_iter',
         ]
-        int_fields = ['ddp_iter', 'sqp_iter', 'nlp_iter', 'stat_m', 'stat_n', 'qpscaling_status']
+        int_fields = ['ddp_iter', 'sqp_iter', 'nlp_iter', 'stat_m', 'stat_n', 'qpscaling_status', 'qp_num_refactorizations', 'qp_num_resolves']
         fields = double_fields + int_fields + [
                   'qp_stat',
                   'qp_iter',
@@ -1759,10 +1859,17 @@ class AcadosOcpSolver:
                   'alpha',
                   'res_eq_all',
                   'res_stat_all',
+                  'latency_time_tot',
+                  'latency_time_feedback',
+                  'latency_time_preparation',
+                  'latency_time_qp_solver_call',
                 ]
 
         field = field_.encode('utf-8')
 
+        if field_ == 'qp_num_refactorizations' and 'OSQP' not in self.ocp.solver_options.qp_solver:
+            raise ValueError('qp_num_refactorizations is only available for OSQP.')
+
         if field_ in int_fields:
             out = c_int(0)
             self.__acados_lib.ocp_nlp_get(self.nlp_solver, field, byref(out))
@@ -1783,6 +1890,14 @@ class AcadosOcpSolver:
             self.__acados_lib.ocp_nlp_get(self.nlp_solver, field, out_data)
             return out
 
+        elif field_ in ['latency_time_tot', 'latency_time_feedback', 'latency_time_preparation', 'latency_time_qp_solver_call']:
+            if not self.ocp.solver_options.log_latency:
+                raise ValueError(f"get_stats: {field_} requires the solver option log_latency to be True.")
+            out = np.zeros((7,), dtype=np.float64, order="C")
+            out_data = cast(out.ctypes.data, POINTER(c_double))
+            self.__acados_lib.ocp_nlp_get(self.nlp_solver, field, out_data)
+            return out
+
         elif field_ in ['primal_step_norm', 'dual_step_norm']:
             nlp_iter = self.get_stats("nlp_iter")
             out = np.zeros((nlp_iter,), dtype=np.float64, order="C")
@@ -1820,7 +1935,7 @@ class AcadosOcpSolver:
 
         elif field_ == 'alpha':
             full_stats = self.get_stats('statistics')
-            if self.ocp.solver_options.nlp_solver_type == 'SQP':
+            if self.ocp.solver_options.nlp_solver_type in ['SQP', 'DDP']:
                 return full_stats[7, :]
             else: # self.ocp.solver_options.nlp_solver_type == 'SQP_RTI':
                 raise ValueError("alpha values are not available for SQP_RTI")
@@ -2464,6 +2579,7 @@ class AcadosOcpSolver:
                 'qp_warm_start', 'qp_mu0', 'qp_print_level', 'warm_start_first_qp',
                 'globalization_fixed_step_length', 'globalization_alpha_min', 'globalization_alpha_reduction',
                 'globalization_line_search_use_sufficient_descent', 'globalization_full_step_dual', 'globalization_use_SOC',
+                'globalization_nonmonotone_window',
                 'globalization_funnel_init_upper_bound', 'globalization_funnel_sufficient_decrease_factor',
                 'globalization_funnel_kappa', 'globalization_funnel_fraction_switching_condition',
                 'globalization_funnel_initial_penalty_parameter', 'globalization_funnel_init_increase_factor',
@@ -2488,6 +2604,7 @@ class AcadosOcpSolver:
                       'globalization_line_search_use_sufficient_descent',
                       'globalization_full_step_dual',
                       'globalization_use_SOC',
+                      'globalization_nonmonotone_window',
                       'warm_start_first_qp',
                       'as_rti_level',
                       'max_iter',
@@ -2521,6 +2521,9 @@ static void {{ model.name }}_acados_create_set_opts({{ model.name }}_solver_caps
     int globalization_line_search_use_sufficient_descent = {{ solver_options.globalization_line_search_use_sufficient_descent }};
     ocp_nlp_solver_opts_set(nlp_config, capsule->nlp_opts, "globalization_line_search_use_sufficient_descent", &globalization_line_search_use_sufficient_descent);
 
+    int globalization_nonmonotone_window = {{ solver_options.globalization_nonmonotone_window }};
+    ocp_nlp_solver_opts_set(nlp_config, capsule->nlp_opts, "globalization_nonmonotone_window", &globalization_nonmonotone_window);
+
     int globalization_use_SOC = {{ solver_options.globalization_use_SOC }};
     ocp_nlp_solver_opts_set(nlp_config, capsule->nlp_opts, "globalization_use_SOC", &globalization_use_SOC);
 
@@ -2545,6 +2548,16 @@ static void {{ model.name }}_acados_create_set_opts({{ model.name }}_solver_caps
 
     bool globalization_funnel_use_merit_fun_only = {{ solver_options.globalization_funnel_use_merit_fun_only }};
     ocp_nlp_solver_opts_set(nlp_config, nlp_opts, "globalization_funnel_use_merit_fun_only", &globalization_funnel_use_merit_fun_only);
+{%- elif solver_options.globalization == "TRUST_REGION" %}
+
+    double globalization_trust_region_radius_init = {{ solver_options.globalization_trust_region_radius_init }};
+    ocp_nlp_solver_opts_set(nlp_config, nlp_opts, "globalization_trust_region_radius_init", &globalization_trust_region_radius_init);
+
+    double globalization_trust_region_radius_max = {{ solver_options.globalization_trust_region_radius_max }};
+    ocp_nlp_solver_opts_set(nlp_config, nlp_opts, "globalization_trust_region_radius_max", &globalization_trust_region_radius_max);
+
+    double globalization_trust_region_eta = {{ solver_options.globalization_trust_region_eta }};
+    ocp_nlp_solver_opts_set(nlp_config, nlp_opts, "globalization_trust_region_eta", &globalization_trust_region_eta);
 {%- endif %}
 
     int with_solution_sens_wrt_params_forw = {{ code_gen_options.with_solution_sens_wrt_params_forw }};
@@ -2725,7 +2738,7 @@ static void {{ model.name }}_acados_create_set_opts({{ model.name }}_solver_caps
     {%- endif %}
 {%- endif %}
 
-{%- if solver_options.regularize_method == "PROJECT" or solver_options.regularize_method == "MIRROR" or solver_options.regularize_method == "CONVEXIFY" or solver_options.regularize_method == "GERSHGORIN_LEVENBERG_MARQUARDT"%}
+{%- if solver_options.regularize_method == "PROJECT" or solver_options.regularize_method == "MIRROR" or solver_options.regularize_method == "CONVEXIFY" or solver_options.regularize_method == "GERSHGORIN_LEVENBERG_MARQUARDT" or solver_options.regularize_method == "INERTIA_CORRECTION" %}
     double reg_epsilon = {{ solver_options.reg_epsilon }};
     ocp_nlp_solver_opts_set(nlp_config, nlp_opts, "reg_epsilon", &reg_epsilon);
 {%- endif %}
@@ -2747,6 +2760,21 @@ static void {{ model.name }}_acados_create_set_opts({{ model.name }}_solver_caps
     bool store_iterates = {{ solver_options.store_iterates }};
     ocp_nlp_solver_opts_set(nlp_config, nlp_opts, "store_iterates", &store_iterates);
 
+    int profiler_buffer_size = {{ solver_options.profiler_buffer_size }};
+    ocp_nlp_solver_opts_set(nlp_config, nlp_opts, "profiler_buffer_size", &profiler_buffer_size);
+
+    bool alloc_hugepages = {{ solver_options.alloc_hugepages }};
+    ocp_nlp_solver_opts_set(nlp_config, nlp_opts, "alloc_hugepages", &alloc_hugepages);
+
+    bool minimal_memory = {{ solver_options.minimal_memory }};
+    ocp_nlp_solver_opts_set(nlp_config, nlp_opts, "minimal_memory", &minimal_memory);
+
+    int log_latency = {{ solver_options.log_latency }};
+    ocp_nlp_solver_opts_set(nlp_config, nlp_opts, "log_latency", &log_latency);
+
+    double latency_deadline = {{ solver_options.latency_deadline }};
+    ocp_nlp_solver_opts_set(nlp_config, nlp_opts, "latency_deadline", &latency_deadline);
+
 {%- if solver_options.nlp_solver_type == "SQP" or solver_options.nlp_solver_type == "SQP_WITH_FEASIBLE_QP" %}
     int log_primal_step_norm = {{ solver_options.log_primal_step_norm }};
     ocp_nlp_solver_opts_set(nlp_config, nlp_opts, "log_primal_step_norm", &log_primal_step_norm);
@@ -2771,6 +2799,11 @@ static void {{ model.name }}_acados_create_set_opts({{ model.name }}_solver_caps
     ocp_nlp_solver_opts_set(nlp_config, nlp_opts, "qp_t0_init", &qp_solver_t0_init);
 {%- endif %}
 
+{%- if solver_options.qp_solver is containing("OSQP") %}
+    bool osqp_reuse_factorization = {{ solver_options.osqp_reuse_factorization }};
+    ocp_nlp_solver_opts_set(nlp_config, nlp_opts, "qp_reuse_factorization", &osqp_reuse_factorization);
+{%- endif %}
+
 {% if solver_options.tau_min > 0 %}
     double tau_min = {{ solver_options.tau_min }};
     ocp_nlp_solver_opts_set(nlp_config, nlp_opts, "tau_min", &tau_min);
@@ -2783,6 +2816,9 @@ static void {{ model.name }}_acados_create_set_opts({{ model.name }}_solver_caps
     bool use_constraint_hessian_in_feas_qp = {{ solver_options.use_constraint_hessian_in_feas_qp }};
     ocp_nlp_solver_opts_set(nlp_config, nlp_opts, "use_constraint_hessian_in_feas_qp", &use_constraint_hessian_in_feas_qp);
 
+    bool warm_start_nominal_qp_from_feasibility_qp = {{ solver_options.warm_start_nominal_qp_from_feasibility_qp }};
+    ocp_nlp_solver_opts_set(nlp_config, nlp_opts, "warm_start_nominal_qp_from_feasibility_qp", &warm_start_nominal_qp_from_feasibility_qp);
+
     int search_direction_mode = {{ solver_options.search_direction_mode }};
     ocp_nlp_solver_opts_set(nlp_config, nlp_opts, "search_direction_mode", &search_direction_mode);
 
@@ -2861,6 +2897,16 @@ static void {{ model.name }}_acados_create_set_opts({{ model.name }}_solver_caps
     double nlp_qp_tol_min_comp = {{ solver_options.nlp_qp_tol_min_comp }};
     ocp_nlp_solver_opts_set(nlp_config, nlp_opts, "nlp_qp_tol_min_comp", &nlp_qp_tol_min_comp);
 
+    bool nlp_qp_tol_safeguard = {{ solver_options.nlp_qp_tol_safeguard }};
+    ocp_nlp_solver_opts_set(nlp_config, nlp_opts, "nlp_qp_tol_safeguard", &nlp_qp_tol_safeguard);
+
+{%- if solver_options.nlp_solver_type == "DDP" %}
+    int ddp_num_segments = {{ solver_options.ddp_num_segments }};
+    ocp_nlp_solver_opts_set(nlp_config, nlp_opts, "ddp_num_segments", &ddp_num_segments);
+
+    int ddp_defect_closing = DDP_DEFECT_CLOSING_{{ solver_options.ddp_defect_closing }};
+    ocp_nlp_solver_opts_set(nlp_config, nlp_opts, "ddp_defect_closing", &ddp_defect_closing);
+{%- endif %}
 {%- if solver_options.nlp_solver_type == "SQP" and solver_options.timeout_max_time > 0 %}
     double timeout_max_time = {{ solver_options.timeout_max_time }};
     ocp_nlp_solver_opts_set(nlp_config, nlp_opts, "timeout_max_time", &timeout_max_time);
@@ -2889,6 +2935,9 @@ static void {{ model.name }}_acados_create_set_opts({{ model.name }}_solver_caps
     double anderson_activation_threshold = {{ solver_options.anderson_activation_threshold }};
     ocp_nlp_solver_opts_set(nlp_config, nlp_opts, "anderson_activation_threshold", &anderson_activation_threshold);
 
+    int anderson_depth = {{ solver_options.anderson_depth }};
+    ocp_nlp_solver_opts_set(nlp_config, nlp_opts, "anderson_depth", &anderson_depth);
+
     int qp_solver_iter_max = {{ solver_options.qp_solver_iter_max }};
     ocp_nlp_solver_opts_set(nlp_config, nlp_opts, "qp_iter_max", &qp_solver_iter_max);
 
@@ -3313,6 +3362,30 @@ void {{ model.name }}_acados_batch_eval_solution_sens_adj_p({{ model.name }}_sol
 }
 
 
+void {{ model.name }}_acados_batch_eval_solution_sens_adj_p_block({{ model.name }}_solver_capsule ** capsules, const char *field, int n_seeds, double *seed, int ld_seed, double *out, int ld_out, int N_batch, int num_threads_in_batch_solve)
+{
+    int num_threads_bkp;
+    if (num_threads_in_batch_solve > 1)
+    {
+        num_threads_bkp = omp_get_num_threads();
+        omp_set_num_threads(num_threads_in_batch_solve);
+    }
+
+    #pragma omp parallel for
+    for (int i = 0; i < N_batch; i++)
+    {
+        ocp_nlp_eval_solution_sens_adj_p_block(capsules[i]->nlp_solver, capsules[i]->nlp_in, field, n_seeds,
+                                               seed + i*n_seeds*ld_seed, ld_seed, out + i*n_seeds*ld_out, ld_out);
+    }
+
+    if (num_threads_in_batch_solve > 1)
+    {
+        omp_set_num_threads( num_threads_bkp );
+    }
+    return;
+}
+
+
 void {{ model.name }}_acados_batch_set_flat({{ model.name }}_solver_capsule ** capsules, const char *field, double *data, int N_data, int N_batch, int num_threads_in_batch_solve)
 {
     int offset = ocp_nlp_dims_get_total_from_attr(capsules[0]->nlp_solver->config, capsules[0]->nlp_solver->dims, capsules[0]->nlp_out, field);
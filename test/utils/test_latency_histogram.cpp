@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) The acados authors.
+ *
+ * This file is part of acados.
+ *
+ * The 2-Clause BSD License
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.;
+ */
+
+#include <math.h>
+
+#include "catch/include/catch.hpp"
+
+#include "acados/utils/latency_histogram.h"
+
+// values in the middle of a bucket, i.e. 1.5 * 2^e ns, fall into bucket e * SUB_BUCKETS + SUB_BUCKETS/2
+static int mid_bucket(int exponent)
+{
+    return exponent * ACADOS_LATENCY_HIST_SUB_BUCKETS + ACADOS_LATENCY_HIST_SUB_BUCKETS / 2;
+}
+
+// midpoint of that bucket in seconds
+static double mid_bucket_value(int exponent)
+{
+    return (1.0 + (ACADOS_LATENCY_HIST_SUB_BUCKETS / 2 + 0.5) / ACADOS_LATENCY_HIST_SUB_BUCKETS) * (1 << exponent) * 1e-9;
+}
+
+
+
+TEST_CASE("latency histogram", "[utils]")
+{
+    acados_latency_histogram hist;
+    acados_latency_histogram_reset(&hist);
+
+    const double deadline = 5e-6;
+    const double t_fast = 1536e-9;   // 1.5 * 2^10 ns
+    const double t_slow = 6144e-9;   // 1.5 * 2^12 ns
+    const double t_max = 100e-6;     // 1.53 * 2^16 ns, below the midpoint of its bucket
+
+    for (int i = 0; i < 90; i++)
+        acados_latency_histogram_record(&hist, t_fast, deadline);
+    for (int i = 0; i < 9; i++)
+        acados_latency_histogram_record(&hist, t_slow, deadline);
+    acados_latency_histogram_record(&hist, t_max, deadline);
+
+    SECTION("bucket counts")
+    {
+        long total = 0;
+        for (int i = 0; i < ACADOS_LATENCY_HIST_NUM_BUCKETS; i++)
+            total += hist.counts[i];
+        REQUIRE(total == 100);
+        REQUIRE(hist.count == 100);
+        REQUIRE(hist.counts[mid_bucket(10)] == 90);
+        REQUIRE(hist.counts[mid_bucket(12)] == 9);
+        REQUIRE(hist.counts[mid_bucket(16)] == 1);
+    }
+
+    SECTION("quantiles")
+    {
+        REQUIRE(acados_latency_histogram_quantile(&hist, 0.0) == Approx(mid_bucket_value(10)));
+        REQUIRE(acados_latency_histogram_quantile(&hist, 0.5) == Approx(mid_bucket_value(10)));
+        REQUIRE(acados_latency_histogram_quantile(&hist, 0.9) == Approx(mid_bucket_value(10)));
+        REQUIRE(acados_latency_histogram_quantile(&hist, 0.91) == Approx(mid_bucket_value(12)));
+        REQUIRE(acados_latency_histogram_quantile(&hist, 0.99) == Approx(mid_bucket_value(12)));
+        // the bucket midpoint is above the largest recorded value, the quantile is clamped to max
+        REQUIRE(mid_bucket_value(16) > t_max);
+        REQUIRE(acados_latency_histogram_quantile(&hist, 1.0) == t_max);
+        // relative error of a quantile below 1/(2*SUB_BUCKETS)
+        REQUIRE(fabs(acados_latency_histogram_quantile(&hist, 0.5) - t_fast) / t_fast < 0.5 / ACADOS_LATENCY_HIST_SUB_BUCKETS);
+    }
+
+    SECTION("deadline misses and summary")
+    {
+        double summary[7];
+        acados_latency_histogram_summary(&hist, summary);
+        REQUIRE(summary[0] == 100);
+        REQUIRE(summary[1] == Approx((90 * t_fast + 9 * t_slow + t_max) / 100));
+        REQUIRE(summary[2] == Approx(mid_bucket_value(10)));
+        REQUIRE(summary[3] == Approx(mid_bucket_value(12)));
+        REQUIRE(summary[4] == t_max);
+        REQUIRE(summary[5] == t_max);
+        REQUIRE(summary[6] == 10);
+
+        // no deadline
+        acados_latency_histogram_record(&hist, t_max, 0.0);
+        REQUIRE(hist.num_deadline_misses == 10);
+    }
+
+    SECTION("out of range values")
+    {
+        acados_latency_histogram_record(&hist, 0.0, 0.0);
+        REQUIRE(hist.counts[0] == 1);
+        acados_latency_histogram_record(&hist, 1e6, 0.0);
+        REQUIRE(hist.counts[ACADOS_LATENCY_HIST_NUM_BUCKETS - 1] == 1);
+        REQUIRE(acados_latency_histogram_quantile(&hist, 1.0) == 1e6);
+    }
+
+    SECTION("reset")
+    {
+        acados_latency_histogram_reset(&hist);
+        REQUIRE(hist.count == 0);
+        REQUIRE(hist.num_deadline_misses == 0);
+        REQUIRE(hist.counts[mid_bucket(10)] == 0);
+        REQUIRE(acados_latency_histogram_quantile(&hist, 0.5) == 0.0);
+    }
+}